@@ -1,165 +1,401 @@
-// FileLoader.cpp, esto es para cargar los niveles desde los .txt
+// FileLoader.cpp, esto es para cargar los niveles desde los .txt / .json (y los .etgl compilados)
 #include "FileLoader.h"
+#include "JsonReader.h"
+#include "LevelBinary.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cstring>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <new>
 
-bool FileLoader::LoadLevel(const std::string& filename, LevelData& levelData) {
-    // Solo aguantan .txt por ahora
-    if (filename.find(".txt") != std::string::npos) {
-        return LoadFromTXT(filename, levelData);
+bool FileLoader::LoadLevel(const std::string& filename, LevelData& levelData, const std::atomic<bool>* cancel) {
+    // El formato se elige por extensión
+    if (HasExtension(filename, ".etgl")) {
+        return LoadFromETGL(filename, levelData);
+    }
+    if (HasExtension(filename, ".txt")) {
+        return LoadFromTXT(filename, levelData, cancel);
+    }
+    if (HasExtension(filename, ".json")) {
+        return LoadFromJSON(filename, levelData, cancel);
     }
     
-    std::cout << "Solo se soportan archivos .txt en esta versión." << std::endl;
+    std::cout << "Formato no soportado (use .txt, .json o .etgl): " << filename << std::endl;
     return false;
 }
 
-bool FileLoader::LoadFromTXT(const std::string& filename, LevelData& levelData) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cout << "No se pudo abrir el archivo: " << filename << std::endl;
+bool FileLoader::HasExtension(const std::string& filename, const char* extension) {
+    size_t length = std::strlen(extension);
+    return filename.size() >= length && filename.compare(filename.size() - length, length, extension) == 0;
+}
+
+bool FileLoader::LoadFromETGL(const std::string& filename, LevelData& levelData) {
+    // Sin checksum: se validan encabezado y directivas, se decodifican las celdas y la adyacencia y las distancias
+    // quedan en el mapeo hasta que un solver las lea. El checksum completo lo revisa 'etgl_convert --verify'.
+    LevelBinary binary;
+    if (!binary.Open(filename, false)) {
         return false;
     }
     
-    std::string line;
-    
-    try {
-        // dimensiones del nivel
-        if (!std::getline(file, line)) {
-            std::cout << "Error leyendo dimensiones" << std::endl;
-            return false;
+    binary.DecodeTo(levelData);
+    std::cout << "Nivel compilado cargado: " << filename << " (" << levelData.width << "x" << levelData.height
+              << (levelData.goalDistance ? ", con campo de distancias" : "") << ")" << std::endl;
+    return true;
+}
+
+// Entrega el nivel línea por línea como vistas (string_view). Desde archivo lee en bloques de
+// tamaño fijo, así la memoria extra durante la carga es un bloque más la línea más larga.
+// Con cancel, cada FileLoader::CANCEL_CHECK_BYTES leídos lo mira y si está puesto deja de dar líneas (cancelled).
+class LevelLineReader {
+public:
+    static const size_t CHUNK_SIZE = 64 * 1024;
+    int line = 0;
+    bool cancelled = false;
+
+    LevelLineReader(std::string_view text, const std::atomic<bool>* cancel)
+        : stream(nullptr), text(text), pos(0), cancel(cancel) {}
+    LevelLineReader(std::istream& input, const std::atomic<bool>* cancel) : stream(&input), pos(0), cancel(cancel) {}
+
+    bool NextLine(std::string_view& out) {
+        if (cancel != nullptr && bytesRead >= nextCancelCheck) {
+            nextCancelCheck = bytesRead + FileLoader::CANCEL_CHECK_BYTES;
+            if (cancel->load(std::memory_order_relaxed)) {
+                cancelled = true;
+                return false;
+            }
         }
-        std::istringstream dimStream(line);
-        if (!(dimStream >> levelData.width >> levelData.height)) {
-            std::cout << "Error parseando dimensiones: " << line << std::endl;
-            return false;
+        
+        size_t end = std::string_view::npos;
+        while (true) {
+            end = text.find('\n', pos);
+            if (end != std::string_view::npos || !Refill()) break;
         }
         
-        // posición inicial
-        if (!std::getline(file, line)) {
-            std::cout << "Error leyendo posición inicial" << std::endl;
+        if (pos >= text.size()) {
             return false;
         }
-        std::istringstream startStream(line);
-        if (!(startStream >> levelData.startX >> levelData.startY)) {
-            std::cout << "Error parseando posición inicial: " << line << std::endl;
-            return false;
+        if (end == std::string_view::npos) {
+            end = text.size();
         }
         
-        // posición objetivo
-        if (!std::getline(file, line)) {
-            std::cout << "Error leyendo posición objetivo" << std::endl;
-            return false;
+        out = text.substr(pos, end - pos);
+        if (!out.empty() && out.back() == '\r') {
+            out.remove_suffix(1);
         }
-        std::istringstream goalStream(line);
-        if (!(goalStream >> levelData.goalX >> levelData.goalY)) {
-            std::cout << "Error parseando posición objetivo: " << line << std::endl;
+        bytesRead += end + 1 - pos;
+        pos = end + 1;
+        line++;
+        return true;
+    }
+
+private:
+    std::istream* stream;
+    std::string buffer;
+    std::string_view text;
+    size_t pos;
+    const std::atomic<bool>* cancel;
+    size_t bytesRead = 0;
+    size_t nextCancelCheck = 0;
+
+    // Descarta lo ya consumido y agrega el siguiente bloque del archivo
+    bool Refill() {
+        if (stream == nullptr || !*stream) {
             return false;
         }
         
-        // ciclo de turnos
-        if (!std::getline(file, line)) {
-            std::cout << "Error leyendo ciclo de turnos" << std::endl;
-            return false;
-        }
-        levelData.turnCycleLength = std::stoi(line);
+        size_t consumed = pos < buffer.size() ? pos : buffer.size();
+        buffer.erase(0, consumed);
+        pos = 0;
+        
+        size_t kept = buffer.size();
+        buffer.resize(kept + CHUNK_SIZE);
+        stream->read(&buffer[kept], CHUNK_SIZE);
+        buffer.resize(kept + (size_t)stream->gcount());
+        text = buffer;
         
-        // Inicializar grid
-        levelData.cellTypes.resize(levelData.height);
-        for (int y = 0; y < levelData.height; y++) {
-            levelData.cellTypes[y].resize(levelData.width, '.');
+        return stream->gcount() > 0;
+    }
+};
+
+namespace {
+
+bool IsBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+void SkipBlanks(std::string_view text, size_t& offset) {
+    while (offset < text.size() && IsBlank(text[offset])) {
+        offset++;
+    }
+}
+
+// Entero con from_chars a partir de offset (saltando espacios), avanza offset al terminar
+bool ReadInt(std::string_view text, size_t& offset, int& out) {
+    SkipBlanks(text, offset);
+    const char* begin = text.data() + offset;
+    const char* end = text.data() + text.size();
+    auto result = std::from_chars(begin, end, out);
+    if (result.ec != std::errc()) {
+        return false;
+    }
+    offset = result.ptr - text.data();
+    return true;
+}
+
+// Siguiente palabra separada por espacios
+std::string_view ReadToken(std::string_view text, size_t& offset) {
+    SkipBlanks(text, offset);
+    size_t begin = offset;
+    while (offset < text.size() && !IsBlank(text[offset])) {
+        offset++;
+    }
+    return text.substr(begin, offset - begin);
+}
+
+bool Expect(std::string_view text, size_t& offset, char c) {
+    if (offset < text.size() && text[offset] == c) {
+        offset++;
+        return true;
+    }
+    return false;
+}
+
+bool ReportError(const std::string& source, int line, size_t column, const std::string& message) {
+    std::cout << source << ":" << line << ":" << column << ": error: " << message << std::endl;
+    return false;
+}
+
+// Errores que no apuntan a una posición concreta (validaciones al final del documento)
+bool ReportError(const std::string& source, const std::string& message) {
+    std::cout << source << ": error: " << message << std::endl;
+    return false;
+}
+
+template <typename T>
+bool ComesBefore(const T& a, const T& b) {
+    return a.y != b.y ? a.y < b.y : a.x < b.x;
+}
+
+// Ordena por (y, x) y deja solo la última entrada de cada celda
+template <typename T>
+void SortAndDeduplicate(std::vector<T>& entries) {
+    std::stable_sort(entries.begin(), entries.end(), ComesBefore<T>);
+    
+    size_t write = 0;
+    for (size_t read = 0; read < entries.size(); read++) {
+        bool lastOfCell = read + 1 == entries.size() ||
+                          entries[read + 1].x != entries[read].x || entries[read + 1].y != entries[read].y;
+        if (lastOfCell) {
+            if (write != read) entries[write] = std::move(entries[read]);
+            write++;
+        }
+    }
+    entries.resize(write);
+}
+
+template <typename T>
+const T* FindSorted(const std::vector<T>& entries, int x, int y) {
+    T key{};
+    key.x = x;
+    key.y = y;
+    auto it = std::lower_bound(entries.begin(), entries.end(), key, ComesBefore<T>);
+    if (it != entries.end() && it->x == x && it->y == y) {
+        return &*it;
+    }
+    return nullptr;
+}
+
+} // namespace
+
+const GateAssignment* LevelData::FindGate(int x, int y) const {
+    return FindSorted(gateAssignments, x, y);
+}
+
+const TemporalWall* LevelData::FindTemporalWall(int x, int y) const {
+    return FindSorted(temporalWalls, x, y);
+}
+
+void LevelData::SortDirectives() {
+    SortAndDeduplicate(gateAssignments);
+    SortAndDeduplicate(temporalWalls);
+}
+
+bool FileLoader::LoadFromTXT(const std::string& filename, LevelData& levelData, const std::atomic<bool>* cancel) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "No se pudo abrir el archivo: " << filename << std::endl;
+        return false;
+    }
+    
+    // Carga en streaming: cada fila se escribe en el mapa final apenas se lee
+    LevelLineReader reader(file, cancel);
+    if (!ParseTXT(filename, reader, levelData)) {
+        return false;
+    }
+    
+    std::cout << "Nivel cargado exitosamente: " << filename << std::endl;
+    std::cout << "Dimensiones: " << levelData.width << "x" << levelData.height << std::endl;
+    std::cout << "Inicio: (" << levelData.startX << ", " << levelData.startY << ")" << std::endl;
+    std::cout << "Meta: (" << levelData.goalX << ", " << levelData.goalY << ")" << std::endl;
+    
+    return true;
+}
+
+bool FileLoader::LoadFromTXTBuffer(const std::string& sourceName, std::string_view text, LevelData& levelData,
+                                   const std::atomic<bool>* cancel) {
+    LevelLineReader reader(text, cancel);
+    return ParseTXT(sourceName, reader, levelData);
+}
+
+bool FileLoader::ParseTXT(const std::string& sourceName, LevelLineReader& reader, LevelData& levelData) {
+    std::string_view line;
+    size_t offset = 0;
+    
+    levelData.cells.clear();
+    levelData.items.clear();
+    levelData.gatePatterns.clear();
+    levelData.gateAssignments.clear();
+    levelData.temporalWalls.clear();
+    
+    // Si se acabaron las líneas porque cancelaron la carga no hay nada que reportar
+    auto missing = [&](const std::string& message) {
+        return reader.cancelled ? false : ReportError(sourceName, reader.line + 1, 1, message);
+    };
+    
+    // dimensiones del nivel
+    if (!reader.NextLine(line)) {
+        return missing("falta la línea de dimensiones");
+    }
+    offset = 0;
+    if (!ReadInt(line, offset, levelData.width) || !ReadInt(line, offset, levelData.height)) {
+        return ReportError(sourceName, reader.line, offset + 1, "se esperaba 'ancho alto'");
+    }
+    if (!ValidDimensions(levelData.width, levelData.height)) {
+        return ReportError(sourceName, reader.line, 1, "dimensiones inválidas (máximo " + std::to_string(MAX_CELLS) + " celdas)");
+    }
+    
+    // posición inicial
+    if (!reader.NextLine(line)) {
+        return missing("falta la posición inicial");
+    }
+    offset = 0;
+    if (!ReadInt(line, offset, levelData.startX) || !ReadInt(line, offset, levelData.startY)) {
+        return ReportError(sourceName, reader.line, offset + 1, "se esperaba 'x y' de inicio");
+    }
+    
+    // posición objetivo
+    if (!reader.NextLine(line)) {
+        return missing("falta la posición objetivo");
+    }
+    offset = 0;
+    if (!ReadInt(line, offset, levelData.goalX) || !ReadInt(line, offset, levelData.goalY)) {
+        return ReportError(sourceName, reader.line, offset + 1, "se esperaba 'x y' de la meta");
+    }
+    
+    // ciclo de turnos
+    if (!reader.NextLine(line)) {
+        return missing("falta el ciclo de turnos");
+    }
+    offset = 0;
+    if (!ReadInt(line, offset, levelData.turnCycleLength) || levelData.turnCycleLength <= 0) {
+        return ReportError(sourceName, reader.line, offset + 1, "ciclo de turnos inválido");
+    }
+    
+    // Leer el mapa directo al almacenamiento plano final (una sola reserva)
+    try {
+        levelData.cells.assign((size_t)levelData.width * levelData.height, '.');
+    } catch (const std::bad_alloc&) {
+        return ReportError(sourceName, "sin memoria para un mapa de " + std::to_string(levelData.width) + "x" +
+                                       std::to_string(levelData.height));
+    }
+    for (int y = 0; y < levelData.height; y++) {
+        if (!reader.NextLine(line)) {
+            return missing("falta la fila " + std::to_string(y) + " del mapa");
         }
         
-        // Leer el mapa
-        for (int y = 0; y < levelData.height; y++) {
-            if (!std::getline(file, line)) {
-                std::cout << "Error leyendo fila " << y << " del mapa" << std::endl;
-                return false;
-            }
+        char* row = &levelData.cells[(size_t)y * levelData.width];
+        int x = 0;
+        for (size_t i = 0; i < line.size() && x < levelData.width; i++) {
+            char c = line[i];
+            if (c == ' ') continue;
             
-            int x = 0;
-            for (char c : line) {
-                if (c != ' ' && x < levelData.width) {
-                    levelData.cellTypes[y][x] = ParseCellChar(c);
-                    
-                    // celdas especiales
-                    if (c == 'K') {
-                        levelData.items.push_back({x, y});
-                        levelData.cellTypes[y][x] = '.'; 
-                    }
-                    
-                    x++;
-                }
+            if (c == 'K') {
+                levelData.items.push_back({x, y});
+                row[x] = '.';
+            } else {
+                row[x] = ParseCellChar(c);
             }
+            x++;
         }
+    }
+    
+    // Leer configuraciones especiales
+    int gateCount = 0;
+    while (reader.NextLine(line)) {
+        offset = 0;
+        SkipBlanks(line, offset);
+        if (offset >= line.size()) continue;
+        std::string_view directive = line.substr(offset);
         
-        // Leer configuraciones especiales
-        while (std::getline(file, line)) {
-            if (line.empty()) continue;
+        if (directive.compare(0, 5, "GATE_") == 0) {
+            // Formato: GATE_A 11001100
+            size_t tokenStart = offset;
+            std::string_view gateName = ReadToken(line, offset).substr(5);
+            std::string_view patternStr = ReadToken(line, offset);
+            if (gateName.empty() || patternStr.empty()) {
+                return ReportError(sourceName, reader.line, tokenStart + 1, "se esperaba 'GATE_nombre patrón'");
+            }
             
-            if (line.find("GATE_") == 0) {
-                // Formato: GATE_A 11001100
-                std::istringstream gateStream(line);
-                std::string gateName, patternStr;
-                if (gateStream >> gateName >> patternStr) {
-                    std::vector<bool> pattern;
-                    for (char c : patternStr) {
-                        pattern.push_back(c == '1');
-                    }
-                    levelData.gatePatterns[gateName.substr(5)] = pattern; // Quitar "GATE_"
-                    std::cout << "Patrón de compuerta cargado: " << gateName.substr(5) << std::endl;
-                }
-            } else if (line.find("ASSIGN_") == 0) {
-                // Formato: ASSIGN_3_4_A
-                std::istringstream assignStream(line);
-                std::string assignCmd;
-                if (assignStream >> assignCmd) {
-                    // Parsear ASSIGN_x_y_pattern
-                    size_t pos1 = assignCmd.find('_', 7);
-                    size_t pos2 = assignCmd.find('_', pos1 + 1);
-                    
-                    if (pos1 != std::string::npos && pos2 != std::string::npos) {
-                        int x = std::stoi(assignCmd.substr(7, pos1 - 7));
-                        int y = std::stoi(assignCmd.substr(pos1 + 1, pos2 - pos1 - 1));
-                        std::string pattern = assignCmd.substr(pos2 + 1);
-                        
-                        levelData.gateAssignments[{x, y}] = pattern;
-                        levelData.cellTypes[y][x] = 'G'; // Marcar como compuerta
-                        std::cout << "Compuerta asignada en (" << x << ", " << y << ") patrón: " << pattern << std::endl;
-                    }
-                }
-            } else if (line.find("TEMPORAL_") == 0) {
-                // Formato: TEMPORAL_5_3_10
-                std::istringstream tempStream(line);
-                std::string tempCmd;
-                if (tempStream >> tempCmd) {
-                    size_t pos1 = tempCmd.find('_', 9);
-                    size_t pos2 = tempCmd.find('_', pos1 + 1);
-                    
-                    if (pos1 != std::string::npos && pos2 != std::string::npos) {
-                        int x = std::stoi(tempCmd.substr(9, pos1 - 9));
-                        int y = std::stoi(tempCmd.substr(pos1 + 1, pos2 - pos1 - 1));
-                        int turns = std::stoi(tempCmd.substr(pos2 + 1));
-                        
-                        levelData.temporalWalls[{x, y}] = turns;
-                        levelData.cellTypes[y][x] = 'T'; // Marcar como pared temporal
-                        std::cout << "Pared temporal en (" << x << ", " << y << ") se abre en turno: " << turns << std::endl;
-                    }
-                }
+            std::vector<bool>& pattern = levelData.gatePatterns[std::string(gateName)];
+            pattern.clear();
+            pattern.reserve(patternStr.size());
+            for (char c : patternStr) {
+                pattern.push_back(c == '1');
+            }
+            gateCount++;
+        } else if (directive.compare(0, 7, "ASSIGN_") == 0) {
+            // Formato: ASSIGN_3_4_A
+            int x = 0, y = 0;
+            offset += 7;
+            if (!ReadInt(line, offset, x) || !Expect(line, offset, '_') ||
+                !ReadInt(line, offset, y) || !Expect(line, offset, '_')) {
+                return ReportError(sourceName, reader.line, offset + 1, "se esperaba 'ASSIGN_x_y_patrón'");
+            }
+            std::string_view pattern = ReadToken(line, offset);
+            if (x < 0 || x >= levelData.width || y < 0 || y >= levelData.height) {
+                return ReportError(sourceName, reader.line, 8, "compuerta fuera del mapa");
             }
+            
+            levelData.gateAssignments.push_back({x, y, std::string(pattern)});
+            levelData.CellAt(x, y) = 'G'; // Marcar como compuerta
+        } else if (directive.compare(0, 9, "TEMPORAL_") == 0) {
+            // Formato: TEMPORAL_5_3_10
+            int x = 0, y = 0, turns = 0;
+            offset += 9;
+            if (!ReadInt(line, offset, x) || !Expect(line, offset, '_') ||
+                !ReadInt(line, offset, y) || !Expect(line, offset, '_') ||
+                !ReadInt(line, offset, turns)) {
+                return ReportError(sourceName, reader.line, offset + 1, "se esperaba 'TEMPORAL_x_y_turnos'");
+            }
+            if (x < 0 || x >= levelData.width || y < 0 || y >= levelData.height) {
+                return ReportError(sourceName, reader.line, 10, "pared temporal fuera del mapa");
+            }
+            
+            levelData.temporalWalls.push_back({x, y, turns});
+            levelData.CellAt(x, y) = 'T'; // Marcar como pared temporal
         }
-        
-    } catch (const std::exception& e) {
-        std::cout << "Error parseando archivo: " << e.what() << std::endl;
-        file.close();
+    }
+    if (reader.cancelled) {
         return false;
     }
     
-    file.close();
-    std::cout << "Nivel cargado exitosamente: " << filename << std::endl;
-    std::cout << "Dimensiones: " << levelData.width << "x" << levelData.height << std::endl;
-    std::cout << "Inicio: (" << levelData.startX << ", " << levelData.startY << ")" << std::endl;
-    std::cout << "Meta: (" << levelData.goalX << ", " << levelData.goalY << ")" << std::endl;
+    levelData.SortDirectives();
+    
+    std::cout << "Configuraciones: " << gateCount << " patrones, " << levelData.gateAssignments.size()
+              << " compuertas, " << levelData.temporalWalls.size() << " paredes temporales" << std::endl;
     
     return true;
 }
@@ -178,8 +414,427 @@ char FileLoader::ParseCellChar(char c) {
     }
 }
 
-// Función placeholder para JSON (no implementada), mala practica ya que no lo ocupo XD
-bool FileLoader::LoadFromJSON(const std::string& filename, LevelData& levelData) {
-    std::cout << "Carga JSON no implementada. Use archivos .txt" << std::endl;
-    return false;
-}
\ No newline at end of file
+namespace {
+
+// Construye el LevelData a partir de los eventos del lector JSON. Formato esperado:
+//   { "width": 8, "height": 6, "start": [0, 0], "goal": [7, 5], "turnCycle": 8,
+//     "rows": ["S..#....", ...],
+//     "gatePatterns": { "A": "11001100" },
+//     "gates": [ { "x": 3, "y": 4, "pattern": "A" } ],
+//     "temporalWalls": [ { "x": 5, "y": 3, "turns": 10 } ],
+//     "items": [ [6, 5], { "x": 2, "y": 2 } ] }
+// Las claves pueden venir en cualquier orden y las desconocidas se ignoran.
+class LevelJsonHandler : public JsonHandler {
+public:
+    LevelJsonHandler(LevelData& levelData, char (*cellChar)(char), const std::atomic<bool>* cancel)
+        : levelData(levelData), cellChar(cellChar), cancel(cancel) {}
+
+    bool Cancelled() const { return cancelled; }
+
+    bool OnObjectStart() override {
+        if (depth == 0) {
+            depth++;
+            return true;
+        }
+        return OpenContainer(false);
+    }
+
+    bool OnArrayStart() override {
+        if (depth == 0) {
+            return Reject("el nivel debe ser un objeto JSON");
+        }
+        return OpenContainer(true);
+    }
+
+    bool OnObjectEnd() override { return CloseContainer(); }
+    bool OnArrayEnd() override { return CloseContainer(); }
+
+    bool OnKey(std::string_view key) override {
+        if (depth == 1) {
+            field = FieldFor(key);
+        } else if (depth == 2 && field == Field::GATE_PATTERNS) {
+            patternName.assign(key.data(), key.size());
+        } else if (depth == 3) {
+            member = MemberFor(key);
+        }
+        return true;
+    }
+
+    bool OnInteger(int64_t value) override {
+        if (value < INT32_MIN || value > INT32_MAX) {
+            return Reject("número fuera de rango");
+        }
+        int number = (int)value;
+
+        if (depth == 1) {
+            switch (field) {
+                // Una dimensión repetida cambiaría el tamaño después de armar las celdas
+                case Field::WIDTH:
+                    if (hasWidth) return Reject("'width' repetido");
+                    levelData.width = number;
+                    hasWidth = true;
+                    break;
+                case Field::HEIGHT:
+                    if (hasHeight) return Reject("'height' repetido");
+                    levelData.height = number;
+                    hasHeight = true;
+                    break;
+                case Field::TURN_CYCLE: levelData.turnCycleLength = number; hasTurnCycle = true; break;
+                case Field::UNKNOWN: break;
+                default: return Reject(std::string("tipo inválido para '") + FieldName() + "'");
+            }
+            // Apenas se conocen las dos dimensiones, antes de que "rows" reserve el mapa
+            if ((field == Field::WIDTH || field == Field::HEIGHT) && hasWidth && hasHeight &&
+                !FileLoader::ValidDimensions(levelData.width, levelData.height)) {
+                return Reject("dimensiones inválidas (máximo " + std::to_string(FileLoader::MAX_CELLS) + " celdas)");
+            }
+        } else if (depth == 2 && (field == Field::START || field == Field::GOAL)) {
+            if (elementIndex > 1) {
+                return Reject(std::string("'") + FieldName() + "' debe ser [x, y]");
+            }
+            if (field == Field::START) {
+                (elementIndex == 0 ? levelData.startX : levelData.startY) = number;
+            } else {
+                (elementIndex == 0 ? levelData.goalX : levelData.goalY) = number;
+            }
+        } else if (depth == 3) {
+            if (entryIsArray) {
+                if (field == Field::ITEMS && memberIndex < 2) {
+                    (memberIndex == 0 ? entryX : entryY) = number;
+                    entryMembers |= memberIndex == 0 ? HAS_X : HAS_Y;
+                }
+            } else if (member == Member::X) {
+                entryX = number;
+                entryMembers |= HAS_X;
+            } else if (member == Member::Y) {
+                entryY = number;
+                entryMembers |= HAS_Y;
+            } else if (member == Member::TURNS) {
+                entryTurns = number;
+                entryMembers |= HAS_TURNS;
+            }
+        }
+        return Advance();
+    }
+
+    bool OnString(std::string_view value) override {
+        if (depth == 2 && field == Field::ROWS) {
+            if (!AddRow(value)) return false;
+            return Advance(value.size());
+        } else if (depth == 2 && field == Field::GATE_PATTERNS) {
+            std::vector<bool>& pattern = levelData.gatePatterns[patternName];
+            pattern.clear();
+            pattern.reserve(value.size());
+            for (char c : value) {
+                pattern.push_back(c == '1');
+            }
+        } else if (depth == 3 && !entryIsArray && member == Member::PATTERN) {
+            entryPattern.assign(value.data(), value.size());
+            entryMembers |= HAS_PATTERN;
+        } else if (depth == 1 && field != Field::UNKNOWN) {
+            return Reject(std::string("tipo inválido para '") + FieldName() + "'");
+        }
+        return Advance();
+    }
+
+    bool OnDouble(double) override {
+        if (depth == 1 && field == Field::UNKNOWN) return Advance();
+        if (depth > 3 || (depth == 3 && member == Member::OTHER)) return Advance();
+        return Reject("se esperaba un número entero");
+    }
+
+    bool OnBool(bool) override { return Advance(); }
+    bool OnNull() override { return Advance(); }
+
+    // Validaciones que dependen del documento completo; deja las directivas ordenadas
+    bool Finish(const std::string& sourceName);
+
+private:
+    enum class Field { UNKNOWN, WIDTH, HEIGHT, START, GOAL, TURN_CYCLE, ROWS, GATE_PATTERNS, GATES, TEMPORAL_WALLS, ITEMS };
+    enum class Member { OTHER, X, Y, PATTERN, TURNS };
+    enum : int { HAS_X = 1, HAS_Y = 2, HAS_PATTERN = 4, HAS_TURNS = 8 };
+
+    LevelData& levelData;
+    char (*cellChar)(char);
+    const std::atomic<bool>* cancel;
+    size_t workSinceCheck = 0;
+    bool cancelled = false;
+
+    int depth = 0;
+    Field field = Field::UNKNOWN;
+    int elementIndex = 0;               // Posición dentro del arreglo/objeto de segundo nivel
+    int memberIndex = 0;                // Posición dentro de una entrada (tercer nivel)
+    Member member = Member::OTHER;
+    std::string patternName;
+
+    // Entrada en construcción (compuerta, pared temporal o item)
+    bool entryIsArray = false;
+    int entryMembers = 0;
+    int entryX = 0, entryY = 0, entryTurns = 0;
+    std::string entryPattern;
+
+    bool hasWidth = false, hasHeight = false, hasTurnCycle = false;
+    bool hasStart = false, hasGoal = false;
+    bool cellsReady = false;
+    int rowCount = 0;
+    std::vector<std::string> pendingRows; // Filas que llegaron antes que "width"/"height"
+
+    static Field FieldFor(std::string_view key) {
+        if (key == "width") return Field::WIDTH;
+        if (key == "height") return Field::HEIGHT;
+        if (key == "start") return Field::START;
+        if (key == "goal") return Field::GOAL;
+        if (key == "turnCycle") return Field::TURN_CYCLE;
+        if (key == "rows") return Field::ROWS;
+        if (key == "gatePatterns") return Field::GATE_PATTERNS;
+        if (key == "gates") return Field::GATES;
+        if (key == "temporalWalls") return Field::TEMPORAL_WALLS;
+        if (key == "items") return Field::ITEMS;
+        return Field::UNKNOWN;
+    }
+
+    static Member MemberFor(std::string_view key) {
+        if (key == "x") return Member::X;
+        if (key == "y") return Member::Y;
+        if (key == "pattern") return Member::PATTERN;
+        if (key == "turns") return Member::TURNS;
+        return Member::OTHER;
+    }
+
+    const char* FieldName() const {
+        switch (field) {
+            case Field::WIDTH: return "width";
+            case Field::HEIGHT: return "height";
+            case Field::START: return "start";
+            case Field::GOAL: return "goal";
+            case Field::TURN_CYCLE: return "turnCycle";
+            case Field::ROWS: return "rows";
+            case Field::GATE_PATTERNS: return "gatePatterns";
+            case Field::GATES: return "gates";
+            case Field::TEMPORAL_WALLS: return "temporalWalls";
+            case Field::ITEMS: return "items";
+            default: return "?";
+        }
+    }
+
+    // Cuenta el valor recién terminado dentro de su contenedor
+    // Cuenta lo leído (una fila, su largo; cualquier otro valor, 1) y cada CANCEL_CHECK_BYTES mira cancel
+    bool Advance(size_t work = 1) {
+        if (depth == 2) elementIndex++;
+        else if (depth == 3) memberIndex++;
+        if (cancel != nullptr && (workSinceCheck += work) >= FileLoader::CANCEL_CHECK_BYTES) {
+            workSinceCheck = 0;
+            if (cancel->load(std::memory_order_relaxed)) {
+                cancelled = true;
+                return Reject("carga cancelada");
+            }
+        }
+        return true;
+    }
+
+    bool OpenContainer(bool isArray) {
+        depth++;
+        if (depth == 2 && field != Field::UNKNOWN) {
+            if (field == Field::WIDTH || field == Field::HEIGHT || field == Field::TURN_CYCLE) {
+                return Reject(std::string("tipo inválido para '") + FieldName() + "'");
+            }
+            bool expectArray = field != Field::GATE_PATTERNS;
+            if (isArray != expectArray) {
+                return Reject(std::string("'") + FieldName() + "' debe ser " + (expectArray ? "un arreglo" : "un objeto"));
+            }
+            elementIndex = 0;
+            if (field == Field::ROWS && !PrepareCells()) {
+                return false;
+            }
+        } else if (depth == 3) {
+            bool isEntry = field == Field::GATES || field == Field::TEMPORAL_WALLS || field == Field::ITEMS;
+            if (isEntry && isArray && field != Field::ITEMS) {
+                return Reject(std::string("las entradas de '") + FieldName() + "' deben ser objetos");
+            }
+            entryIsArray = isArray;
+            entryMembers = 0;
+            memberIndex = 0;
+            member = Member::OTHER;
+        }
+        return true;
+    }
+
+    bool CloseContainer() {
+        if (depth == 3 && !CommitEntry()) {
+            return false;
+        }
+        if (depth == 2 && (field == Field::START || field == Field::GOAL)) {
+            if (elementIndex != 2) {
+                return Reject(std::string("'") + FieldName() + "' debe ser [x, y]");
+            }
+            (field == Field::START ? hasStart : hasGoal) = true;
+        }
+        depth--;
+        return depth == 0 || Advance();
+    }
+
+    bool CommitEntry() {
+        if (field == Field::GATES) {
+            if (entryMembers != (HAS_X | HAS_Y | HAS_PATTERN)) {
+                return Reject("compuerta incompleta, se esperaba { \"x\", \"y\", \"pattern\" }");
+            }
+            levelData.gateAssignments.push_back({entryX, entryY, entryPattern});
+        } else if (field == Field::TEMPORAL_WALLS) {
+            if (entryMembers != (HAS_X | HAS_Y | HAS_TURNS)) {
+                return Reject("pared temporal incompleta, se esperaba { \"x\", \"y\", \"turns\" }");
+            }
+            levelData.temporalWalls.push_back({entryX, entryY, entryTurns});
+        } else if (field == Field::ITEMS) {
+            if ((entryMembers & (HAS_X | HAS_Y)) != (HAS_X | HAS_Y)) {
+                return Reject("item incompleto, se esperaba [x, y]");
+            }
+            levelData.items.push_back({entryX, entryY});
+        }
+        return true;
+    }
+
+    bool PrepareCells() {
+        if (!cellsReady && hasWidth && hasHeight && FileLoader::ValidDimensions(levelData.width, levelData.height)) {
+            try {
+                levelData.cells.assign((size_t)levelData.width * levelData.height, '.');
+            } catch (const std::bad_alloc&) {
+                return Reject("sin memoria para un mapa de " + std::to_string(levelData.width) + "x" +
+                              std::to_string(levelData.height));
+            }
+            cellsReady = true;
+        }
+        return true;
+    }
+
+    bool AddRow(std::string_view row) {
+        if (!cellsReady) {
+            pendingRows.emplace_back(row);
+            return true;
+        }
+        if (rowCount >= levelData.height) {
+            return Reject("'rows' tiene más filas que 'height'");
+        }
+        WriteRow(rowCount++, row);
+        return true;
+    }
+
+    // Misma interpretación de caracteres que el .txt (los espacios se saltan)
+    void WriteRow(int y, std::string_view line) {
+        char* row = &levelData.cells[(size_t)y * levelData.width];
+        int x = 0;
+        for (size_t i = 0; i < line.size() && x < levelData.width; i++) {
+            char c = line[i];
+            if (c == ' ') continue;
+
+            if (c == 'K') {
+                levelData.items.push_back({x, y});
+                row[x] = '.';
+            } else {
+                row[x] = cellChar(c);
+            }
+            x++;
+        }
+    }
+};
+
+bool LevelJsonHandler::Finish(const std::string& sourceName) {
+    if (!hasWidth || !hasHeight || !FileLoader::ValidDimensions(levelData.width, levelData.height)) {
+        return ReportError(sourceName, "faltan 'width'/'height' o son inválidos");
+    }
+    if (!hasTurnCycle || levelData.turnCycleLength <= 0) {
+        return ReportError(sourceName, "falta 'turnCycle' o es inválido");
+    }
+    if (!hasStart || !hasGoal) {
+        return ReportError(sourceName, "faltan 'start'/'goal'");
+    }
+
+    // Filas que llegaron antes de conocer las dimensiones
+    if (!pendingRows.empty()) {
+        if (!PrepareCells()) {
+            return ReportError(sourceName, RejectMessage());
+        }
+        if (pendingRows.size() > (size_t)levelData.height) {
+            return ReportError(sourceName, "'rows' tiene más filas que 'height'");
+        }
+        for (const std::string& row : pendingRows) {
+            WriteRow(rowCount++, row);
+        }
+        pendingRows.clear();
+    }
+    if (rowCount != levelData.height) {
+        return ReportError(sourceName, "falta la fila " + std::to_string(rowCount) + " del mapa");
+    }
+    if (levelData.cells.size() != (size_t)levelData.width * levelData.height) {
+        return ReportError(sourceName, "las celdas no coinciden con 'width' x 'height'");
+    }
+
+    for (const GateAssignment& gate : levelData.gateAssignments) {
+        if (gate.x < 0 || gate.x >= levelData.width || gate.y < 0 || gate.y >= levelData.height) {
+            return ReportError(sourceName, "compuerta fuera del mapa");
+        }
+        levelData.CellAt(gate.x, gate.y) = 'G'; // Marcar como compuerta
+    }
+    for (const TemporalWall& wall : levelData.temporalWalls) {
+        if (wall.x < 0 || wall.x >= levelData.width || wall.y < 0 || wall.y >= levelData.height) {
+            return ReportError(sourceName, "pared temporal fuera del mapa");
+        }
+        levelData.CellAt(wall.x, wall.y) = 'T'; // Marcar como pared temporal
+    }
+    for (const auto& item : levelData.items) {
+        if (item.first < 0 || item.first >= levelData.width || item.second < 0 || item.second >= levelData.height) {
+            return ReportError(sourceName, "item fuera del mapa");
+        }
+    }
+
+    levelData.SortDirectives();
+    return true;
+}
+
+} // namespace
+
+bool FileLoader::LoadFromJSON(const std::string& filename, LevelData& levelData, const std::atomic<bool>* cancel) {
+    // Se parsea directo sobre el archivo mapeado, sin copiarlo a un buffer
+    MappedFile file;
+    if (!file.Open(filename)) {
+        std::cout << "No se pudo abrir el archivo: " << filename << std::endl;
+        return false;
+    }
+    
+    std::string_view text(reinterpret_cast<const char*>(file.Data()), file.Size());
+    if (!LoadFromJSONBuffer(filename, text, levelData, cancel)) {
+        return false;
+    }
+    
+    std::cout << "Nivel cargado exitosamente: " << filename << std::endl;
+    std::cout << "Dimensiones: " << levelData.width << "x" << levelData.height << std::endl;
+    std::cout << "Inicio: (" << levelData.startX << ", " << levelData.startY << ")" << std::endl;
+    std::cout << "Meta: (" << levelData.goalX << ", " << levelData.goalY << ")" << std::endl;
+    
+    return true;
+}
+
+bool FileLoader::LoadFromJSONBuffer(const std::string& sourceName, std::string_view text, LevelData& levelData,
+                                    const std::atomic<bool>* cancel) {
+    levelData.cells.clear();
+    levelData.items.clear();
+    levelData.gatePatterns.clear();
+    levelData.gateAssignments.clear();
+    levelData.temporalWalls.clear();
+    
+    LevelJsonHandler handler(levelData, ParseCellChar, cancel);
+    JsonError error;
+    if (!JsonReader::Parse(text, handler, error)) {
+        if (handler.Cancelled()) {
+            return false;
+        }
+        return ReportError(sourceName, error.line, error.column, error.message);
+    }
+    if (!handler.Finish(sourceName)) {
+        return false;
+    }
+    
+    std::cout << "Configuraciones: " << levelData.gatePatterns.size() << " patrones, " << levelData.gateAssignments.size()
+              << " compuertas, " << levelData.temporalWalls.size() << " paredes temporales" << std::endl;
+    
+    return true;
+}
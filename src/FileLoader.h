@@ -1,26 +1,74 @@
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 
+struct GateAssignment {
+    int x, y;
+    std::string pattern;
+};
+
+struct TemporalWall {
+    int x, y;
+    int turns;
+};
+
 struct LevelData {
     int width, height;
     int startX, startY;
     int goalX, goalY;
-    std::vector<std::vector<char>> cellTypes;
+    std::vector<char> cells;                            // Mapa plano fila por fila (width * height)
     std::vector<std::pair<int, int>> items;
     std::map<std::string, std::vector<bool>> gatePatterns;
-    std::map<std::pair<int, int>, std::string> gateAssignments;
-    std::map<std::pair<int, int>, int> temporalWalls;
+    std::vector<GateAssignment> gateAssignments;        // Ordenadas por (y, x), sin duplicados
+    std::vector<TemporalWall> temporalWalls;            // Ordenadas por (y, x), sin duplicados
     int turnCycleLength;
+    
+    // Tablas precalculadas para los solvers (opcionales, p. ej. desde un .etgl mapeado en memoria)
+    std::shared_ptr<const void> tableStorage;   // Mantiene viva la memoria a la que apuntan las tablas
+    const uint8_t* adjacency = nullptr;         // Máscara de vecinos transitables por celda
+    const uint32_t* goalDistance = nullptr;     // Distancia estática a la meta por celda
+    
+    char CellAt(int x, int y) const { return cells[(size_t)y * width + x]; }
+    char& CellAt(int x, int y) { return cells[(size_t)y * width + x]; }
+    
+    // Búsqueda binaria sobre los vectores ordenados, nullptr si no hay nada en (x, y)
+    const GateAssignment* FindGate(int x, int y) const;
+    const TemporalWall* FindTemporalWall(int x, int y) const;
+    
+    // Ordena las directivas por (y, x); si una celda se repite gana la última, como en el .txt
+    void SortDirectives();
 };
 
+class LevelLineReader;
+
+// cancel (opcional): los parsers de .txt y .json lo miran cada tanto mientras leen; si se pone en true devuelven
+// false sin reportar error. El .etgl no parsea nada y no lo mira.
 class FileLoader {
 public:
-    static bool LoadLevel(const std::string& filename, LevelData& levelData);
-    static bool LoadFromJSON(const std::string& filename, LevelData& levelData);
-    static bool LoadFromTXT(const std::string& filename, LevelData& levelData);
+    static const size_t CANCEL_CHECK_BYTES = 64 * 1024;     // Cada cuánto texto leído se mira cancel
+    static constexpr int64_t MAX_CELLS = (int64_t)1 << 26;   // 8192x8192; los índices de celda son int
+    
+    // Ancho y alto positivos y ancho * alto dentro de MAX_CELLS (se revisa antes de reservar el mapa)
+    static bool ValidDimensions(int width, int height) {
+        return width > 0 && height > 0 && (int64_t)width * height <= MAX_CELLS;
+    }
+    
+    static bool LoadLevel(const std::string& filename, LevelData& levelData, const std::atomic<bool>* cancel = nullptr);
+    static bool LoadFromJSON(const std::string& filename, LevelData& levelData, const std::atomic<bool>* cancel = nullptr);
+    static bool LoadFromJSONBuffer(const std::string& sourceName, std::string_view text, LevelData& levelData,
+                                   const std::atomic<bool>* cancel = nullptr);
+    static bool LoadFromETGL(const std::string& filename, LevelData& levelData);
+    static bool LoadFromTXT(const std::string& filename, LevelData& levelData, const std::atomic<bool>* cancel = nullptr);
+    static bool LoadFromTXTBuffer(const std::string& sourceName, std::string_view text, LevelData& levelData,
+                                  const std::atomic<bool>* cancel = nullptr);
     
 private:
+    static bool ParseTXT(const std::string& sourceName, LevelLineReader& reader, LevelData& levelData);
     static char ParseCellChar(char c);
+    static bool HasExtension(const std::string& filename, const char* extension);
 };
@@ -1,8 +1,16 @@
 // Pantalla de inicio del juego
 #include "Game.h"
 #include "FileLoader.h"
+#include "LevelTables.h"
+#include "MemoryReport.h"
 #include <iostream>
 #include <cstring>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <thread>
 
 // Función pa crear colores
 Color CreateColor(int r, int g, int b, int a) {
@@ -14,14 +22,23 @@ Color CreateColor(int r, int g, int b, int a) {
     return color;
 }
 
-Game::Game() : grid(nullptr), player(nullptr), pathFinder(nullptr), 
-               state(GameState::MENU), solutionStep(0), stepTimer(0.0f) {
+Game::Game() : state(GameState::MENU), lastResetMicros(-1.0), menuPage(0), hotReload(false), solutionStep(0), solutionStepTicks(0),
+               simState(GameState::PLAYING), searching(false), scoreSearch(false), searchId(0), searchBound(0.0), tickCount(0), turboTicks(1),
+               startWhenLoaded(false), recordedSessions(0), worldVersion(0), animationFrom{0, 0}, animationTicks(MOVE_ANIMATION_TICKS),
+               simRunning(false), solverDone(false), anytimeBound(0.0), anytimeVersion(0),
+               adoptedVersion(0), anytimeAdopted(false), showSearch(true), showHint(false), pulseTimer(0.0f) {
 }
 
 Game::~Game() {
-    delete grid;
-    delete player;
-    delete pathFinder;
+    StopSimulation();
+    FinishRecording();
+    CancelBackgroundLoad();
+    if (loaderThread.joinable()) {
+        loaderThread.join();
+    }
+    for (RetiredLoader& retired : retiredLoaders) {
+        retired.thread.join();
+    }
 }
 
 void Game::Initialize() {
@@ -30,41 +47,260 @@ void Game::Initialize() {
     SetTargetFPS(60);
     SetExitKey(KEY_NULL);  
     
+    // Con recarga en caliente se juega sobre los archivos sueltos, que son los que edita el diseñador
+    if (hotReload) {
+        hotReload = levelWatcher.Start();
+        std::cout << "Recarga en caliente: el menú usa los .txt de assets/levels" << std::endl;
+    } else if (!levelPack.Open(LEVEL_PACK_FILE)) {
+        // Solo se lee el índice; cada nivel se decodifica al elegirlo
+        std::cout << "Sin paquete de niveles, se usan los .txt de assets/levels" << std::endl;
+    }
+    
     state = GameState::MENU;
 }
 
 void Game::ShowTutorial(const std::string& levelToLoad) {
     pendingLevel = levelToLoad;
     state = GameState::TUTORIAL;
+    
+    // La carga arranca ya; el tutorial tapa el tiempo de parseo y de armado del grid
+    if (levelToLoad != "DEBUG_LEVEL") {
+        StartBackgroundLoad(levelToLoad);
+    }
 }
 
-void Game::LoadLevel(const std::string& filename) {
-    delete grid;
-    delete player;
-    delete pathFinder;
-    
-    grid = new Grid(10, 8);
-    
-    if (grid->LoadFromFile(filename)) {
-        player = new Player((int)grid->startPos.x, (int)grid->startPos.y);
-        pathFinder = new PathFinder(grid);
-        state = GameState::PLAYING;
-        currentLevel = filename;
-        std::cout << "Nivel cargado: " << filename << std::endl;
-    } else {
-        std::cout << "Error cargando nivel: " << filename << std::endl;
+std::shared_ptr<LevelLoadJob> Game::CreateLoadJob(const std::string& filename) {
+    auto job = std::make_shared<LevelLoadJob>();
+    job->key = filename;
+    
+    // Cada archivo se parsea una sola vez; después se comparte el mismo LevelData inmutable
+    auto cached = levelCache.find(filename);
+    if (cached != levelCache.end()) {
+        job->data = cached->second;
+    }
+    return job;
+}
+
+// Todo lo caro de entrar a un nivel: parseo, tablas del solver y construcción de Grid/Player/PathFinder.
+// No usa raylib ni miembros de Game, así que corre igual en el hilo trabajador.
+void Game::PrepareLevel(LevelLoadJob& job, const LevelPack& pack) {
+    auto startTime = std::chrono::steady_clock::now();
+    
+    if (job.data == nullptr) {
+        auto data = std::make_shared<LevelData>();
+        bool loaded = false;
+        if (job.key.compare(0, std::strlen(PACK_KEY_PREFIX), PACK_KEY_PREFIX) == 0) {
+            // "pack:<índice>" es un nivel del paquete
+            size_t index = std::strtoul(job.key.c_str() + std::strlen(PACK_KEY_PREFIX), nullptr, 10);
+            loaded = pack.LoadLevel(index, *data, &job.cancelled);
+        } else {
+            loaded = FileLoader::LoadLevel(job.key, *data, &job.cancelled);
+        }
+        if (!loaded || job.cancelled.load()) {
+            return;
+        }
+        
+        // Campo de distancias a la meta para la heurística de A* (ya viene hecho en un .etgl)
+        LevelTables::AttachGoalDistances(*data);
+        job.data = data;
+    }
+    
+    if (job.cancelled.load()) {
+        return;
+    }
+    
+    job.grid = std::make_unique<Grid>(10, 8);
+    job.grid->LoadFromLevelData(*job.data);
+    job.player = std::make_unique<Player>(job.grid->startPos.x, job.grid->startPos.y,
+                                          job.grid->width, job.grid->height);
+    job.pathFinder = std::make_unique<PathFinder>(job.grid.get());
+    if (job.cancelled.load()) {
+        return;
+    }
+    
+    // Tabla hacia atrás de turnos a la meta: pistas y fin de partida sin buscar durante el juego.
+    // Si no entra en memoria el nivel se juega igual, sin esas dos cosas.
+    job.timeToGoal = std::make_unique<TimeToGoalTable>();
+    job.timeToGoal->Build(*job.grid);
+    job.ok = true;
+    
+    auto endTime = std::chrono::steady_clock::now();
+    job.prepareMillis = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+}
+
+// La carga anterior queda cancelada; su hilo no se espera acá sino en JoinFinishedLoaders, cuando termine
+void Game::StartBackgroundLoad(const std::string& filename) {
+    CancelBackgroundLoad();
+    if (loaderThread.joinable()) {
+        retiredLoaders.push_back({std::move(loaderThread), loaderJob});
+    }
+    JoinFinishedLoaders();
+    
+    loadJob = CreateLoadJob(filename);
+    startWhenLoaded = false;
+    
+    // El trabajador recibe su propia referencia al trabajo y una copia del paquete (comparte el mapeo)
+    std::shared_ptr<LevelLoadJob> job = loadJob;
+    LevelPack pack = levelPack;
+    loaderJob = job;
+    loaderThread = std::thread([job, pack]() {
+        PrepareLevel(*job, pack);
+        job->done.store(true, std::memory_order_release);
+    });
+}
+
+void Game::CancelBackgroundLoad() {
+    if (loadJob != nullptr) {
+        loadJob->cancelled.store(true);
+        loadJob = nullptr;
+    }
+    startWhenLoaded = false;
+}
+
+// Solo junta los hilos que ya marcaron done (el join es inmediato); los demás se revisan en el próximo frame
+void Game::JoinFinishedLoaders() {
+    for (size_t i = 0; i < retiredLoaders.size();) {
+        if (retiredLoaders[i].job->done.load(std::memory_order_acquire)) {
+            retiredLoaders[i].thread.join();
+            retiredLoaders.erase(retiredLoaders.begin() + i);
+        } else {
+            i++;
+        }
+    }
+}
+
+// Cambia al nivel preparado; en el hilo principal solo quedan intercambios de punteros
+void Game::AdoptLevel(LevelLoadJob& job) {
+    if (!job.ok) {
+        std::cout << "Error cargando nivel: " << job.key << std::endl;
         state = GameState::MENU;
+        return;
     }
+    
+    StopSimulation();
+    FinishRecording();
+    
+    grid = std::move(job.grid);
+    player = std::move(job.player);
+    pathFinder = std::move(job.pathFinder);
+    timeToGoal = std::move(job.timeToGoal);
+    levelCache[job.key] = job.data;
+    levelData = job.data;
+    lastResetMicros = -1.0;
+    solutionPath.clear();
+    animationTicks = MOVE_ANIMATION_TICKS;
+    simState = GameState::PLAYING;
+    currentLevel = job.key;
+    std::cout << "Nivel cargado: " << job.key << " (preparado en " << job.prepareMillis << " ms)" << std::endl;
+    
+    if (hotReload) {
+        levelWatcher.Watch(job.key, job.data);
+    }
+    BeginRecording();
+    StartSimulation();
+}
+
+// Aplica la última recarga del archivo actual; el parseo y el diff ya se hicieron en el hilo del watcher.
+// Solo mientras se juega ese nivel: en el menú o el tutorial queda en la caché y se usa al volver a entrar.
+void Game::ApplyHotReload() {
+    LevelReload reload;
+    if (!levelWatcher.TakeReload(reload) || reload.filename != currentLevel || grid == nullptr) {
+        return;
+    }
+    
+    if (!simThread.joinable()) {
+        levelCache[reload.filename] = reload.levelData;
+        // Si el tutorial ya estaba preparando este nivel, lo preparaba con la versión anterior
+        if (state == GameState::TUTORIAL && pendingLevel == reload.filename && loadJob != nullptr) {
+            bool start = startWhenLoaded;
+            StartBackgroundLoad(pendingLevel);
+            startWhenLoaded = start;
+        }
+        std::cout << "Recarga en caliente: " << reload.filename << " se aplica la próxima vez que se juegue" << std::endl;
+        return;
+    }
+    
+    // El grid es del hilo de simulación: se para, se aplica la recarga y vuelve a arrancar
+    StopSimulation();
+    
+    if (reload.diff.sizeChanged) {
+        // Sin diff posible: se rearma el nivel con los datos ya parseados
+        LevelLoadJob job;
+        job.key = currentLevel;
+        job.data = reload.levelData;
+        PrepareLevel(job, levelPack);
+        AdoptLevel(job);
+        return;
+    }
+    
+    // La grabación no se podría reproducir contra el nivel nuevo: se cierra acá y la próxima empieza al reiniciar
+    FinishRecording();
+    levelCache[currentLevel] = reload.levelData;
+    levelData = reload.levelData;
+    grid->ApplyLevelDiff(*reload.levelData, reload.diff);
+    if (reload.timeToGoal != nullptr) {
+        timeToGoal = std::move(reload.timeToGoal);
+    } else {
+        timeToGoal->Build(*grid);
+    }
+    
+    // El jugador sigue donde estaba, salvo que su celda ahora sea pared
+    if (grid->CellAt(player->x, player->y).type == CellType::WALL) {
+        Reset();
+    }
+    
+    // El camino del auto-solve solo se descarta si pasa por una celda que cambió
+    if (simState == GameState::AUTO_SOLVING) {
+        for (const auto& changed : reload.diff.cells) {
+            bool onPath = std::any_of(solutionPath.begin(), solutionPath.end(), [&](const GridPos& step) {
+                return step.x == changed.first && step.y == changed.second;
+            });
+            if (onPath) {
+                std::cout << "Recarga en caliente: el camino automático pasaba por una celda cambiada" << std::endl;
+                solutionPath.clear();
+                simState = GameState::PLAYING;
+                break;
+            }
+        }
+    }
+    
+    std::cout << "Recarga aplicada: " << reload.diff.cells.size() << " celdas" << std::endl;
+    StartSimulation();
+}
+
+// Versión síncrona, para cuando no hubo tutorial que tape la carga
+void Game::LoadLevel(const std::string& filename) {
+    std::shared_ptr<LevelLoadJob> job = CreateLoadJob(filename);
+    PrepareLevel(*job, levelPack);
+    AdoptLevel(*job);
 }
 
 void Game::Update() {
+    if (hotReload) {
+        ApplyHotReload();
+    }
+    if (!retiredLoaders.empty()) {
+        JoinFinishedLoaders();
+    }
+    
+    // Durante la partida el estado lo decide la simulación; acá se lee del último snapshot
+    if (simThread.joinable()) {
+        snapshots.Update();
+        state = snapshots.ReadBuffer().state;
+    }
+    RenderSnapshot& view = snapshots.ReadBuffer();
+    
     switch (state) {
         case GameState::MENU:
             // NIVELES - Ahora muestran tutorial antes de cargar
-            if (IsKeyPressed(KEY_ONE)) ShowTutorial("assets/levels/level1.txt");
-            if (IsKeyPressed(KEY_TWO)) ShowTutorial("assets/levels/level2.txt");
-            if (IsKeyPressed(KEY_THREE)) ShowTutorial("assets/levels/level_expert.txt");
-            if (IsKeyPressed(KEY_FOUR)) ShowTutorial("assets/levels/level_nightmare.txt");
+            if (levelPack.IsOpen()) {
+                UpdatePackMenu();
+            } else {
+                if (IsKeyPressed(KEY_ONE)) ShowTutorial("assets/levels/level1.txt");
+                if (IsKeyPressed(KEY_TWO)) ShowTutorial("assets/levels/level2.txt");
+                if (IsKeyPressed(KEY_THREE)) ShowTutorial("assets/levels/level_expert.txt");
+                if (IsKeyPressed(KEY_FOUR)) ShowTutorial("assets/levels/level_nightmare.txt");
+            }
             
             // PARA DEBUG: cargar nivel simple con T (también con tutorial)
             if (IsKeyPressed(KEY_T)) {
@@ -82,45 +318,61 @@ void Game::Update() {
             if (IsKeyPressed(KEY_SPACE) || IsKeyPressed(KEY_ENTER) || IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
                 if (pendingLevel == "DEBUG_LEVEL") {
                     // Crear nivel de debug, este nivel no es necesario, solo era para pruebas, tengo que eliminarlo, pero siempre aparecen solo 4 :D
-                    delete grid;
-                    delete player;
-                    delete pathFinder;
-                    
-                    grid = new Grid(8, 6);
-                    grid->cells[0][0].type = CellType::START;
-                    grid->cells[5][7].type = CellType::GOAL;
-                    grid->cells[2][3].type = CellType::WALL;
-                    grid->cells[3][4].type = CellType::ITEM;
+                    grid = std::make_unique<Grid>(8, 6);
+                    grid->CellAt(0, 0).type = CellType::START;
+                    grid->CellAt(7, 5).type = CellType::GOAL;
+                    grid->CellAt(3, 2).type = CellType::WALL;
+                    grid->CellAt(4, 3).type = CellType::ITEM;
+                    grid->itemPositions.push_back({4, 3});
                     
                     grid->startPos = {0, 0};
                     grid->goalPos = {7, 5};
                     
-                    player = new Player(0, 0);
-                    pathFinder = new PathFinder(grid);
-                    state = GameState::PLAYING;
+                    player = std::make_unique<Player>(0, 0, grid->width, grid->height);
+                    pathFinder = std::make_unique<PathFinder>(grid.get());
+                    timeToGoal = std::make_unique<TimeToGoalTable>();
+                    timeToGoal->Build(*grid);
+                    levelData = nullptr;
+                    lastResetMicros = -1.0;
+                    solutionPath.clear();
+                    simState = GameState::PLAYING;
                     currentLevel = "DEBUG_LEVEL";
                     
                     std::cout << "Nivel de debug cargado" << std::endl;
+                    StartSimulation();
+                } else if (loadJob != nullptr) {
+                    // Si el trabajador no terminó, se entra apenas termine (sin bloquear el frame)
+                    startWhenLoaded = true;
                 } else {
                     LoadLevel(pendingLevel);
                 }
             }
             
+            if (startWhenLoaded && loadJob != nullptr && loadJob->done.load(std::memory_order_acquire)) {
+                std::shared_ptr<LevelLoadJob> job = loadJob;
+                loadJob = nullptr;
+                startWhenLoaded = false;
+                AdoptLevel(*job);
+                break;
+            }
+            
             // ESC regresa al menú
             if (IsKeyPressed(KEY_ESCAPE)) {
                 std::cout << "Volviendo al menú desde tutorial..." << std::endl;
+                CancelBackgroundLoad();
                 state = GameState::MENU;
             }
             break;
             
         case GameState::PLAYING:
-            HandleMouseInput();
-            if (grid) grid->Update();
-            if (IsGameWon()) {
-                state = GameState::WIN;
-            }
-            if (IsKeyPressed(KEY_R)) Reset();
-            if (IsKeyPressed(KEY_SPACE)) StartAutoSolve();
+            HandleMouseInput(view);
+            if (IsKeyPressed(KEY_R)) PostCommand({SimCommandType::RESET});
+            if (IsKeyPressed(KEY_SPACE)) PostCommand({SimCommandType::AUTO_SOLVE});
+            if (IsKeyPressed(KEY_P)) PostCommand({SimCommandType::SCORE_SOLVE});
+            if (IsKeyPressed(KEY_TAB)) SetTurbo(view.turboTicks * 4);
+            if (IsKeyPressed(KEY_H)) showSearch = !showSearch;
+            if (IsKeyPressed(KEY_G)) showHint = !showHint;
+            if (IsKeyPressed(KEY_M)) PostCommand({SimCommandType::MEMORY_REPORT});
 
             if (IsKeyPressed(KEY_ESCAPE)) {
                 std::cout << "Volviendo al menú desde juego..." << std::endl;
@@ -129,9 +381,10 @@ void Game::Update() {
             break;
             
         case GameState::AUTO_SOLVING:
-            UpdateAutoSolve();
-            if (grid) grid->Update();
-            if (IsKeyPressed(KEY_R)) Reset();
+            // Los pasos del auto-solve los da el hilo de simulación; acá solo se atiende el teclado
+            if (IsKeyPressed(KEY_R)) PostCommand({SimCommandType::RESET});
+            if (IsKeyPressed(KEY_TAB)) SetTurbo(view.turboTicks * 4);
+            if (IsKeyPressed(KEY_H)) showSearch = !showSearch;
             if (IsKeyPressed(KEY_ESCAPE)) {
                 std::cout << "Volviendo al menú desde auto-solve..." << std::endl;
                 state = GameState::MENU;
@@ -139,7 +392,7 @@ void Game::Update() {
             break;
             
         case GameState::WIN:
-            if (IsKeyPressed(KEY_R)) Reset();
+            if (IsKeyPressed(KEY_R)) PostCommand({SimCommandType::RESET});
             if (IsKeyPressed(KEY_ESCAPE)) state = GameState::MENU;
             if (IsKeyPressed(KEY_ESCAPE)) {
                 std::cout << "Volviendo al menú desde victoria..." << std::endl;
@@ -148,7 +401,7 @@ void Game::Update() {
             break;
             
         case GameState::GAME_OVER:
-            if (IsKeyPressed(KEY_R)) Reset();
+            if (IsKeyPressed(KEY_R)) PostCommand({SimCommandType::RESET});
             if (IsKeyPressed(KEY_ESCAPE)) state = GameState::MENU;
             if (IsKeyPressed(KEY_ESCAPE)) {
                 std::cout << "Volviendo al menú desde game over..." << std::endl;
@@ -156,98 +409,448 @@ void Game::Update() {
             }
             break;
     }
-}
-
-void Game::HandleMouseInput() {
-    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-        Vector2 mousePos = GetMousePosition();
-        HexCell* clickedCell = grid->GetCellAt(mousePos);
-        
-        if (clickedCell != nullptr) {
-            if (grid->IsValidMove(player->x, player->y, clickedCell->x, clickedCell->y)) {
-                if (player->HasVisited(clickedCell->x, clickedCell->y)) {
-                    player->ReduceScoreForBacktrack();
-                }
-                
-                player->MoveTo(clickedCell->x, clickedCell->y);
-                player->AddToPath(clickedCell->x, clickedCell->y);
-                clickedCell->isVisited = true;
-                
-                if (clickedCell->type == CellType::ITEM) {
-                    player->items.push_back({(float)clickedCell->x, (float)clickedCell->y});
-                    clickedCell->type = CellType::FREE;
-                    player->score += 100;
-                }
-                
-                grid->currentTurn++;
-            }
+    
+    // Volver al menú para la simulación y cierra la partida grabada
+    if (state == GameState::MENU) {
+        StopSimulation();
+        if (recorder.IsActive()) {
+            FinishRecording();
         }
     }
+}
+
+// Menú desde el índice del paquete: 1-8 eligen en la página actual, flechas cambian de página
+void Game::UpdatePackMenu() {
+    int levelCount = (int)levelPack.LevelCount();
+    int pageCount = (levelCount + LEVELS_PER_PAGE - 1) / LEVELS_PER_PAGE;
     
-    Vector2 mousePos = GetMousePosition();
+    if (IsKeyPressed(KEY_RIGHT) && menuPage + 1 < pageCount) menuPage++;
+    if (IsKeyPressed(KEY_LEFT) && menuPage > 0) menuPage--;
     
-    for (int y = 0; y < grid->height; y++) {
-        for (int x = 0; x < grid->width; x++) {
-            grid->cells[y][x].isHighlighted = false;
+    for (int i = 0; i < LEVELS_PER_PAGE; i++) {
+        int index = menuPage * LEVELS_PER_PAGE + i;
+        if (index < levelCount && IsKeyPressed(KEY_ONE + i)) {
+            ShowTutorial(PACK_KEY_PREFIX + std::to_string(index));
+        }
+    }
+}
+
+// El click se traduce a una celda acá y se manda como comando; el movimiento lo valida la simulación.
+// GetCellAt solo usa la geometría del grid (ancho, alto, tamaño), que no cambia mientras corre la simulación.
+void Game::HandleMouseInput(const RenderSnapshot& view) {
+    if (view.state == GameState::PLAYING && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+        GridPos clickedCell;
+        if (grid->GetCellAt(GetMousePosition(), clickedCell)) {
+            PostCommand({SimCommandType::CLICK, clickedCell.x, clickedCell.y});
         }
     }
+}
+
+void Game::PostCommand(const SimCommand& command) {
+    if (!commands.Push(command)) {
+        std::cout << "Cola de comandos llena, se descarta la entrada" << std::endl;
+    }
+}
+
+// Se aplica en el hilo de simulación, antes del tick siguiente
+void Game::ApplyCommand(const SimCommand& command) {
+    switch (command.type) {
+        case SimCommandType::CLICK:
+            if (simState == GameState::PLAYING && !searching) ApplyClick(command.x, command.y);
+            break;
+        case SimCommandType::RESET:
+            Reset();
+            break;
+        case SimCommandType::AUTO_SOLVE:
+            if (simState == GameState::PLAYING && !searching) StartAutoSolve();
+            break;
+        case SimCommandType::SCORE_SOLVE:
+            if (simState == GameState::PLAYING && !searching) StartAutoSolve(true);
+            break;
+        case SimCommandType::SET_TURBO:
+            turboTicks = command.x;
+            break;
+        case SimCommandType::MEMORY_REPORT:
+            PrintMemoryReport();
+            break;
+    }
+}
+
+// Mismo orden que graba y reproduce el .etgr: mover, actualizar compuertas, chequear victoria
+void Game::ApplyClick(int x, int y) {
+    int turn = grid->currentTurn;
+    GridPos from = {player->x, player->y};
+    bool moved = GameRules::ApplyPlayerMove(*grid, *player, x, y);
+    recorder.RecordClick(turn, x, y, moved);
+    if (moved) StartMoveAnimation(from);
     
-    HexCell* hoveredCell = grid->GetCellAt(mousePos);
-    if (hoveredCell != nullptr) {
-        hoveredCell->isHighlighted = true;
+    grid->Update();
+    if (IsGameWon()) {
+        simState = GameState::WIN;
+    } else if (IsDeadState()) {
+        // Ningún camino desde (celda, turno) llega a la meta: no tiene sentido seguir jugando
+        simState = GameState::GAME_OVER;
+        std::cout << "Sin salida en el turno " << grid->currentTurn << std::endl;
     }
 }
 
-void Game::StartAutoSolve() {
-    std::cout << "Iniciando resolución automática..." << std::endl;
-    solutionPath = pathFinder->FindPathAStar();
+// Lanza la búsqueda en su propio hilo sobre una copia del grid; la simulación sigue corriendo y el dibujo
+// muestra el progreso. El ARA* publica cada camino mejor y Tick lo adopta sin esperar al final; el último
+// resultado se toma en FinishSearch. Por puntaje se busca la ruta que junta items sin volver sobre lo pisado
+// (sin mapa de calor: los tramos son BFS cortos).
+void Game::StartAutoSolve(bool maximizeScore) {
+    if (searching) {
+        return;
+    }
+    std::cout << (maximizeScore ? "Iniciando resolución por puntaje..." : "Iniciando resolución automática...") << std::endl;
+    
+    solverGrid = std::make_unique<Grid>(*grid);
+    pathFinder->grid = solverGrid.get();
+    pathFinder->trace = &searchTrace;
+    searchTrace.Begin(solverGrid->width, solverGrid->height, ++searchId);
+    solverDone.store(false, std::memory_order_relaxed);
+    searching = true;
+    scoreSearch = maximizeScore;
+    searchBound = 0.0;
+    anytimeAdopted = false;
+    adoptedVersion = anytimeVersion.load(std::memory_order_relaxed);
+    
+    if (maximizeScore) {
+        solverThread = std::thread([this, solverPlayer = *player]() {
+            ItemRoute route = ItemRoutePlanner::PlanFor(*solverGrid, solverPlayer);
+            if (route.found) {
+                std::cout << "Ruta por puntaje: " << route.items << " de " << route.itemCount << " items, "
+                          << route.backtracks << " vueltas, puntaje " << route.score << " ("
+                          << route.legMillis + route.orderMillis << " ms)" << std::endl;
+            }
+            solverResult = std::move(route.path);
+            solverDone.store(true, std::memory_order_release);
+        });
+        return;
+    }
+    solverThread = std::thread([this]() {
+        solverResult = pathFinder->FindPathAnytime(SolverLimits::AnytimeFor(*solverGrid), AnytimeSettings(),
+                                                   [this](const AnytimeSolution& solution) {
+            std::lock_guard<std::mutex> lock(anytimeMutex);
+            anytimePath = solution.path;
+            anytimeBound = solution.bound;
+            anytimeVersion.fetch_add(1, std::memory_order_release);
+        });
+        solverDone.store(true, std::memory_order_release);
+    });
+}
+
+// El primer camino arranca el auto-solve en el acto. Los siguientes lo reemplazan solo si son más cortos y
+// empiezan con los pasos que ya se dieron (mismas celdas en los mismos turnos); si no, se sigue con el que había.
+void Game::AdoptAnytimePath(std::vector<GridPos>& path, double bound) {
+    if (path.empty()) {
+        return;
+    }
+    if (!anytimeAdopted) {
+        if (simState != GameState::PLAYING) return;
+        anytimeAdopted = true;
+        searchBound = bound;
+        solutionPath = std::move(path);
+        recorder.RecordAnytimeSolve(grid->currentTurn, (int)solutionPath.size());
+        simState = GameState::AUTO_SOLVING;
+        solutionStep = 0;
+        solutionStepTicks = 0;
+        std::cout << "Camino encontrado con " << solutionPath.size() << " pasos (cota " << bound << "), sigue buscando..." << std::endl;
+        return;
+    }
+    if (simState != GameState::AUTO_SOLVING) {
+        return;
+    }
+    searchBound = bound;
+    if (path.size() >= solutionPath.size() || (int)path.size() <= solutionStep ||
+        !std::equal(solutionPath.begin(), solutionPath.begin() + solutionStep, path.begin())) {
+        return;
+    }
+    solutionPath = std::move(path);
+    recorder.RecordAnytimeSolve(grid->currentTurn, (int)solutionPath.size() - solutionStep);
+    std::cout << "Camino mejorado: " << solutionPath.size() << " pasos (cota " << bound << ")" << std::endl;
+}
+
+// Mientras se buscaba no se aceptaron clicks, así que el turno grabado es el mismo del pedido
+void Game::FinishSearch() {
+    solverThread.join();
+    pathFinder->grid = grid.get();
+    searching = false;
+    if (!scoreSearch) {
+        std::vector<GridPos> path = std::move(solverResult);
+        solverResult.clear();
+        AdoptAnytimePath(path, pathFinder->lastStats.bound);
+        if (!anytimeAdopted) {
+            recorder.RecordAnytimeSolve(grid->currentTurn, 0);
+            std::cout << "No se encontró solución!" << std::endl;
+        } else {
+            std::cout << "Búsqueda terminada, cota " << pathFinder->lastStats.bound << std::endl;
+        }
+        return;
+    }
+    solutionPath = std::move(solverResult);
+    solverResult.clear();
+    recorder.RecordScoreSolve(grid->currentTurn, (int)solutionPath.size());
     
     if (!solutionPath.empty()) {
-        state = GameState::AUTO_SOLVING;
+        simState = GameState::AUTO_SOLVING;
         solutionStep = 0;
-        stepTimer = 0.0f;
+        solutionStepTicks = 0;
         std::cout << "Camino encontrado con " << solutionPath.size() << " pasos." << std::endl;
     } else {
         std::cout << "No se encontró solución!" << std::endl;
     }
 }
 
+// Reinicio, recarga o salida del nivel durante la búsqueda: no queda nada grabado de ese pedido
+void Game::CancelSearch() {
+    if (!solverThread.joinable()) {
+        return;
+    }
+    searchTrace.Cancel();
+    solverThread.join();
+    pathFinder->grid = grid.get();
+    searching = false;
+    solverResult.clear();
+    std::cout << "Búsqueda cancelada" << std::endl;
+}
+
+// Se llama una vez por tick lógico: un paso cada AUTO_SOLVE_STEP_TICKS, sin mirar el reloj del frame
 void Game::UpdateAutoSolve() {
-    stepTimer += GetFrameTime();
+    solutionStepTicks++;
     
-    if (stepTimer >= 0.5f && solutionStep < static_cast<int>(solutionPath.size())) {
-        Vector2 nextPos = solutionPath[solutionStep];
-        
-        if (player->HasVisited((int)nextPos.x, (int)nextPos.y)) {
-            player->ReduceScoreForBacktrack();
-        }
-        
-        player->MoveTo((int)nextPos.x, (int)nextPos.y);
-        player->AddToPath((int)nextPos.x, (int)nextPos.y);
-        grid->cells[(int)nextPos.y][(int)nextPos.x].isVisited = true;
-        
-        HexCell& cell = grid->cells[(int)nextPos.y][(int)nextPos.x];
-        if (cell.type == CellType::ITEM) {
-            player->items.push_back(nextPos);
-            cell.type = CellType::FREE;
-            player->score += 100;
-        }
+    if (solutionStepTicks >= AUTO_SOLVE_STEP_TICKS && solutionStep < static_cast<int>(solutionPath.size())) {
+        GridPos nextPos = solutionPath[solutionStep];
+        GridPos from = {player->x, player->y};
+        recorder.RecordSolverStep(grid->currentTurn, nextPos);
+        GameRules::ApplySolverStep(*grid, *player, nextPos);
+        grid->Update();
+        StartMoveAnimation(from);
         
         solutionStep++;
-        stepTimer = 0.0f;
-        grid->currentTurn++;
+        solutionStepTicks = 0;
         
         if (solutionStep >= static_cast<int>(solutionPath.size())) {
+            // Ya no sirve seguir mejorando: el hilo corta y FinishSearch lo junta
+            if (searching) searchTrace.Cancel();
             if (IsGameWon()) {
-                state = GameState::WIN;
+                simState = GameState::WIN;
             } else {
-                state = GameState::PLAYING;
+                simState = GameState::PLAYING;
+            }
+        }
+    }
+}
+
+// Arranca el hilo de simulación sobre el nivel actual; antes publica un snapshot para que el primer frame tenga qué dibujar
+void Game::StartSimulation() {
+    StopSimulation();
+    worldVersion++;
+    PublishSnapshot(std::chrono::steady_clock::now());
+    state = simState;
+    
+    simRunning.store(true, std::memory_order_release);
+    simThread = std::thread(&Game::SimulationLoop, this);
+}
+
+// Después del join el hilo principal vuelve a ser dueño del grid; los comandos que quedaron se aplican igual
+void Game::StopSimulation() {
+    if (!simThread.joinable()) {
+        return;
+    }
+    simRunning.store(false, std::memory_order_release);
+    simThread.join();
+    
+    SimCommand command;
+    while (commands.Pop(command)) {
+        ApplyCommand(command);
+    }
+    CancelSearch();
+}
+
+// Ticks a paso fijo con el reloj propio del hilo. En turbo cada tick de reloj corre turboTicks ticks lógicos,
+// mientras entren en TURBO_BUDGET_MS; el dibujo no espera nunca a la simulación, solo toma el último snapshot.
+void Game::SimulationLoop() {
+    using Clock = std::chrono::steady_clock;
+    const Clock::duration tickDuration = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(TICK_SECONDS));
+    const Clock::duration maxBehind = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(MAX_BEHIND_SECONDS));
+    const Clock::duration turboBudget = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double, std::milli>(TURBO_BUDGET_MS));
+    Clock::time_point nextTick = Clock::now() + tickDuration;
+    
+    while (simRunning.load(std::memory_order_acquire)) {
+        bool changed = false;
+        SimCommand command;
+        while (commands.Pop(command)) {
+            ApplyCommand(command);
+            changed = true;
+        }
+        
+        Clock::time_point now = Clock::now();
+        if (now - nextTick > maxBehind) {
+            nextTick = now;
+        }
+        
+        Clock::time_point lastTick = nextTick;
+        while (now >= nextTick) {
+            lastTick = nextTick;
+            Tick();
+            Clock::time_point budgetEnd = Clock::now() + turboBudget;
+            for (int i = 1; i < turboTicks; i++) {
+                Tick();
+                if (i % 16 == 0 && Clock::now() > budgetEnd) break;
             }
+            nextTick += tickDuration;
+            changed = true;
+        }
+        
+        if (changed) {
+            PublishSnapshot(lastTick);
         }
+        std::this_thread::sleep_until(nextTick);
+    }
+}
+
+// Un tick de lógica; no lee input ni el reloj, así que a igual cantidad de ticks da el mismo resultado
+void Game::Tick() {
+    tickCount++;
+    if (animationTicks < MOVE_ANIMATION_TICKS) {
+        animationTicks++;
+    }
+    
+    if (searching && !scoreSearch && anytimeVersion.load(std::memory_order_acquire) != adoptedVersion) {
+        std::vector<GridPos> path;
+        double bound;
+        {
+            std::lock_guard<std::mutex> lock(anytimeMutex);
+            path = anytimePath;
+            bound = anytimeBound;
+            adoptedVersion = anytimeVersion.load(std::memory_order_relaxed);
+        }
+        AdoptAnytimePath(path, bound);
+    }
+    if (searching && solverDone.load(std::memory_order_acquire)) {
+        FinishSearch();
+    }
+    if (simState == GameState::AUTO_SOLVING) {
+        UpdateAutoSolve();
+    }
+}
+
+// Cuánto ocupa la partida por subsistema. Corre en el hilo de simulación, que es el dueño del grid, del
+// jugador y del buffer de escritura; las estadísticas del solver solo se leen si no hay búsqueda corriendo.
+void Game::PrintMemoryReport() {
+    if (grid == nullptr || player == nullptr) return;
+
+    MemoryReport report;
+    report.Add("grid", sizeof(Grid) + grid->CellBytes());
+    report.Add("tablas de compuertas", grid->GateTableBytes());
+    report.Add("arenas del solver", searching ? 0 : pathFinder->lastStats.peakBytes);
+    report.Add("historial del jugador", sizeof(Player) + player->MemoryBytes());
+    if (timeToGoal != nullptr) report.Add("turnos a la meta", timeToGoal->MemoryBytes());
+
+    // Tres snapshots del tamaño del de escritura, más los arreglos por celda del mapa de calor
+    const RenderSnapshot& snapshot = snapshots.WriteBuffer();
+    size_t snapshotBytes = sizeof(RenderSnapshot) + snapshot.cells.capacity() * sizeof(HexCell) +
+                           (snapshot.playerPath.capacity() + snapshot.solutionPath.capacity()) * sizeof(GridPos);
+    report.Add("cachés de dibujo", 3 * snapshotBytes + SearchTrace::BytesFor(grid->width, grid->height));
+
+    std::cout << "Memoria de " << currentLevel << " (" << grid->width << "x" << grid->height << ", celda de "
+              << sizeof(HexCell) << " bytes):" << std::endl;
+    report.Print(std::cout);
+}
+
+// Copia al buffer de escritura lo que se dibuja; corre en el hilo de simulación (o con él parado)
+void Game::PublishSnapshot(std::chrono::steady_clock::time_point tickTime) {
+    RenderSnapshot& snapshot = snapshots.WriteBuffer();
+    snapshot.tick = tickCount;
+    snapshot.tickTime = tickTime;
+    snapshot.state = simState;
+    snapshot.turboTicks = turboTicks;
+    snapshot.lastResetMicros = lastResetMicros;
+    snapshot.searching = searching;
+    snapshot.searchId = searchId;
+    snapshot.searchBound = searchBound;
+    
+    // Las celdas solo cambian con el turno, así que casi todos los ticks el buffer ya tiene las de este turno.
+    // Si no, una sola copia (ya están fila por fila y ocupan 4 bytes) sobre la capacidad que ya había.
+    bool sameWorld = snapshot.worldVersion == worldVersion;
+    if (!sameWorld || snapshot.turn != grid->currentTurn) {
+        snapshot.cells.assign(grid->cells.begin(), grid->cells.end());
+    }
+    
+    snapshot.turn = grid->currentTurn;
+    snapshot.score = player->score;
+    snapshot.itemCount = (int)player->items.size();
+    snapshot.playerPos = {player->x, player->y};
+    snapshot.animationFrom = animationFrom;
+    snapshot.animationTicks = animationTicks;
+    // El historial solo crece entre reinicios: se decodifican nada más los pasos que este buffer no tiene
+    if (!sameWorld || (int)snapshot.playerPath.size() > player->path.Size()) {
+        snapshot.playerPath.clear();
+        player->path.ForEach([&](int, int px, int py) {
+            snapshot.playerPath.push_back({px, py});
+        });
     }
+    for (int i = (int)snapshot.playerPath.size(); i < player->path.Size(); i++) {
+        GridPos step;
+        player->path.GetPosition(i, step.x, step.y);
+        snapshot.playerPath.push_back(step);
+    }
+    snapshot.worldVersion = worldVersion;
+    snapshot.solutionPath = solutionPath;
+    
+    snapshot.turnsToGoal = -1;
+    snapshot.hasHint = false;
+    if (timeToGoal->Ready()) {
+        uint32_t turnsToGoal = timeToGoal->TurnsToGoal(player->x, player->y, grid->currentTurn);
+        snapshot.turnsToGoal = turnsToGoal == TimeToGoalTable::UNREACHABLE ? -1 : (int)turnsToGoal;
+        snapshot.hasHint = timeToGoal->BestMove(player->x, player->y, grid->currentTurn, snapshot.hint);
+    }
+    
+    snapshots.Publish();
+}
+
+void Game::SetTurbo(int ticksPerTick) {
+    int value = ticksPerTick > MAX_TURBO ? 1 : std::max(1, ticksPerTick);
+    if (simThread.joinable()) {
+        PostCommand({SimCommandType::SET_TURBO, value});
+    } else {
+        turboTicks = value;
+    }
+    std::cout << "Turbo: x" << value << std::endl;
+}
+
+void Game::StartMoveAnimation(GridPos from) {
+    animationFrom = from;
+    animationTicks = 0;
+}
+
+// Fracción del tick en curso según el reloj del dibujo, para interpolar entre snapshots
+float Game::InterpolationAlpha(const RenderSnapshot& view) {
+    float elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - view.tickTime).count();
+    return std::min(1.0f, std::max(0.0f, elapsed / TICK_SECONDS));
+}
+
+Vector2 Game::GetInterpolatedPlayerPosition(const RenderSnapshot& view) {
+    Vector2 to = grid->GetPlayerScreenPosition(view.playerPos.x, view.playerPos.y);
+    if (view.animationTicks >= MOVE_ANIMATION_TICKS) {
+        return to;
+    }
+    
+    Vector2 from = grid->GetPlayerScreenPosition(view.animationFrom.x, view.animationFrom.y);
+    float t = std::min(1.0f, (view.animationTicks + InterpolationAlpha(view)) / MOVE_ANIMATION_TICKS);
+    return {from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t};
 }
 
 void Game::Draw() {
+    // El snapshot más nuevo que haya publicado la simulación; si no hay uno nuevo se redibuja el anterior
+    if (simThread.joinable()) {
+        snapshots.Update();
+        searchTrace.Update();
+    }
+    RenderSnapshot& view = snapshots.ReadBuffer();
+    auto drawStart = std::chrono::steady_clock::now();
+    
     BeginDrawing();
     
     // Gradiente de fondo usando colores
@@ -265,54 +868,77 @@ void Game::Draw() {
         case GameState::PLAYING:
         case GameState::AUTO_SOLVING:
             if (grid != nullptr) {
-                DrawGameBackground();
-                DrawSidePanels();
-                grid->Draw();
+                DrawPlayfield(view);
                 
-                if (player != nullptr) {
-                    // Dibujar el jugador usando la posición exacta del grid
-                    Vector2 playerPos = grid->GetPlayerScreenPosition(player->x, player->y);
-                    DrawPlayerAtPosition(playerPos, grid->hexSize);
-                    
-                    // Dibuja el camino del jugador
-                    DrawPlayerPath();
-                }
-                
-                if (state == GameState::AUTO_SOLVING && !solutionPath.empty()) {
-                    for (int i = 0; i < static_cast<int>(solutionPath.size()) - 1; i++) {
-                        Vector2 from = grid->cells[(int)solutionPath[i].y][(int)solutionPath[i].x].screenPos;
-                        Vector2 to = grid->cells[(int)solutionPath[i+1].y][(int)solutionPath[i+1].x].screenPos;
+                if (view.state == GameState::AUTO_SOLVING && !view.solutionPath.empty()) {
+                    for (int i = 0; i < static_cast<int>(view.solutionPath.size()) - 1; i++) {
+                        Vector2 from = grid->GetPlayerScreenPosition(view.solutionPath[i].x, view.solutionPath[i].y);
+                        Vector2 to = grid->GetPlayerScreenPosition(view.solutionPath[i+1].x, view.solutionPath[i+1].y);
                         DrawLineEx(from, to, 4.0f, RED);
                     }
                 }
                 
-                DrawUI();
+                DrawUI(view);
             }
             break;
             
         case GameState::WIN:
             if (grid != nullptr) {
-                DrawGameBackground();
-                DrawSidePanels();
-                grid->Draw();
-                if (player != nullptr) {
-                    Vector2 playerPos = grid->GetPlayerScreenPosition(player->x, player->y);
-                    DrawPlayerAtPosition(playerPos, grid->hexSize);
-                    DrawPlayerPath();
-                }
-                DrawUI();
+                DrawPlayfield(view);
+                DrawUI(view);
             }
-            DrawWinScreen();
+            DrawWinScreen(view);
             break;
             
         case GameState::GAME_OVER:
-            DrawGameOverScreen();
+            if (grid != nullptr) {
+                DrawPlayfield(view);
+                DrawUI(view);
+            }
+            DrawGameOverScreen(view);
             break;
     }
     
+    // Lo que tardó armar el frame, sin la espera de EndDrawing; el frame completo es el anterior (GetFrameTime)
+    double drawMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - drawStart).count();
+    if (renderBudget.AddFrame(GetFrameTime() * 1000.0, drawMillis)) {
+        std::cout << "Detalle de dibujo: " << RenderBudget::DetailName(renderBudget.Detail()) << " (frame "
+                  << renderBudget.AverageFrameMillis() << " ms, dibujo " << renderBudget.AverageDrawMillis() << " ms)" << std::endl;
+    }
+    
     EndDrawing();
 }
 
+// Grid, jugador y camino desde el snapshot; el resaltado del mouse se marca solo en la copia
+void Game::DrawPlayfield(RenderSnapshot& view) {
+    DrawGameBackground();
+    DrawSidePanels();
+    
+    GridPos hoveredCell;
+    size_t hoveredIndex = view.cells.size();
+    if (view.state == GameState::PLAYING && grid->GetCellAt(GetMousePosition(), hoveredCell)) {
+        hoveredIndex = (size_t)hoveredCell.y * grid->width + hoveredCell.x;
+    }
+    if (hoveredIndex < view.cells.size()) view.cells[hoveredIndex].isHighlighted = true;
+    grid->Draw(view.cells, renderBudget.Detail());
+    if (hoveredIndex < view.cells.size()) view.cells[hoveredIndex].isHighlighted = false;
+    
+    if (showSearch && (view.searching || view.state == GameState::AUTO_SOLVING)) {
+        DrawSearchOverlay(view);
+    }
+    
+    if (showHint && view.state == GameState::PLAYING && view.hasHint) {
+        DrawHint(view);
+    }
+    
+    // Posición interpolada entre la celda anterior y la actual según el tick en curso
+    Vector2 playerPos = GetInterpolatedPlayerPosition(view);
+    DrawPlayerAtPosition(playerPos, grid->hexSize);
+    
+    // Dibuja el camino del jugador
+    DrawPlayerPath(view);
+}
+
 void Game::DrawTutorial() {
     int centerX = GetScreenWidth() / 2;
     int centerY = GetScreenHeight() / 2;
@@ -360,6 +986,18 @@ void Game::DrawTutorial() {
     
     DrawText("ESPACIO / ENTER / CLICK - Continuar al nivel", centerX - 180, GetScreenHeight() - 105, 16, WHITE);
     DrawText("ESC - Volver al menú", centerX - 70, GetScreenHeight() - 85, 14, LIGHTGRAY);
+    
+    // Estado de la carga en segundo plano
+    if (loadJob != nullptr) {
+        if (!loadJob->done.load(std::memory_order_acquire)) {
+            DrawText(startWhenLoaded ? "Cargando nivel, entrando en cuanto esté listo..." : "Cargando nivel...",
+                     centerX - 180, GetScreenHeight() - 145, 16, YELLOW);
+        } else if (loadJob->ok) {
+            DrawText(TextFormat("Nivel listo (%.1f ms)", loadJob->prepareMillis), centerX - 80, GetScreenHeight() - 145, 16, LIME);
+        } else {
+            DrawText("No se pudo cargar el nivel", centerX - 110, GetScreenHeight() - 145, 16, RED);
+        }
+    }
 }
 
 void Game::DrawTutorialElement(int x, int y, const char* title, const char* description, Color elementColor) {
@@ -538,13 +1176,21 @@ void Game::DrawHexagonTutorial(Vector2 center, float size, Color color) {
 
 void Game::DrawPlayerAtPosition(Vector2 pos, float hexSize) {
     // Animación de pulso
-    static float pulseTimer = 0.0f;
     pulseTimer += GetFrameTime() * 3.0f;
     float pulseScale = 1.0f + sinf(pulseTimer) * 0.1f;
     float radius = hexSize * 0.4f * pulseScale;
     
+    // Con poco detalle, un círculo liso (sin gradiente ni texto)
+    RenderDetail detail = renderBudget.Detail();
+    if (detail >= RenderDetail::NO_BORDERS) {
+        DrawCircle((int)pos.x, (int)pos.y, radius, ORANGE);
+        return;
+    }
+    
     // Sombra de juagdor
-    DrawCircle((int)(pos.x + 3), (int)(pos.y + 3), radius, GRAY);
+    if (detail == RenderDetail::FULL) {
+        DrawCircle((int)(pos.x + 3), (int)(pos.y + 3), radius, GRAY);
+    }
     
     // Círculo exterior 
     DrawCircle((int)pos.x, (int)pos.y, radius + 3, YELLOW);
@@ -559,22 +1205,41 @@ void Game::DrawPlayerAtPosition(Vector2 pos, float hexSize) {
     DrawText("D", (int)(pos.x - 6), (int)(pos.y - 8), 16, DARKBROWN);
 }
 
+// Anillo en la celda que sigue según la tabla de turnos a la meta
+void Game::DrawHint(const RenderSnapshot& view) {
+    Vector2 center = grid->GetPlayerScreenPosition(view.hint.x, view.hint.y);
+    float radius = grid->hexSize * 0.5f;
+    DrawCircleV(center, radius, CreateColor(0, 228, 48, 70));
+    DrawCircleLines((int)center.x, (int)center.y, radius, LIME);
+}
+
+// Mapa de calor de la última búsqueda, si es la del nivel y el pedido actuales
+void Game::DrawSearchOverlay(const RenderSnapshot& view) {
+    const SearchSnapshot& search = searchTrace.Latest();
+    if (search.searchId != view.searchId || search.width != grid->width || search.height != grid->height ||
+        search.cells.empty()) {
+        return;
+    }
+    grid->DrawSearchOverlay(search);
+}
+
 //Camino del jugador
-void Game::DrawPlayerPath() {
-    if (player->path.size() > 1) {
-        for (int i = 1; i < static_cast<int>(player->path.size()); i++) {
-            Vector2 from = grid->GetPlayerScreenPosition((int)player->path[i-1].x, (int)player->path[i-1].y);
-            Vector2 to = grid->GetPlayerScreenPosition((int)player->path[i].x, (int)player->path[i].y);
-            
-            // Sombra
+void Game::DrawPlayerPath(const RenderSnapshot& view) {
+    int pathSize = (int)view.playerPath.size();
+    for (int i = 1; i < pathSize; i++) {
+        Vector2 from = grid->GetPlayerScreenPosition(view.playerPath[i - 1].x, view.playerPath[i - 1].y);
+        Vector2 to = grid->GetPlayerScreenPosition(view.playerPath[i].x, view.playerPath[i].y);
+        
+        // Sombra
+        if (renderBudget.Detail() == RenderDetail::FULL) {
             DrawLineEx({from.x + 2, from.y + 2}, {to.x + 2, to.y + 2}, 3.0f, GRAY);
-            
-            Color lineColor = (i == static_cast<int>(player->path.size()) - 1) ? ORANGE : GOLD;
-            DrawLineEx(from, to, 2.0f, lineColor);
-            
-            if (i < static_cast<int>(player->path.size()) - 1) {
-                DrawCircle((int)to.x, (int)to.y, 2, ORANGE);
-            }
+        }
+        
+        Color lineColor = (i == pathSize - 1) ? ORANGE : GOLD;
+        DrawLineEx(from, to, 2.0f, lineColor);
+        
+        if (i < pathSize - 1) {
+            DrawCircle((int)to.x, (int)to.y, 2, ORANGE);
         }
     }
 }
@@ -621,9 +1286,14 @@ void Game::DrawMenu() {
 
     DrawText("Controles:", 80, 420, 24, GOLD);
     DrawText("• Click izquierdo: Mover a celda hexagonal", 100, 450, 18, LIGHTGRAY);
-    DrawText("• ESPACIO: Resolver automáticamente", 100, 475, 18, LIGHTGRAY);
+    DrawText("• ESPACIO: Resolver automáticamente (P: por puntaje)", 100, 475, 18, LIGHTGRAY);
     DrawText("• R: Reiniciar nivel", 100, 500, 18, LIGHTGRAY);
 
+    if (levelPack.IsOpen()) {
+        DrawPackMenu(centerX);
+        return;
+    }
+    
     Rectangle levelPanel = {(float)(centerX - 200), 550, 400, 120};
     DrawRectangleRounded(levelPanel, 0.02f, 8, DARKBLUE);
     DrawRectangleRoundedLines(levelPanel, 0.02f, 8, BLUE);
@@ -635,13 +1305,56 @@ void Game::DrawMenu() {
     DrawText("4 - NIGHTMARE", centerX - 10, centerY + 180, 20, MAROON);
 }
 
-void Game::DrawUI() {
+// Lista de niveles sacada solo del índice (nombre, tamaño y camino óptimo precalculado)
+void Game::DrawPackMenu(int centerX) {
+    int levelCount = (int)levelPack.LevelCount();
+    int pageCount = (levelCount + LEVELS_PER_PAGE - 1) / LEVELS_PER_PAGE;
+    int first = menuPage * LEVELS_PER_PAGE;
+    int shown = std::min(LEVELS_PER_PAGE, levelCount - first);
+    const Color levelColors[] = {GREEN, YELLOW, RED, MAROON};
+    
+    Rectangle levelPanel = {(float)(centerX - 260), 550, 520, (float)(80 + shown * 24)};
+    DrawRectangleRounded(levelPanel, 0.02f, 8, DARKBLUE);
+    DrawRectangleRoundedLines(levelPanel, 0.02f, 8, BLUE);
+    
+    DrawText("Selecciona un nivel:", centerX - 100, 565, 20, WHITE);
+    for (int i = 0; i < shown; i++) {
+        const EtgpEntry& entry = levelPack.Entry(first + i);
+        std::string name(levelPack.Name(first + i));
+        int rowY = 595 + i * 24;
+        
+        DrawText(TextFormat("%d - %s", i + 1, name.c_str()), centerX - 240, rowY, 18, levelColors[(first + i) % 4]);
+        if (entry.optimalMoves == ETGP_NO_SOLUTION) {
+            DrawText(TextFormat("%dx%d, sin solución", entry.width, entry.height), centerX + 60, rowY + 2, 16, LIGHTGRAY);
+        } else {
+            DrawText(TextFormat("%dx%d, óptimo %d", entry.width, entry.height, entry.optimalMoves), centerX + 60, rowY + 2, 16, LIGHTGRAY);
+        }
+    }
+    
+    if (pageCount > 1) {
+        DrawText(TextFormat("Página %d/%d  (flechas para cambiar)", menuPage + 1, pageCount),
+                 centerX - 150, 600 + shown * 24, 16, SKYBLUE);
+    }
+}
+
+void Game::DrawUI(const RenderSnapshot& view) {
     if (player != nullptr) {
         DrawText("INFORMACIÓN", 40, 40, 18, GOLD);
-        DrawText(TextFormat("Turno: %d", grid->currentTurn), 40, 70, 16, WHITE);
-        DrawText(TextFormat("Puntuación: %d", player->score), 40, 95, 16, LIME);
-        DrawText(TextFormat("Items: %d", (int)player->items.size()), 40, 120, 16, GOLD);
-        DrawText(TextFormat("Posición: (%d, %d)", player->x, player->y), 40, 145, 16, SKYBLUE);
+        DrawText(TextFormat("Turno: %d", view.turn), 40, 70, 16, WHITE);
+        DrawText(TextFormat("Puntuación: %d", view.score), 40, 95, 16, LIME);
+        DrawText(TextFormat("Items: %d", view.itemCount), 40, 120, 16, GOLD);
+        DrawText(TextFormat("Posición: (%d, %d)", view.playerPos.x, view.playerPos.y), 40, 145, 16, SKYBLUE);
+        if (view.lastResetMicros >= 0.0) {
+            DrawText(TextFormat("Reinicio: %.1f us", view.lastResetMicros), 40, 170, 14, LIGHTGRAY);
+        }
+        if (view.turnsToGoal >= 0) {
+            DrawText(TextFormat("Faltan: %d turnos", view.turnsToGoal), 40, 195, 16, WHITE);
+        } else {
+            DrawText("Sin salida", 40, 195, 16, RED);
+        }
+        DrawText(TextFormat("Detalle: %s", RenderBudget::DetailName(renderBudget.Detail())), 40, 225, 14,
+                 renderBudget.Detail() == RenderDetail::FULL ? LIGHTGRAY : ORANGE);
+        DrawText(TextFormat("Dibujo: %.1f ms", renderBudget.AverageDrawMillis()), 40, 242, 14, LIGHTGRAY);
         
         float rightX = GetScreenWidth() - 200.0f;
         DrawText("CONTROLES", (int)rightX + 20, 40, 18, GOLD);
@@ -649,14 +1362,26 @@ void Game::DrawUI() {
         DrawText("Auto-resolver", (int)rightX + 20, 85, 12, GRAY);
         DrawText("R: Reiniciar", (int)rightX + 20, 110, 14, LIGHTGRAY);
         DrawText("ESC: Menú", (int)rightX + 20, 130, 14, LIGHTGRAY);
+        DrawText(TextFormat("TAB: Turbo x%d", view.turboTicks), (int)rightX + 20, 145, 14, view.turboTicks > 1 ? ORANGE : LIGHTGRAY);
+
+        DrawText(TextFormat("H: Búsqueda %s", showSearch ? "visible" : "oculta"), (int)rightX + 20, 160, 14, LIGHTGRAY);
+        DrawText(TextFormat("G: Pista %s", showHint ? "visible" : "oculta"), (int)rightX + 20, 175, 14, LIGHTGRAY);
+        DrawText("M: Memoria (consola)", (int)rightX + 20, 190, 14, LIGHTGRAY);
+        DrawText("P: Resolver por puntaje", (int)rightX + 20, 205, 14, LIGHTGRAY);
 
-        if (state == GameState::AUTO_SOLVING) {
-            DrawText("RESOLVIENDO...", (int)rightX + 20, 160, 14, RED);
+        if (view.searching && view.state == GameState::AUTO_SOLVING) {
+            DrawText(TextFormat("MEJORANDO... cota x%.2f", view.searchBound), (int)rightX + 20, 230, 14, ORANGE);
+        } else if (view.searching) {
+            const SearchSnapshot& search = searchTrace.Latest();
+            int expansions = search.searchId == view.searchId ? search.expansions : 0;
+            DrawText(TextFormat("BUSCANDO... %d exp.", expansions), (int)rightX + 20, 230, 14, ORANGE);
+        } else if (view.state == GameState::AUTO_SOLVING) {
+            DrawText("RESOLVIENDO...", (int)rightX + 20, 230, 14, RED);
         }
     }
 }
 // Pantalla de victoria
-void Game::DrawWinScreen() {
+void Game::DrawWinScreen(const RenderSnapshot& view) {
     DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), CreateColor(0, 0, 0, 180));
 
     int centerX = GetScreenWidth() / 2;
@@ -667,29 +1392,106 @@ void Game::DrawWinScreen() {
     DrawRectangleRoundedLines(winPanel, 0.05f, 8, LIME);
 
     DrawText("¡VICTORIA!", centerX - 120, centerY - 60, 48, LIME);
-    DrawText(TextFormat("Puntuación Final: %d", player->score), centerX - 100, centerY - 10, 20, WHITE);
+    DrawText(TextFormat("Puntuación Final: %d", view.score), centerX - 100, centerY - 10, 20, WHITE);
     DrawText("R: Reiniciar | ESC: Menú", centerX - 100, centerY + 30, 16, LIGHTGRAY);
 }
 
 
-// Pantalla de Game Over
-void Game::DrawGameOverScreen() {
+// Pantalla de Game Over, cuando desde la celda y el turno actuales ya no se llega a la meta
+void Game::DrawGameOverScreen(const RenderSnapshot& view) {
     DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), CreateColor(0, 0, 0, 180));
     
     int centerX = GetScreenWidth() / 2;
     int centerY = GetScreenHeight() / 2;
     
-    DrawText("GAME OVER", centerX - 150, centerY - 30, 48, RED);
+    DrawText("GAME OVER", centerX - 150, centerY - 60, 48, RED);
+    DrawText(TextFormat("Sin salida en el turno %d", view.turn), centerX - 110, centerY, 20, WHITE);
     DrawText("R: Reiniciar | ESC: Menú", centerX - 100, centerY + 30, 20, LIGHTGRAY);
 }
 
+// Partida sin ganar desde la que ningún camino llega a la meta (consulta O(1) a la tabla)
+bool Game::IsDeadState() const {
+    if (player == nullptr || grid == nullptr || timeToGoal == nullptr || !timeToGoal->Ready() ||
+        GameRules::IsWon(*grid, *player)) {
+        return false;
+    }
+    return !timeToGoal->CanReachGoal(player->x, player->y, grid->currentTurn);
+}
+
 bool Game::IsGameWon() {
     if (player == nullptr || grid == nullptr) return false;
-    return (player->x == (int)grid->goalPos.x && player->y == (int)grid->goalPos.y);
+    return GameRules::IsWon(*grid, *player);
 }
 
+// Reinicio en sitio: solo se restaura el estado mutable, el nivel ya cargado se reutiliza
 void Game::Reset() {
-    if (grid != nullptr && !currentLevel.empty()) {
-        LoadLevel(currentLevel);
+    if (grid == nullptr || player == nullptr || currentLevel.empty()) {
+        return;
+    }
+    
+    auto startTime = std::chrono::steady_clock::now();
+    
+    CancelSearch();
+    grid->ResetState();
+    player->Reset(grid->startPos.x, grid->startPos.y);
+    worldVersion++;
+    if (recorder.IsActive()) {
+        recorder.RecordReset();
+    } else {
+        BeginRecording();
     }
-}
\ No newline at end of file
+    solutionPath.clear();
+    solutionStep = 0;
+    solutionStepTicks = 0;
+    animationTicks = MOVE_ANIMATION_TICKS;
+    simState = GameState::PLAYING;
+    
+    auto endTime = std::chrono::steady_clock::now();
+    lastResetMicros = std::chrono::duration<double, std::micro>(endTime - startTime).count();
+    std::cout << "Nivel reiniciado en " << lastResetMicros << " us" << std::endl;
+}
+
+void Game::EnableRecording(const std::string& directory) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    recordDirectory = directory;
+    std::cout << "Grabando partidas en " << directory << std::endl;
+}
+
+// Empieza a grabar desde el estado inicial del nivel (el de debug no tiene LevelData y no se graba)
+void Game::BeginRecording() {
+    if (recordDirectory.empty() || levelData == nullptr) {
+        return;
+    }
+    recorder.Begin(currentLevel, *levelData);
+}
+
+void Game::FinishRecording() {
+    if (!recorder.IsActive() || grid == nullptr || player == nullptr) {
+        return;
+    }
+    
+    // <fecha>_<n>_<nivel>.etgr; los niveles del paquete quedan como "pack3"
+    char stamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", std::localtime(&now));
+    std::string levelName = std::filesystem::path(currentLevel).stem().string();
+    levelName.erase(std::remove(levelName.begin(), levelName.end(), ':'), levelName.end());
+    
+    std::string filename = recordDirectory + "/" + stamp + "_" + std::to_string(recordedSessions++) + "_" + levelName + ".etgr";
+    recorder.Finish(*grid, *player, SessionState(), filename);
+}
+
+// Estado de la partida tal como lo reconstruye el replayer: el de Game ya puede ser MENU al cerrar
+GameState Game::SessionState() const {
+    if (player != nullptr && grid != nullptr && GameRules::IsWon(*grid, *player)) {
+        return GameState::WIN;
+    }
+    if (!solutionPath.empty() && solutionStep < static_cast<int>(solutionPath.size())) {
+        return GameState::AUTO_SOLVING;
+    }
+    if (simState == GameState::GAME_OVER) {
+        return GameState::GAME_OVER;
+    }
+    return GameState::PLAYING;
+}
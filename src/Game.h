@@ -1,56 +1,227 @@
 // Game.h
 #pragma once
+#include "GameRules.h"
 #include "Grid.h"
 #include "Player.h"
 #include "PathFinder.h"
+#include "RenderBudget.h"
+#include "SearchTrace.h"
+#include "FileLoader.h"
+#include "ItemRoutePlanner.h"
+#include "LevelPack.h"
+#include "LevelWatcher.h"
+#include "SessionRecording.h"
+#include "SimulationChannels.h"
+#include "TimeToGoalTable.h"
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
-enum class GameState {
-    MENU,
-    TUTORIAL,       
-    PLAYING,
-    AUTO_SOLVING,
-    GAME_OVER,
-    WIN
+// Nivel preparado fuera del hilo principal. El trabajador solo escribe aquí y publica con 'done';
+// el hilo principal lo lee recién cuando ve done == true.
+struct LevelLoadJob {
+    std::string key;
+    std::shared_ptr<const LevelData> data;        // Si viene de la caché, el trabajador no toca el disco
+    std::unique_ptr<Grid> grid;
+    std::unique_ptr<Player> player;
+    std::unique_ptr<PathFinder> pathFinder;
+    std::unique_ptr<TimeToGoalTable> timeToGoal;
+    bool ok = false;
+    double prepareMillis = 0.0;
+    std::atomic<bool> done{false};
+    std::atomic<bool> cancelled{false};           // El parser lo mira mientras lee, no solo al terminar
+};
+
+// Carga cancelada cuyo hilo todavía no terminó: se junta cuando marca done, sin frenar el frame
+struct RetiredLoader {
+    std::thread thread;
+    std::shared_ptr<LevelLoadJob> job;
+};
+
+// Todo lo que el dibujo necesita de un tick. Lo llena el hilo de simulación y el de dibujo solo lo lee;
+// los vectores se reasignan sobre la capacidad que ya tenían, así que después del primer tick no se reserva memoria.
+struct RenderSnapshot {
+    long long tick = 0;
+    std::chrono::steady_clock::time_point tickTime;   // Cuándo tocaba ese tick, para interpolar
+    GameState state = GameState::PLAYING;
+    std::vector<HexCell> cells;         // Fila por fila, width * height
+    int worldVersion = -1;              // Game::worldVersion con el que se copiaron cells y playerPath
+    int turn = 0;
+    int score = 0;
+    int itemCount = 0;
+    GridPos playerPos = {0, 0};
+    GridPos animationFrom = {0, 0};
+    int animationTicks = 0;
+    std::vector<GridPos> playerPath;
+    std::vector<GridPos> solutionPath;
+    int turboTicks = 1;
+    double lastResetMicros = -1.0;
+    bool searching = false;             // El auto-solve está buscando en el hilo del solver
+    int searchId = 0;                   // Búsqueda a la que corresponde el mapa de calor
+    double searchBound = 0.0;           // Cota del anytime: el camino mide a lo sumo esto por el óptimo (0 = sin camino)
+    int turnsToGoal = -1;               // Mínimo de turnos que faltan (-1 = ya no se puede ganar)
+    bool hasHint = false;
+    GridPos hint = {0, 0};              // Próxima celda de un camino óptimo
+};
+
+// Lo que el hilo de dibujo le pide a la simulación; se aplica al principio del siguiente tick
+enum class SimCommandType {
+    CLICK,
+    RESET,
+    AUTO_SOLVE,
+    SCORE_SOLVE,                        // Auto-solve por puntaje: ruta con items (ItemRoutePlanner) en vez del A*
+    SET_TURBO,
+    MEMORY_REPORT                       // Imprime por consola cuánto ocupa cada subsistema
+};
+
+struct SimCommand {
+    SimCommandType type;
+    int x = 0, y = 0;                   // CLICK: celda; SET_TURBO: x = ticks por tick
 };
 
 class Game {
 public:
-    Grid* grid;
-    Player* player;
-    PathFinder* pathFinder;
+    // Del nivel cargado; se reemplazan juntos en AdoptLevel (pathFinder apunta a grid)
+    std::unique_ptr<Grid> grid;
+    std::unique_ptr<Player> player;
+    std::unique_ptr<PathFinder> pathFinder;
+    std::unique_ptr<TimeToGoalTable> timeToGoal;  // Turnos a la meta por (celda, turno), se arma al cargar
     GameState state;
     std::string currentLevel;
     std::string pendingLevel;  
+    std::shared_ptr<const LevelData> levelData;   // Nivel ya parseado, inmutable y compartido
+    double lastResetMicros;                       // Latencia del último reinicio (-1 si no hubo)
+    LevelPack levelPack;                          // Índice de niveles del menú (si existe el .etgp)
+    int menuPage;
+    LevelWatcher levelWatcher;                    // Recarga en caliente (opcional, --hot-reload)
+    bool hotReload;
+    SessionRecorder recorder;                     // Grabación de partidas (opcional, --record <carpeta>)
+    std::string recordDirectory;
     
     
-    std::vector<Vector2> solutionPath;
+    // Mientras corre el hilo de simulación, grid, player, solutionPath y todo lo de abajo son suyos;
+    // el hilo principal solo lee el snapshot y manda comandos. Se tocan desde afuera con la simulación parada.
+    std::vector<GridPos> solutionPath;
     int solutionStep;
-    float stepTimer;
+    int solutionStepTicks;      // Ticks desde el último paso del auto-solve
+    GameState simState;         // Estado según la simulación; 'state' lo copia del snapshot
+    bool searching;             // Hay una búsqueda corriendo en solverThread; mientras tanto se ignoran los clicks
+    bool scoreSearch;           // La búsqueda en curso es la ruta por puntaje (se graba distinto)
+    int searchId;
+    double searchBound;
+    
+    // Simulación a paso fijo: la lógica avanza en ticks de TICK_SECONDS, independiente de los FPS del dibujo
+    static constexpr float TICK_SECONDS = 1.0f / 60.0f;
+    static constexpr int AUTO_SOLVE_STEP_TICKS = 30;    // Medio segundo por paso
+    static constexpr int MOVE_ANIMATION_TICKS = 8;      // Lo que tarda el jugador en deslizarse a la celda nueva
+    static constexpr int MAX_TURBO = 256;
+    long long tickCount;
+    int turboTicks;             // Ticks lógicos por cada tick de reloj (1 = velocidad normal)
     
     Game();
     ~Game();
     
     void Initialize();
+    void EnableHotReload() { hotReload = true; }
+    void EnableRecording(const std::string& directory);
+    void SetTurbo(int ticksPerTick);
     void LoadLevel(const std::string& filename);
     void Update();
+    void Tick();
     void Draw();
-    void HandleMouseInput();
-    void StartAutoSolve();
+    void HandleMouseInput(const RenderSnapshot& view);
+    void StartAutoSolve(bool maximizeScore = false);
     void UpdateAutoSolve();
     void Reset();
     void ShowTutorial(const std::string& levelToLoad);  
     
 private:
-    void DrawUI();
+    static constexpr const char* LEVEL_PACK_FILE = "assets/levels/levels.etgp";
+    static constexpr const char* PACK_KEY_PREFIX = "pack:";
+    static constexpr int LEVELS_PER_PAGE = 8;
+    
+    std::map<std::string, std::shared_ptr<const LevelData>> levelCache;
+    std::shared_ptr<LevelLoadJob> loadJob;       // Carga en curso para pendingLevel (nullptr si no hay)
+    std::thread loaderThread;
+    std::shared_ptr<LevelLoadJob> loaderJob;     // El de loaderThread, aunque se haya cancelado
+    std::vector<RetiredLoader> retiredLoaders;
+    bool startWhenLoaded;                        // El jugador ya pidió entrar y se espera al trabajador
+    int recordedSessions;                        // Para no pisar archivos grabados en el mismo segundo
+    
+    static constexpr float MAX_BEHIND_SECONDS = 0.25f;   // Si la simulación se atrasa más, no recupera de golpe
+    static constexpr double TURBO_BUDGET_MS = 8.0;       // Tope de ticks extra por tick de reloj en turbo
+    // Sube al arrancar la simulación y al reiniciar: el grid o el historial cambiaron sin que cambie el turno
+    int worldVersion;
+    GridPos animationFrom;                       // Celda desde la que se desliza el jugador
+    int animationTicks;
+    
+    std::thread simThread;
+    std::atomic<bool> simRunning;
+    TripleBuffer<RenderSnapshot> snapshots;
+    CommandQueue<SimCommand, 64> commands;
+    
+    // Auto-solve en segundo plano: el A* corre sobre una copia del grid y publica su progreso en searchTrace
+    std::thread solverThread;
+    std::unique_ptr<Grid> solverGrid;
+    std::vector<GridPos> solverResult;
+    std::atomic<bool> solverDone;
+    SearchTrace searchTrace;
+    // ESPACIO corre el anytime: cada mejora queda acá y Tick la toma apenas cambia la versión
+    std::mutex anytimeMutex;
+    std::vector<GridPos> anytimePath;
+    double anytimeBound;
+    std::atomic<int> anytimeVersion;
+    int adoptedVersion;
+    bool anytimeAdopted;                         // El auto-solve ya arrancó con algún camino de esta búsqueda
+    bool showSearch;                             // H: mostrar u ocultar el mapa de calor
+    bool showHint;                               // G: marcar la próxima celda del camino óptimo
+    RenderBudget renderBudget;                   // Nivel de detalle según lo que tarda cada frame
+    float pulseTimer;                            // Pulso del jugador; solo lo avanza el dibujo
+    
+    std::shared_ptr<LevelLoadJob> CreateLoadJob(const std::string& filename);
+    static void PrepareLevel(LevelLoadJob& job, const LevelPack& pack);
+    void StartBackgroundLoad(const std::string& filename);
+    void CancelBackgroundLoad();
+    void JoinFinishedLoaders();
+    void AdoptLevel(LevelLoadJob& job);
+    void ApplyHotReload();
+    void StartSimulation();
+    void StopSimulation();
+    void SimulationLoop();
+    void ApplyCommand(const SimCommand& command);
+    void ApplyClick(int x, int y);
+    void PublishSnapshot(std::chrono::steady_clock::time_point tickTime);
+    void PrintMemoryReport();
+    void PostCommand(const SimCommand& command);
+    void FinishSearch();
+    void AdoptAnytimePath(std::vector<GridPos>& path, double bound);
+    void CancelSearch();
+    static float InterpolationAlpha(const RenderSnapshot& view);
+    void StartMoveAnimation(GridPos from);
+    Vector2 GetInterpolatedPlayerPosition(const RenderSnapshot& view);
+    void BeginRecording();
+    void FinishRecording();
+    GameState SessionState() const;
+    bool IsDeadState() const;
+    void UpdatePackMenu();
+    void DrawPackMenu(int centerX);
+    void DrawPlayfield(RenderSnapshot& view);
+    void DrawSearchOverlay(const RenderSnapshot& view);
+    void DrawUI(const RenderSnapshot& view);
     void DrawMenu();
     void DrawTutorial();            
     void DrawGameBackground();
     void DrawSidePanels();
-    void DrawWinScreen();
-    void DrawGameOverScreen();
+    void DrawWinScreen(const RenderSnapshot& view);
+    void DrawGameOverScreen(const RenderSnapshot& view);
+    void DrawHint(const RenderSnapshot& view);
     void DrawPlayerAtPosition(Vector2 pos, float hexSize);
-    void DrawPlayerPath();
+    void DrawPlayerPath(const RenderSnapshot& view);
     void DrawTutorialElement(int x, int y, const char* title, const char* description, Color elementColor);
     void DrawHexagonTutorial(Vector2 center, float size, Color color);  
     bool IsGameWon();
@@ -0,0 +1,90 @@
+// GameRules.cpp, la lógica de movimiento que antes vivía repetida en HandleMouseInput y UpdateAutoSolve
+#include "GameRules.h"
+#include "LevelBinary.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+void AppendInt(std::vector<unsigned char>& out, int32_t value) {
+    unsigned char bytes[4];
+    std::memcpy(bytes, &value, sizeof(bytes));
+    out.insert(out.end(), bytes, bytes + sizeof(bytes));
+}
+
+void AppendString(std::vector<unsigned char>& out, const std::string& text) {
+    AppendInt(out, (int32_t)text.size());
+    out.insert(out.end(), text.begin(), text.end());
+}
+
+} // namespace
+
+bool GameRules::ApplyPlayerMove(Grid& grid, Player& player, int toX, int toY) {
+    if (!grid.IsValidMove(player.x, player.y, toX, toY)) {
+        return false;
+    }
+    EnterCell(grid, player, toX, toY);
+    return true;
+}
+
+void GameRules::ApplySolverStep(Grid& grid, Player& player, GridPos next) {
+    EnterCell(grid, player, next.x, next.y);
+}
+
+bool GameRules::IsWon(const Grid& grid, const Player& player) {
+    return player.x == grid.goalPos.x && player.y == grid.goalPos.y;
+}
+
+void GameRules::EnterCell(Grid& grid, Player& player, int x, int y) {
+    if (player.HasVisited(x, y)) {
+        player.ReduceScoreForBacktrack();
+    }
+
+    player.MoveTo(x, y);
+    player.AddToPath(x, y);
+
+    HexCell& cell = grid.CellAt(x, y);
+    cell.isVisited = true;
+    if (cell.type == CellType::ITEM) {
+        player.items.push_back({x, y});
+        cell.type = CellType::FREE;
+        player.score += ITEM_SCORE;
+    }
+
+    grid.currentTurn++;
+}
+
+uint64_t GameRules::LevelFingerprint(const LevelData& levelData) {
+    std::vector<unsigned char> bytes;
+    bytes.reserve(levelData.cells.size() + 256);
+
+    AppendInt(bytes, levelData.width);
+    AppendInt(bytes, levelData.height);
+    AppendInt(bytes, levelData.startX);
+    AppendInt(bytes, levelData.startY);
+    AppendInt(bytes, levelData.goalX);
+    AppendInt(bytes, levelData.goalY);
+    AppendInt(bytes, levelData.turnCycleLength);
+    bytes.insert(bytes.end(), levelData.cells.begin(), levelData.cells.end());
+
+    for (const auto& item : levelData.items) {
+        AppendInt(bytes, item.first);
+        AppendInt(bytes, item.second);
+    }
+    for (const auto& pattern : levelData.gatePatterns) {
+        AppendString(bytes, pattern.first);
+        AppendInt(bytes, (int32_t)pattern.second.size());
+        for (bool open : pattern.second) bytes.push_back(open ? 1 : 0);
+    }
+    for (const GateAssignment& gate : levelData.gateAssignments) {
+        AppendInt(bytes, gate.x);
+        AppendInt(bytes, gate.y);
+        AppendString(bytes, gate.pattern);
+    }
+    for (const TemporalWall& wall : levelData.temporalWalls) {
+        AppendInt(bytes, wall.x);
+        AppendInt(bytes, wall.y);
+        AppendInt(bytes, wall.turns);
+    }
+    return LevelBinary::Checksum(bytes.data(), bytes.size());
+}
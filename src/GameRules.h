@@ -0,0 +1,37 @@
+// GameRules.h, reglas de la partida sin raylib ni reloj: qué pasa al pisar una celda con el mouse o con el
+// auto-solve. Game las usa cuadro a cuadro y el replayer headless las corre a toda velocidad.
+#pragma once
+#include "FileLoader.h"
+#include "Grid.h"
+#include "GridPos.h"
+#include "Player.h"
+#include <cstdint>
+
+enum class GameState {
+    MENU,
+    TUTORIAL,
+    PLAYING,
+    AUTO_SOLVING,
+    GAME_OVER,
+    WIN
+};
+
+class GameRules {
+public:
+    static const int ITEM_SCORE = 100;
+
+    // Click sobre una celda (HandleMouseInput): false si el movimiento no es válido y no pasa nada
+    static bool ApplyPlayerMove(Grid& grid, Player& player, int toX, int toY);
+
+    // Un paso del auto-solve (UpdateAutoSolve): no se valida, el camino ya viene del solver
+    static void ApplySolverStep(Grid& grid, Player& player, GridPos next);
+
+    static bool IsWon(const Grid& grid, const Player& player);
+
+    // FNV-1a 64 del contenido del nivel, para que una grabación no se reproduzca contra otro nivel
+    static uint64_t LevelFingerprint(const LevelData& levelData);
+
+private:
+    // Lo común a los dos: penalización por volver, camino, item y avance de turno
+    static void EnterCell(Grid& grid, Player& player, int x, int y);
+};
@@ -1,135 +1,67 @@
 // Grid.cpp, este implementa la lógica del grid y las celdas
 #include "Grid.h"
 #include "FileLoader.h"
+#include "HexDirections.h"
+#include "LevelWatcher.h"
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 
-Grid::Grid(int w, int h) : width(w), height(h), currentTurn(0), hexSize(25.0f), turnCycleLength(8) {
-    cells.clear();
-    cells.reserve(height);
-    
-    for (int y = 0; y < height; y++) {
-        std::vector<HexCell> row;
-        row.reserve(width);
-        
-        for (int x = 0; x < width; x++) {
-            row.emplace_back(x, y, CellType::FREE);
-        }
-        
-        cells.push_back(std::move(row));
-    }
-}
-
-Vector2 Grid::GetMapOffset() {
-    // offset para centrar el mapa en la pantalla
-    float panelWidth = 250.0f; // Ancho de cada panel lateral
-    float availableWidth = GetScreenWidth() - (panelWidth * 2);
-    float availableHeight = GetScreenHeight() - 100.0f;
-    
-    // tamaño aproximado del mapa
-    float hexWidth = hexSize * 2.0f;
-    float hexHeight = sqrtf(3.0f) * hexSize;
-    
-    float mapWidth = hexWidth * 0.75f * width + hexSize;
-    float mapHeight = hexHeight * height;
-    
-    float offsetX = panelWidth + (availableWidth - mapWidth) / 2.0f;
-    float offsetY = 50.0f + (availableHeight - mapHeight) / 2.0f;
-    
-    return {offsetX, offsetY};
-}
-
-Vector2 Grid::GetPlayerScreenPosition(int gridX, int gridY) {
-    Vector2 offset = GetMapOffset();
-    return HexToScreen(gridX, gridY, offset);
+Grid::Grid(int w, int h) : width(w), height(h), currentTurn(0), hexSize(25.0f), turnCycleLength(8), goalDistance(nullptr), adjacency(nullptr),
+                           changeFlashTimer(0.0f) {
+    cells.assign((size_t)width * height, HexCell(CellType::FREE));
 }
 
-std::vector<Vector2> Grid::GetNeighbors(int x, int y) {
-    std::vector<Vector2> neighbors;
-    
-    int evenCol[6][2] = {{0, -1}, {1, -1}, {1, 0}, {0, 1}, {-1, 0}, {-1, -1}};
-    int oddCol[6][2] = {{0, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}};
+std::vector<GridPos> Grid::GetNeighbors(int x, int y) {
+    std::vector<GridPos> neighbors;
     
-    int (*offsets)[2] = (x % 2 == 0) ? evenCol : oddCol;
+    const int (*offsets)[2] = HexOffsetsForColumn(x);
     
     for (int i = 0; i < 6; i++) {
         int nx = x + offsets[i][0];
         int ny = y + offsets[i][1];
         
         if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-            neighbors.push_back({(float)nx, (float)ny});
+            neighbors.push_back({nx, ny});
         }
     }
     
     return neighbors;
 }
 
-void Grid::Update() {
-    UpdateGatesAndWalls();
-}
-
-void Grid::UpdateGatesAndWalls() {
-    int cyclePosition = currentTurn % turnCycleLength;
-    
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            HexCell& cell = cells[y][x];
-            
-            if (cell.type == CellType::GATE) {
-                if (gatePatterns.count(cell.gatePattern) > 0) {
-                    std::vector<bool>& pattern = gatePatterns[cell.gatePattern];
-                    if (cyclePosition < static_cast<int>(pattern.size())) {
-                        cell.isCurrentlyOpen = pattern[cyclePosition];
-                    }
-                }
-            } else if (cell.type == CellType::TEMPORAL_WALL) {
-                cell.isCurrentlyOpen = (currentTurn >= cell.turnsToOpen);
-            }
-        }
+uint8_t Grid::NeighborMask(int x, int y) const {
+    if (adjacency != nullptr) {
+        return adjacency[(size_t)y * width + x];
     }
-}
-
-void Grid::Draw() {
-    // offset de centrado del mapa
-    Vector2 mapOffset = GetMapOffset();
-    
-    // Dibujar todas las celdas
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            // Actualizar posición de pantalla
-            cells[y][x].screenPos = HexToScreen(x, y, mapOffset);
-            // Dibujar la celda
-            cells[y][x].Draw(hexSize);
+    const int (*offsets)[2] = HexOffsetsForColumn(x);
+    uint8_t mask = 0;
+    for (int i = 0; i < 6; i++) {
+        int nx = x + offsets[i][0];
+        int ny = y + offsets[i][1];
+        if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
+            mask |= (uint8_t)(1 << i);
         }
     }
-    
-    
-}
-
-Vector2 Grid::HexToScreen(int x, int y, Vector2 offset) {
-    float hexWidth = hexSize * 2.0f;
-    float hexHeight = sqrtf(3.0f) * hexSize;
-    
-    float screenX = hexWidth * 0.75f * x;
-    float screenY = hexHeight * (y + 0.5f * (x & 1));
-    
-    return {screenX + offset.x, screenY + offset.y};
+    return mask;
 }
 
-Vector2 Grid::HexToScreen(int x, int y) {
-    Vector2 offset = GetMapOffset();
-    return HexToScreen(x, y, offset);
+void Grid::Update() {
+    UpdateGatesAndWalls();
 }
 
-HexCell* Grid::GetCellAt(Vector2 mousePos) {
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            if (cells[y][x].IsPointInside(mousePos, hexSize)) {
-                return &cells[y][x];
+void Grid::UpdateGatesAndWalls() {
+    int cyclePosition = currentTurn % turnCycleLength;
+    
+    for (HexCell& cell : cells) {
+        if (cell.type == CellType::GATE) {
+            const GatePattern& pattern = GatePatternOf(cell);
+            if (pattern.defined && cyclePosition < static_cast<int>(pattern.phases.size())) {
+                cell.isCurrentlyOpen = pattern.phases[cyclePosition];
             }
+        } else if (cell.type == CellType::TEMPORAL_WALL) {
+            cell.isCurrentlyOpen = (currentTurn >= cell.TurnsToOpen());
         }
     }
-    return nullptr;
 }
 
 bool Grid::IsValidMove(int fromX, int fromY, int toX, int toY) {
@@ -137,7 +69,7 @@ bool Grid::IsValidMove(int fromX, int fromY, int toX, int toY) {
         return false;
     }
     
-    HexCell& targetCell = cells[toY][toX];
+    const HexCell& targetCell = CellAt(toX, toY);
     
     if (targetCell.type == CellType::WALL || 
         (targetCell.type == CellType::GATE && !targetCell.isCurrentlyOpen) ||
@@ -145,9 +77,9 @@ bool Grid::IsValidMove(int fromX, int fromY, int toX, int toY) {
         return false;
     }
     
-    std::vector<Vector2> neighbors = GetNeighbors(fromX, fromY);
-    for (const Vector2& neighbor : neighbors) {
-        if ((int)neighbor.x == toX && (int)neighbor.y == toY) {
+    std::vector<GridPos> neighbors = GetNeighbors(fromX, fromY);
+    for (const GridPos& neighbor : neighbors) {
+        if (neighbor.x == toX && neighbor.y == toY) {
             return true;
         }
     }
@@ -162,10 +94,15 @@ bool Grid::LoadFromFile(const std::string& filename) {
         return false;
     }
     
+    LoadFromLevelData(levelData);
+    return true;
+}
+
+void Grid::LoadFromLevelData(const LevelData& levelData) {
     width = levelData.width;
     height = levelData.height;
-    startPos = {(float)levelData.startX, (float)levelData.startY};
-    goalPos = {(float)levelData.goalX, (float)levelData.goalY};
+    startPos = {levelData.startX, levelData.startY};
+    goalPos = {levelData.goalX, levelData.goalY};
     turnCycleLength = levelData.turnCycleLength;
     currentTurn = 0;
     
@@ -179,54 +116,187 @@ bool Grid::LoadFromFile(const std::string& filename) {
         hexSize = 30.0f;
     }
     
-    cells.clear();
-    cells.reserve(height);
+    BuildGatePatterns(levelData);
+    cells.assign((size_t)width * height, HexCell(CellType::FREE));
+    
+    // Las directivas vienen ordenadas por (y, x): se recorren en paralelo con las celdas
+    auto gate = levelData.gateAssignments.begin();
+    auto temporal = levelData.temporalWalls.begin();
     
     for (int y = 0; y < height; y++) {
-        std::vector<HexCell> row;
-        row.reserve(width);
+        const char* rowChars = &levelData.cells[(size_t)y * width];
         
         for (int x = 0; x < width; x++) {
-            CellType type = CellType::FREE;
-            char cellChar = levelData.cellTypes[y][x];
-            
-            switch (cellChar) {
-                case 'S': type = CellType::START; break;
-                case 'G': type = CellType::GOAL; break;
-                case '#': type = CellType::WALL; break;
-                case '.': type = CellType::FREE; break;
-                case 'T': type = CellType::TEMPORAL_WALL; break;
-                default: type = CellType::FREE; break;
+            const GateAssignment* cellGate = nullptr;
+            const TemporalWall* cellTemporal = nullptr;
+            if (gate != levelData.gateAssignments.end() && gate->x == x && gate->y == y) {
+                cellGate = &*gate++;
             }
-            
-            row.emplace_back(x, y, type);
-            HexCell& cell = row.back();
-            
-            if (levelData.gateAssignments.count({x, y})) {
-                cell.type = CellType::GATE;
-                cell.gatePattern = levelData.gateAssignments.at({x, y});
+            if (temporal != levelData.temporalWalls.end() && temporal->x == x && temporal->y == y) {
+                cellTemporal = &*temporal++;
             }
             
-            if (levelData.temporalWalls.count({x, y})) {
-                cell.type = CellType::TEMPORAL_WALL;
-                cell.turnsToOpen = levelData.temporalWalls.at({x, y});
-                cell.isCurrentlyOpen = false;
-            }
+            SetupCell(CellAt(x, y), rowChars[x], cellGate, cellTemporal);
         }
-        
-        cells.push_back(std::move(row));
     }
     
+    itemPositions.clear();
     for (const auto& item : levelData.items) {
         if (item.first >= 0 && item.first < width && item.second >= 0 && item.second < height) {
-            cells[item.second][item.first].type = CellType::ITEM;
+            CellAt(item.first, item.second).type = CellType::ITEM;
+            itemPositions.push_back(item);
         }
     }
     
-    gatePatterns = levelData.gatePatterns;
+    tableStorage = levelData.tableStorage;
+    goalDistance = levelData.goalDistance;
+    adjacency = levelData.adjacency;
     UpdateGatesAndWalls();
     
     std::cout << "Grid cargado: " << width << "x" << height << " celdas" << std::endl;
+}
+
+// Un patrón por nombre, ordenados: los definidos con GATE_ y también los que solo aparecen en un ASSIGN_
+void Grid::BuildGatePatterns(const LevelData& levelData) {
+    gatePatterns.clear();
+    for (const auto& pattern : levelData.gatePatterns) {
+        gatePatterns.push_back({pattern.first, true, pattern.second});
+    }
+    for (const GateAssignment& gate : levelData.gateAssignments) {
+        if (levelData.gatePatterns.count(gate.pattern) == 0) {
+            gatePatterns.push_back({gate.pattern, false, {}});
+        }
+    }
+    std::sort(gatePatterns.begin(), gatePatterns.end(), [](const GatePattern& a, const GatePattern& b) {
+        return a.name < b.name;
+    });
+    gatePatterns.erase(std::unique(gatePatterns.begin(), gatePatterns.end(), [](const GatePattern& a, const GatePattern& b) {
+        return a.name == b.name;
+    }), gatePatterns.end());
     
-    return true;
-}
\ No newline at end of file
+    if (gatePatterns.size() > (size_t)HexCell::MAX_DETAIL + 1) {
+        std::cout << "Demasiados patrones de compuerta (" << gatePatterns.size() << "), se usan los primeros "
+                  << HexCell::MAX_DETAIL + 1 << std::endl;
+        gatePatterns.resize((size_t)HexCell::MAX_DETAIL + 1);
+    }
+}
+
+// Índice del patrón en gatePatterns, -1 si no está
+int Grid::FindGatePattern(const std::string& name) const {
+    auto found = std::lower_bound(gatePatterns.begin(), gatePatterns.end(), name, [](const GatePattern& pattern, const std::string& key) {
+        return pattern.name < key;
+    });
+    if (found == gatePatterns.end() || found->name != name) {
+        return -1;
+    }
+    return (int)(found - gatePatterns.begin());
+}
+
+// Tipo y estado inicial de una celda según su carácter en el mapa y sus directivas
+void Grid::SetupCell(HexCell& cell, char cellChar, const GateAssignment* gate, const TemporalWall* temporal) {
+    switch (cellChar) {
+        case 'S': cell.type = CellType::START; break;
+        case 'G': cell.type = CellType::GOAL; break;
+        case '#': cell.type = CellType::WALL; break;
+        case '.': cell.type = CellType::FREE; break;
+        case 'T': cell.type = CellType::TEMPORAL_WALL; break;
+        default: cell.type = CellType::FREE; break;
+    }
+    cell.detail = 0;
+    cell.isCurrentlyOpen = true;
+    
+    if (gate != nullptr) {
+        int index = FindGatePattern(gate->pattern);
+        if (index >= 0) {
+            cell.type = CellType::GATE;
+            cell.detail = (uint16_t)index;
+        }
+    }
+    
+    if (temporal != nullptr) {
+        // Una pared que abre después del turno 65535 se trata como si abriera en ese turno
+        cell.type = CellType::TEMPORAL_WALL;
+        cell.detail = (uint16_t)std::min(std::max(temporal->turns, 0), HexCell::MAX_DETAIL);
+        cell.isCurrentlyOpen = false;
+    }
+}
+
+// Recarga en caliente: solo se tocan las celdas del diff; el turno y lo visitado se conservan
+void Grid::ApplyLevelDiff(const LevelData& levelData, const LevelDiff& diff) {
+    startPos = {levelData.startX, levelData.startY};
+    goalPos = {levelData.goalX, levelData.goalY};
+    turnCycleLength = levelData.turnCycleLength;
+    tableStorage = levelData.tableStorage;
+    goalDistance = levelData.goalDistance;
+    adjacency = levelData.adjacency;
+    
+    // Los índices de patrón cambian con la tabla nueva: las compuertas que no están en el diff se vuelven a
+    // buscar por nombre (su ASSIGN_ sigue igual, así que el nombre existe en la tabla nueva)
+    std::vector<GatePattern> previousPatterns = std::move(gatePatterns);
+    BuildGatePatterns(levelData);
+    for (HexCell& cell : cells) {
+        if (cell.type == CellType::GATE) {
+            int index = FindGatePattern(previousPatterns[cell.GateIndex()].name);
+            if (index < 0) {
+                cell.type = CellType::FREE;     // Quedó afuera de la tabla: igual que en SetupCell
+            }
+            cell.detail = (uint16_t)std::max(index, 0);
+        }
+    }
+    
+    for (const auto& changed : diff.cells) {
+        int x = changed.first;
+        int y = changed.second;
+        SetupCell(CellAt(x, y), levelData.CellAt(x, y), levelData.FindGate(x, y), levelData.FindTemporalWall(x, y));
+    }
+    
+    itemPositions.clear();
+    for (const auto& item : levelData.items) {
+        if (item.first >= 0 && item.first < width && item.second >= 0 && item.second < height) {
+            itemPositions.push_back(item);
+        }
+    }
+    // Los items que ya se recogieron siguen recogidos, salvo que la celda haya cambiado
+    for (const auto& changed : diff.cells) {
+        for (const auto& item : itemPositions) {
+            if (item == changed) {
+                CellAt(item.first, item.second).type = CellType::ITEM;
+                break;
+            }
+        }
+    }
+    
+    UpdateGatesAndWalls();
+    
+    changedCells = diff.cells;
+    changeFlashTimer = CHANGE_FLASH_SECONDS;
+}
+
+// Restaura solo el estado mutable de la partida (turno, visitados, items), sin tocar disco ni memoria dinámica
+void Grid::ResetState() {
+    currentTurn = 0;
+    
+    for (HexCell& cell : cells) {
+        cell.isVisited = false;
+        cell.isHighlighted = false;
+    }
+    
+    for (const auto& item : itemPositions) {
+        CellAt(item.first, item.second).type = CellType::ITEM;
+    }
+    
+    UpdateGatesAndWalls();
+}
+
+size_t Grid::CellBytes() const {
+    return cells.capacity() * sizeof(HexCell) + itemPositions.capacity() * sizeof(std::pair<int, int>);
+}
+
+size_t Grid::GateTableBytes() const {
+    size_t bytes = gatePatterns.capacity() * sizeof(GatePattern);
+    for (const GatePattern& pattern : gatePatterns) {
+        bytes += pattern.name.capacity() > 15 ? pattern.name.capacity() + 1 : 0;     // Sin contar los que entran en el SSO
+        bytes += (pattern.phases.capacity() + 7) / 8;
+    }
+    return bytes;
+}
@@ -1,34 +1,85 @@
 // Grid.h, este archivo define la clase Grid que representa una cuadrícula de celdas hexagonales en un juego. La clase incluye métodos para cargar datos desde un archivo, actualizar el estado de la cuadrícula, dibujar las celdas y manejar la lógica del juego.
 #pragma once
+#include "GridPos.h"
 #include "HexCell.h"
+#include "FileLoader.h"
 #include <vector>
 #include <string>
-#include <map>
+#include <memory>
+
+struct SearchSnapshot;
+struct LevelDiff;
+
+// Patrón de compuerta por índice (HexCell::detail). Si ninguna directiva GATE_ define el nombre, 'defined'
+// queda en false y la compuerta no cambia nunca.
+struct GatePattern {
+    std::string name;
+    bool defined;
+    std::vector<bool> phases;
+};
 
 class Grid {
 public:
     int width, height;
-    std::vector<std::vector<HexCell>> cells;
-    Vector2 startPos, goalPos;
+    std::vector<HexCell> cells;         // Fila por fila (width * height), 4 bytes por celda
+    GridPos startPos, goalPos;
     int currentTurn;
     float hexSize;
     
-    std::map<std::string, std::vector<bool>> gatePatterns;
+    std::vector<GatePattern> gatePatterns;            // Ordenados por nombre
     int turnCycleLength;
+    std::vector<std::pair<int, int>> itemPositions;   // Para restaurar items al reiniciar
+    
+    // Campo de distancias a la meta (opcional, viene del .etgl); lo usa A* como heurística.
+    // La adyacencia también viene del .etgl: máscara de vecinos que no son pared fija.
+    std::shared_ptr<const void> tableStorage;
+    const uint32_t* goalDistance;
+    const uint8_t* adjacency;
     
     Grid(int w, int h);
+    
+    HexCell& CellAt(int x, int y) { return cells[(size_t)y * width + x]; }
+    const HexCell& CellAt(int x, int y) const { return cells[(size_t)y * width + x]; }
+    const GatePattern& GatePatternOf(const HexCell& cell) const { return gatePatterns[cell.GateIndex()]; }
+
     bool LoadFromFile(const std::string& filename);
+    void LoadFromLevelData(const LevelData& levelData);
+    void ApplyLevelDiff(const LevelData& levelData, const LevelDiff& diff);
+    void ResetState();
     void Update();
     void UpdateGatesAndWalls();
-    void Draw();
-    HexCell* GetCellAt(Vector2 mousePos);
     bool IsValidMove(int fromX, int fromY, int toX, int toY);
-    std::vector<Vector2> GetNeighbors(int x, int y);
+    std::vector<GridPos> GetNeighbors(int x, int y);
+    
+    // Bit i = vecino i de HexOffsetsForColumn dentro del mapa (y sin pared fija si hay adyacencia precalculada);
+    // los solvers recorren esto en vez de armar el vector de GetNeighbors
+    uint8_t NeighborMask(int x, int y) const;
     
+    // Para MemoryReport: celdas (con la lista de items) y patrones de compuertas
+    size_t CellBytes() const;
+    size_t GateTableBytes() const;
+    
+#ifndef ETG_HEADLESS
+    // Dibujo y coordenadas de pantalla (GridRender.cpp)
+    // Dibuja una copia de las celdas (fila por fila) con la geometría de este grid; la copia es el snapshot
+    // del hilo de simulación, así que el dibujo no lee 'cells' mientras la simulación las modifica
+    void Draw(std::vector<HexCell>& cellsToDraw, RenderDetail renderDetail = RenderDetail::FULL);
+    void DrawSearchOverlay(const SearchSnapshot& search);   // Mapa de calor de una búsqueda (SearchTrace)
+    bool GetCellAt(Vector2 mousePos, GridPos& cell);   // false si el mouse no está sobre ninguna celda
     Vector2 GetMapOffset();
     Vector2 HexToScreen(int x, int y, Vector2 offset);
     Vector2 GetPlayerScreenPosition(int gridX, int gridY);  
+#endif
     
 private:
+    static constexpr float CHANGE_FLASH_SECONDS = 1.5f;
+    std::vector<std::pair<int, int>> changedCells;
+    float changeFlashTimer;
+    
+#ifndef ETG_HEADLESS
     Vector2 HexToScreen(int x, int y);
+#endif
+    void BuildGatePatterns(const LevelData& levelData);
+    int FindGatePattern(const std::string& name) const;
+    void SetupCell(HexCell& cell, char cellChar, const GateAssignment* gate, const TemporalWall* temporal);
 };
\ No newline at end of file
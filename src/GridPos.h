@@ -0,0 +1,9 @@
+// GridPos.h, coordenadas enteras de una celda; la lógica del juego no depende de raylib ni de floats
+#pragma once
+
+struct GridPos {
+    int x, y;
+};
+
+inline bool operator==(const GridPos& a, const GridPos& b) { return a.x == b.x && a.y == b.y; }
+inline bool operator!=(const GridPos& a, const GridPos& b) { return !(a == b); }
@@ -0,0 +1,107 @@
+// GridRender.cpp, dibujo del grid y conversión entre celdas y pantalla (solo en el ejecutable con raylib)
+#include "Grid.h"
+#include "SearchTrace.h"
+#include <algorithm>
+
+Vector2 Grid::GetMapOffset() {
+    // offset para centrar el mapa en la pantalla
+    float panelWidth = 250.0f; // Ancho de cada panel lateral
+    float availableWidth = GetScreenWidth() - (panelWidth * 2);
+    float availableHeight = GetScreenHeight() - 100.0f;
+    
+    // tamaño aproximado del mapa
+    float hexWidth = hexSize * 2.0f;
+    float hexHeight = sqrtf(3.0f) * hexSize;
+    
+    float mapWidth = hexWidth * 0.75f * width + hexSize;
+    float mapHeight = hexHeight * height;
+    
+    float offsetX = panelWidth + (availableWidth - mapWidth) / 2.0f;
+    float offsetY = 50.0f + (availableHeight - mapHeight) / 2.0f;
+    
+    return {offsetX, offsetY};
+}
+
+Vector2 Grid::GetPlayerScreenPosition(int gridX, int gridY) {
+    Vector2 offset = GetMapOffset();
+    return HexToScreen(gridX, gridY, offset);
+}
+
+void Grid::Draw(std::vector<HexCell>& cellsToDraw, RenderDetail renderDetail) {
+    // offset de centrado del mapa
+    Vector2 mapOffset = GetMapOffset();
+    
+    // Dibujar todas las celdas (la posición sale del índice, fila por fila)
+    for (size_t index = 0; index < cellsToDraw.size(); index++) {
+        int x = (int)(index % width);
+        int y = (int)(index / width);
+        cellsToDraw[index].Draw(HexToScreen(x, y, mapOffset), hexSize, renderDetail);
+    }
+    
+    // Resaltar por un momento las celdas que cambió la última recarga en caliente
+    if (changeFlashTimer > 0.0f) {
+        changeFlashTimer -= GetFrameTime();
+        unsigned char alpha = (unsigned char)(255.0f * std::max(0.0f, changeFlashTimer) / CHANGE_FLASH_SECONDS);
+        for (const auto& changed : changedCells) {
+            DrawPolyLinesEx(HexToScreen(changed.first, changed.second, mapOffset), 6, hexSize, 0.0f, 3.0f,
+                            {255, 0, 255, alpha});
+        }
+    }
+}
+
+// Celdas expandidas de azul (pocas veces) a rojo (muchas, en distintos turnos), frontera con borde amarillo
+// y el primer turno en que la búsqueda llegó a cada celda
+void Grid::DrawSearchOverlay(const SearchSnapshot& search) {
+    Vector2 mapOffset = GetMapOffset();
+    float maxExpanded = (float)std::max(1, search.maxExpanded);
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            size_t index = (size_t)y * width + x;
+            if (!search.Reached(index)) continue;
+            
+            const SearchCell& cell = search.cells[index];
+            Vector2 center = HexToScreen(x, y, mapOffset);
+            if (cell.expandedCount > 0) {
+                float heat = cell.expandedCount / maxExpanded;
+                Color color = {(unsigned char)(255 * heat), 60, (unsigned char)(255 * (1.0f - heat)), 110};
+                DrawPoly(center, 6, hexSize * 0.8f, 0.0f, color);
+            }
+            if (cell.openCount > 0) {
+                DrawPolyLinesEx(center, 6, hexSize * 0.8f, 0.0f, 2.0f, YELLOW);
+            }
+            if (hexSize >= 25.0f) {
+                DrawText(TextFormat("%d", cell.earliestTurn), (int)center.x - 6, (int)center.y + (int)(hexSize * 0.35f), 10, WHITE);
+            }
+        }
+    }
+}
+
+Vector2 Grid::HexToScreen(int x, int y, Vector2 offset) {
+    float hexWidth = hexSize * 2.0f;
+    float hexHeight = sqrtf(3.0f) * hexSize;
+    
+    float screenX = hexWidth * 0.75f * x;
+    float screenY = hexHeight * (y + 0.5f * (x & 1));
+    
+    return {screenX + offset.x, screenY + offset.y};
+}
+
+Vector2 Grid::HexToScreen(int x, int y) {
+    Vector2 offset = GetMapOffset();
+    return HexToScreen(x, y, offset);
+}
+
+bool Grid::GetCellAt(Vector2 mousePos, GridPos& cell) {
+    Vector2 mapOffset = GetMapOffset();
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            if (CellAt(x, y).IsPointInside(HexToScreen(x, y, mapOffset), mousePos, hexSize)) {
+                cell = {x, y};
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
@@ -1,10 +1,12 @@
-
 #pragma once
+#ifndef ETG_HEADLESS
 #include "raylib.h"
-#include <string>
+#include "RenderBudget.h"
+#endif
 #include <cmath>
+#include <cstdint>
 
-enum class CellType {
+enum class CellType : uint8_t {
     FREE,
     WALL,
     START,
@@ -14,27 +16,35 @@ enum class CellType {
     TEMPORAL_WALL
 };
 
+// Estado de una celda en 4 bytes: la posición sale del índice en Grid::cells (fila por fila) y el patrón de una
+// compuerta vive en Grid::gatePatterns; acá solo queda su índice
 class HexCell {
 public:
+    static constexpr int MAX_DETAIL = 0xFFFF;
     
     CellType type;              
-    int x, y;                   
-    Vector2 screenPos;          
-    bool isVisited;             
-    bool isHighlighted;         
-    std::string gatePattern;    
-    int turnsToOpen;           
-    bool isCurrentlyOpen;      
-    
+    bool isVisited : 1;
+    bool isHighlighted : 1;
+    bool isCurrentlyOpen : 1;
+    uint16_t detail;            // GATE: índice en Grid::gatePatterns; TEMPORAL_WALL: turno en que se abre
     
     HexCell();
-    HexCell(int gridX, int gridY, CellType cellType);
+    explicit HexCell(CellType cellType);
+    
+    int GateIndex() const { return detail; }
+    int TurnsToOpen() const { return detail; }
     
-    void Draw(float size);
-    bool IsPointInside(Vector2 point, float size);
+#ifndef ETG_HEADLESS
+    // Dibujo (HexCellRender.cpp): la posición en pantalla la calcula Grid, la celda no la guarda
+    // Con menos detalle se saltean sombras, bordes y símbolos (ver RenderDetail)
+    void Draw(Vector2 screenPos, float size, RenderDetail renderDetail = RenderDetail::FULL);
+    bool IsPointInside(Vector2 center, Vector2 point, float size);
     Vector2 GetScreenPosition(int gridX, int gridY, float hexSize);
     
 private:
     Color GetCellColor(float size);
-    void DrawHexagon(Vector2 center, float size, Color color);
-};
\ No newline at end of file
+    void DrawHexagon(Vector2 center, float size, Color color, RenderDetail renderDetail);
+#endif
+};
+
+static_assert(sizeof(HexCell) <= 4, "HexCell tiene que entrar en 4 bytes");
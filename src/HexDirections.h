@@ -0,0 +1,22 @@
+// HexDirections.h, desplazamientos de los 6 vecinos en el grid hexagonal (coordenadas offset por columna)
+#pragma once
+
+// El orden de las direcciones es el mismo en columnas pares e impares:
+// 0 = arriba, 1 = arriba-derecha, 2 = abajo-derecha, 3 = abajo, 4 = abajo-izquierda, 5 = arriba-izquierda
+static const int HEX_EVEN_COL_OFFSETS[6][2] = {{0, -1}, {1, -1}, {1, 0}, {0, 1}, {-1, 0}, {-1, -1}};
+static const int HEX_ODD_COL_OFFSETS[6][2] = {{0, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}};
+
+inline const int (*HexOffsetsForColumn(int x))[2] {
+    return (x % 2 == 0) ? HEX_EVEN_COL_OFFSETS : HEX_ODD_COL_OFFSETS;
+}
+
+// Devuelve la dirección (0-5) que lleva de (fromX, fromY) a (toX, toY), o -1 si no son vecinos
+inline int HexDirectionBetween(int fromX, int fromY, int toX, int toY) {
+    const int (*offsets)[2] = HexOffsetsForColumn(fromX);
+    for (int i = 0; i < 6; i++) {
+        if (fromX + offsets[i][0] == toX && fromY + offsets[i][1] == toY) {
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,353 @@
+// ItemRoutePlanner.cpp
+#include "ItemRoutePlanner.h"
+#include "GameRules.h"
+#include "HexDirections.h"
+#include <algorithm>
+#include <chrono>
+
+ItemRoutePlanner::ItemRoutePlanner(const SharedLevel& sharedLevel, const ItemRouteSettings& plannerSettings)
+    : level(sharedLevel), settings(plannerSettings), transientTurns(0), classCount(1), originTurn(0),
+      originScore(0), originVisited(nullptr), legSearches(0), legMillis(0.0), stamp(0), searchStamp(0) {
+    // Más de 16 items la tabla de la DP ya no entra en memoria con comodidad
+    settings.maxDpItems = std::max(0, std::min(settings.maxDpItems, 16));
+    settings.beamWidth = std::max(1, settings.beamWidth);
+    settings.beamBranching = std::max(1, settings.beamBranching);
+}
+
+ItemRoute ItemRoutePlanner::PlanFor(const Grid& grid, const Player& player, const ItemRouteSettings& settings) {
+    SharedLevel level;
+    if (!level.Build(grid)) {
+        return ItemRoute();
+    }
+    std::vector<uint8_t> visited(level.CellCount(), 0);
+    for (int y = 0; y < grid.height; y++) {
+        for (int x = 0; x < grid.width; x++) {
+            visited[(size_t)y * grid.width + x] = player.HasVisited(x, y) ? 1 : 0;
+        }
+    }
+    ItemRoutePlanner planner(level, settings);
+    return planner.Plan({player.x, player.y}, grid.currentTurn, player.score, visited);
+}
+
+ItemRoute ItemRoutePlanner::Plan(GridPos from, int turn, int score, const std::vector<uint8_t>& visited) {
+    auto startTime = std::chrono::steady_clock::now();
+    ItemRoute route;
+    if (from.x < 0 || from.x >= level.width || from.y < 0 || from.y >= level.height) {
+        return route;
+    }
+    size_t cellCount = level.CellCount();
+    originTurn = turn;
+    originScore = score;
+    originVisited = visited.size() == cellCount ? &visited : nullptr;
+
+    points.clear();
+    points.push_back(from.y * level.width + from.x);
+    for (int cell = 0; cell < (int)cellCount; cell++) {
+        if (level.ItemIndex(cell) >= 0 && cell != points[0]) points.push_back(cell);
+    }
+    points.push_back(level.goalPos.y * level.width + level.goalPos.x);
+    route.itemCount = ItemCount();
+    cellTarget.assign(cellCount, -1);
+    for (size_t point = 1; point < points.size(); point++) {
+        cellTarget[points[point]] = (int)point - 1;
+    }
+    if (points[0] == points.back()) {
+        route.found = true;
+        route.score = score;
+        route.turns = 0;
+        return route;
+    }
+
+    transientTurns = level.TimeToGoal().TransientTurns();
+    classCount = transientTurns + level.cycle;
+    legs.clear();
+    legSearches = 0;
+    visitedStamp.assign(cellCount, 0);
+    takenStamp.assign(cellCount, 0);
+    stamp = 0;
+    parent.assign((size_t)classCount * cellCount, -1);
+    seenStamp.assign((size_t)classCount * cellCount, 0);
+    searchStamp = 0;
+    legMillis = 0.0;
+
+    Walk bestWalk;
+    std::vector<int> bestOrder;
+    route.subsetDp = ItemCount() <= settings.maxDpItems;
+    if (route.subsetDp) {
+        SolveSubsetDp(route, bestWalk, bestOrder);
+    } else {
+        SolveBeam(route, bestWalk, bestOrder);
+    }
+
+    if (route.found) {
+        Walk walk;
+        WalkOrder(bestOrder, true, walk, &route.path);
+        for (int point : bestOrder) {
+            route.order.push_back({points[point] % level.width, points[point] / level.width});
+        }
+        route.items = walk.items;
+        route.backtracks = walk.backtracks;
+        route.score = walk.score;
+        route.turns = walk.turn - originTurn;
+    }
+    // Los tramos se calculan a demanda mientras se elige el orden; lo que no fue BFS es el orden
+    double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    route.legSearches = legSearches;
+    route.legMillis = legMillis;
+    route.orderMillis = std::max(0.0, total - legMillis);
+    return route;
+}
+
+// BFS hacia adelante sobre (celda, clase de turno) desde el punto: cada paso es un turno y la celda destino tiene
+// que estar abierta en el turno de salida. Dos turnos con la misma clase tienen el mismo futuro, así que alcanza
+// con ver cada (celda, clase) una vez. No se pasa por la meta: pisarla termina la partida.
+const ItemRoutePlanner::LegSet& ItemRoutePlanner::Legs(int point, int turn) {
+    int key = point * classCount + TurnClass(turn);
+    auto cached = legs.find(key);
+    if (cached != legs.end()) {
+        return cached->second;
+    }
+    auto startTime = std::chrono::steady_clock::now();
+    legSearches++;
+
+    int targetCount = ItemCount() + 1;
+    int cellCount = (int)level.CellCount();
+    int goalCell = points.back();
+    std::vector<int> reached(targetCount, -1);
+    LegSet& set = legs[key];
+    set.turns.assign(targetCount, -1);
+
+    searchStamp++;
+    queueStates.clear();
+    queueTurns.clear();
+    int source = TurnClass(turn) * cellCount + points[point];
+    seenStamp[source] = searchStamp;
+    parent[source] = -1;
+    queueStates.push_back(source);
+    queueTurns.push_back(turn);
+    int remaining = targetCount;
+
+    for (size_t head = 0; head < queueStates.size() && remaining > 0; head++) {
+        int state = queueStates[head];
+        int stateTurn = queueTurns[head];
+        int cell = state % cellCount;
+        int target = TargetOf(cell);
+        if (target >= 0 && reached[target] < 0) {
+            reached[target] = state;
+            set.turns[target] = stateTurn - turn;
+            remaining--;
+        }
+        if (cell == goalCell) continue;
+
+        int x = cell % level.width, y = cell / level.width;
+        const int (*offsets)[2] = HexOffsetsForColumn(x);
+        int nextClass = TurnClass(stateTurn + 1);
+        for (int direction = 0; direction < 6; direction++) {
+            int nx = x + offsets[direction][0];
+            int ny = y + offsets[direction][1];
+            if (nx < 0 || nx >= level.width || ny < 0 || ny >= level.height) continue;
+            int next = ny * level.width + nx;
+            if (!level.IsOpen(next, stateTurn)) continue;
+            int nextState = nextClass * cellCount + next;
+            if (seenStamp[nextState] == searchStamp) continue;
+            seenStamp[nextState] = searchStamp;
+            parent[nextState] = state;
+            queueStates.push_back(nextState);
+            queueTurns.push_back(stateTurn + 1);
+        }
+    }
+
+    // Los caminos se sacan ya: parent se pisa en el próximo BFS
+    set.offsets.assign(targetCount + 1, 0);
+    for (int target = 0; target < targetCount; target++) {
+        set.offsets[target] = (int)set.cells.size();
+        if (reached[target] < 0) continue;
+        size_t first = set.cells.size();
+        for (int state = reached[target]; parent[state] >= 0; state = parent[state]) {
+            set.cells.push_back(state % cellCount);
+        }
+        std::reverse(set.cells.begin() + first, set.cells.end());
+    }
+    set.offsets[targetCount] = (int)set.cells.size();
+
+    legMillis += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    return set;
+}
+
+// Recorre los tramos encadenados con las reglas de GameRules::EnterCell: penalización al volver a una celda
+// (con el piso en 0 de Player) y después el item si lo hay. false si algún tramo no existe.
+bool ItemRoutePlanner::WalkOrder(const std::vector<int>& order, bool toGoal, Walk& walk, std::vector<GridPos>* path) {
+    stamp++;
+    walk = Walk();
+    walk.turn = originTurn;
+    walk.score = originScore;
+    visitedStamp[points[0]] = stamp;
+
+    int current = 0;
+    size_t legCount = order.size() + (toGoal ? 1 : 0);
+    for (size_t leg = 0; leg < legCount; leg++) {
+        int point = leg < order.size() ? order[leg] : GoalPoint();
+        const LegSet& set = Legs(current, walk.turn);
+        int target = point - 1;
+        if (set.turns[target] < 0) {
+            return false;
+        }
+        for (int index = set.offsets[target]; index < set.offsets[target + 1]; index++) {
+            int cell = set.cells[index];
+            bool visited = visitedStamp[cell] == stamp || (originVisited != nullptr && (*originVisited)[cell] != 0);
+            if (visited) {
+                walk.backtracks++;
+                walk.score = std::max(0, walk.score - Player::BACKTRACK_PENALTY);
+            }
+            visitedStamp[cell] = stamp;
+            int cellTarget = TargetOf(cell);
+            if (cellTarget >= 0 && cellTarget < ItemCount() && takenStamp[cell] != stamp) {
+                takenStamp[cell] = stamp;
+                walk.items++;
+                walk.score += GameRules::ITEM_SCORE;
+            }
+            if (path != nullptr) path->push_back({cell % level.width, cell / level.width});
+        }
+        walk.turn += set.turns[target];
+        current = point;
+    }
+    return true;
+}
+
+// Más puntaje, después más items y después menos turnos
+bool ItemRoutePlanner::Finish(const std::vector<int>& order, ItemRoute& best, Walk& bestWalk, std::vector<int>& bestOrder) {
+    Walk walk;
+    if (!WalkOrder(order, true, walk, nullptr)) {
+        return false;
+    }
+    best.candidates++;
+    bool better = !best.found || walk.score > bestWalk.score ||
+                  (walk.score == bestWalk.score && (walk.items > bestWalk.items ||
+                                                    (walk.items == bestWalk.items && walk.turn < bestWalk.turn)));
+    if (better) {
+        best.found = true;
+        bestWalk = walk;
+        bestOrder = order;
+    }
+    return true;
+}
+
+// DP por (subconjunto, último item, clase del turno de llegada) con el turno de llegada más temprano. Como no se
+// puede esperar, llegar antes no siempre es mejor; llegar antes con la misma clase sí en turnos, y por eso se
+// guarda una entrada por clase. Cada estado se cierra yendo a la meta y se evalúa con el puntaje exacto. No es
+// óptima: la entrada que se descarta por llegar más tarde puede haber vuelto sobre menos celdas, y de ahí en
+// adelante las vueltas dependen de todo lo pisado antes.
+void ItemRoutePlanner::SolveSubsetDp(ItemRoute& best, Walk& bestWalk, std::vector<int>& bestOrder) {
+    int count = ItemCount();
+    std::vector<std::vector<DpEntry>> table(((size_t)1 << count) * count);
+    auto insert = [](std::vector<DpEntry>& entries, const DpEntry& entry) {
+        for (DpEntry& other : entries) {
+            if (other.turnClass == entry.turnClass) {
+                if (entry.turn < other.turn) other = entry;
+                return;
+            }
+        }
+        entries.push_back(entry);
+    };
+
+    std::vector<int> order;
+    Finish(order, best, bestWalk, bestOrder);
+    const LegSet& first = Legs(0, originTurn);
+    for (int item = 0; item < count; item++) {
+        if (first.turns[item] < 0) continue;
+        int arrival = originTurn + first.turns[item];
+        insert(table[((size_t)1 << item) * count + item], {TurnClass(arrival), arrival, -1, -1});
+    }
+
+    for (uint32_t mask = 1; mask < ((uint32_t)1 << count); mask++) {
+        for (int last = 0; last < count; last++) {
+            if ((mask & (1u << last)) == 0) continue;
+            size_t slot = (size_t)mask * count + last;
+            for (int entryIndex = 0; entryIndex < (int)table[slot].size(); entryIndex++) {
+                DpEntry entry = table[slot][entryIndex];
+
+                order.clear();
+                uint32_t chainMask = mask;
+                int chainLast = last, chainEntry = entryIndex;
+                while (chainLast >= 0) {
+                    order.push_back(chainLast + 1);
+                    const DpEntry& link = table[(size_t)chainMask * count + chainLast][chainEntry];
+                    chainMask &= ~(1u << chainLast);
+                    chainLast = link.previousLast;
+                    chainEntry = link.previousEntry;
+                }
+                std::reverse(order.begin(), order.end());
+                Finish(order, best, bestWalk, bestOrder);
+
+                const LegSet& set = Legs(last + 1, entry.turn);
+                for (int item = 0; item < count; item++) {
+                    if ((mask & (1u << item)) != 0 || set.turns[item] < 0) continue;
+                    int arrival = entry.turn + set.turns[item];
+                    insert(table[(size_t)(mask | (1u << item)) * count + item],
+                           {TurnClass(arrival), arrival, last, entryIndex});
+                }
+            }
+        }
+    }
+}
+
+// Con muchos items: por niveles de profundidad, cada estado prueba los beamBranching items pendientes más
+// cercanos en turnos y quedan los beamWidth mejores por puntaje exacto del camino hecho
+void ItemRoutePlanner::SolveBeam(ItemRoute& best, Walk& bestWalk, std::vector<int>& bestOrder) {
+    struct BeamState {
+        std::vector<int> order;
+        Walk walk;
+    };
+    int count = ItemCount();
+    std::vector<BeamState> beam(1);
+    Finish(beam[0].order, best, bestWalk, bestOrder);
+    std::vector<std::pair<int, int>> nearest;
+    std::vector<BeamState> children;
+
+    for (int depth = 0; depth < count && !beam.empty(); depth++) {
+        children.clear();
+        for (const BeamState& state : beam) {
+            Walk walk;
+            WalkOrder(state.order, false, walk, nullptr);
+            const LegSet& set = Legs(state.order.empty() ? 0 : state.order.back(), walk.turn);
+            // takenStamp todavía es el de este recorrido
+            nearest.clear();
+            for (int item = 0; item < count; item++) {
+                if (set.turns[item] >= 0 && takenStamp[points[item + 1]] != stamp) {
+                    nearest.push_back({set.turns[item], item});
+                }
+            }
+            size_t branching = std::min(nearest.size(), (size_t)settings.beamBranching);
+            std::partial_sort(nearest.begin(), nearest.begin() + branching, nearest.end());
+            for (size_t i = 0; i < branching; i++) {
+                BeamState child;
+                child.order = state.order;
+                child.order.push_back(nearest[i].second + 1);
+                if (WalkOrder(child.order, false, child.walk, nullptr)) children.push_back(std::move(child));
+            }
+        }
+
+        std::sort(children.begin(), children.end(), [](const BeamState& a, const BeamState& b) {
+            if (a.walk.score != b.walk.score) return a.walk.score > b.walk.score;
+            if (a.walk.items != b.walk.items) return a.walk.items > b.walk.items;
+            if (a.walk.turn != b.walk.turn) return a.walk.turn < b.walk.turn;
+            return a.order < b.order;
+        });
+        // Órdenes distintos que terminan igual (mismo último item, turno, puntaje e items) valen lo mismo
+        beam.clear();
+        for (BeamState& child : children) {
+            if ((int)beam.size() >= settings.beamWidth) break;
+            bool duplicate = false;
+            for (const BeamState& kept : beam) {
+                if (kept.order.back() == child.order.back() && kept.walk.turn == child.walk.turn &&
+                    kept.walk.score == child.walk.score && kept.walk.items == child.walk.items) {
+                    duplicate = true;
+                    break;
+                }
+            }
+            if (duplicate) continue;
+            Finish(child.order, best, bestWalk, bestOrder);
+            beam.push_back(std::move(child));
+        }
+    }
+}
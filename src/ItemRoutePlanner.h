@@ -0,0 +1,102 @@
+// ItemRoutePlanner.h, ruta de puntaje alto hasta la meta: cada item suma GameRules::ITEM_SCORE y volver a pisar
+// una celda resta Player::BACKTRACK_PENALTY. Primero calcula los tramos más cortos en el tiempo entre el punto de
+// partida, cada item y la meta (BFS por (celda, turno) con la regla del juego manual); después elige qué items
+// buscar y en qué orden: DP por subconjuntos hasta maxDpItems y beam search acotada con más items. El puntaje
+// de cada candidato se calcula exacto recorriendo el camino completo (vueltas e items que se pisan de paso), pero
+// las dos búsquedas son heurísticas: los tramos no miran las vueltas y la DP poda por turno de llegada, así que
+// puede haber una ruta con más puntaje.
+#pragma once
+#include "Grid.h"
+#include "GridPos.h"
+#include "Player.h"
+#include "SharedLevel.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+struct ItemRouteSettings {
+    int maxDpItems = 12;            // Hasta acá DP por subconjuntos (2^K * K estados); con más, beam search
+    int beamWidth = 32;
+    int beamBranching = 8;          // Items más cercanos que prueba cada estado del beam
+};
+
+struct ItemRoute {
+    bool found = false;
+    std::vector<GridPos> path;      // Sin la celda de partida; termina en la meta
+    std::vector<GridPos> order;     // Items buscados, en orden (los que se pisan de paso no están)
+    int items = 0;                  // Items que junta el camino, contando los de paso
+    int backtracks = 0;
+    int score = 0;                  // Puntaje al llegar a la meta
+    int turns = 0;
+    bool subsetDp = false;          // El orden salió de la DP (false: beam search)
+    int itemCount = 0;              // Items que quedaban en el nivel
+    int legSearches = 0;            // Un BFS por punto y clase de turno de salida
+    int candidates = 0;             // Rutas completas evaluadas
+    double legMillis = 0.0;
+    double orderMillis = 0.0;
+};
+
+class ItemRoutePlanner {
+public:
+    ItemRoutePlanner(const SharedLevel& sharedLevel, const ItemRouteSettings& plannerSettings = ItemRouteSettings());
+
+    // Desde 'from' en el turno 'turn' con el puntaje actual; visited marca por celda lo ya pisado (vacío: solo from)
+    ItemRoute Plan(GridPos from, int turn, int score, const std::vector<uint8_t>& visited);
+
+    // Lo que usan el auto-solve por puntaje y el replayer: el nivel como está ahora (sin los items recogidos),
+    // la posición, el turno, el puntaje y las celdas visitadas del jugador
+    static ItemRoute PlanFor(const Grid& grid, const Player& player, const ItemRouteSettings& settings = ItemRouteSettings());
+
+private:
+    // Tramos desde un punto saliendo en una clase de turno: turnos y celdas hasta cada item y la meta
+    struct LegSet {
+        std::vector<int> turns;         // -1 si no se llega
+        std::vector<int> offsets;       // Inicio de cada camino en cells (tamaño destinos + 1)
+        std::vector<int> cells;
+    };
+    // Totales de recorrer un orden de items y, si se pide, ir a la meta
+    struct Walk {
+        int turn = 0;
+        int score = 0;
+        int items = 0;
+        int backtracks = 0;
+    };
+    struct DpEntry {
+        int turnClass;
+        int turn;
+        int previousLast;               // -1 si viene del punto de partida
+        int previousEntry;
+    };
+
+    const SharedLevel& level;
+    ItemRouteSettings settings;
+    int transientTurns;                 // Antes de este turno todavía abren paredes temporales
+    int classCount;                     // transientTurns + ciclo
+    int originTurn, originScore;
+    const std::vector<uint8_t>* originVisited;
+    std::vector<int> points;            // Celdas: 0 = partida, 1..K = items, K + 1 = meta
+    std::unordered_map<int, LegSet> legs;
+    int legSearches;
+    double legMillis;
+    std::vector<int> cellTarget;        // Por celda: índice de destino (item o meta, points - 1), -1 si no es
+
+    // Marcas por evaluación (sin limpiar arreglos entre candidatos)
+    std::vector<int> visitedStamp, takenStamp;
+    int stamp;
+
+    // BFS reusados
+    std::vector<int> parent;            // [clase * celdas + celda]: estado anterior (-1 en el de salida)
+    std::vector<int> seenStamp;
+    int searchStamp;
+    std::vector<int> queueStates, queueTurns;
+
+    int ItemCount() const { return (int)points.size() - 2; }
+    int GoalPoint() const { return (int)points.size() - 1; }
+    int TargetOf(int cell) const { return cellTarget[cell]; }
+    int TurnClass(int turn) const { return turn < transientTurns ? turn : transientTurns + turn % level.cycle; }
+    const LegSet& Legs(int point, int turn);
+    bool WalkOrder(const std::vector<int>& order, bool toGoal, Walk& walk, std::vector<GridPos>* path);
+    bool Finish(const std::vector<int>& order, ItemRoute& best, Walk& bestWalk, std::vector<int>& bestOrder);
+    void SolveSubsetDp(ItemRoute& best, Walk& bestWalk, std::vector<int>& bestOrder);
+    void SolveBeam(ItemRoute& best, Walk& bestWalk, std::vector<int>& bestOrder);
+};
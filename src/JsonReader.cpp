@@ -0,0 +1,269 @@
+// JsonReader.cpp, parser iterativo (pila explícita) que trabaja directo sobre el buffer de entrada
+#include "JsonReader.h"
+#include <charconv>
+#include <vector>
+
+namespace {
+
+class Scanner {
+public:
+    Scanner(std::string_view text, JsonHandler& handler, JsonError& error)
+        : text(text), pos(0), handler(handler), error(error) {}
+
+    bool Run();
+
+private:
+    std::string_view text;
+    size_t pos;
+    JsonHandler& handler;
+    JsonError& error;
+    std::string scratch;           // Solo se usa para cadenas con secuencias de escape
+    std::vector<char> containers;  // '{' o '[' por cada nivel abierto
+
+    bool Fail(const std::string& message) {
+        // Línea y columna se calculan solo al fallar, el camino normal no las lleva
+        error.line = 1;
+        error.column = 1;
+        for (size_t i = 0; i < pos && i < text.size(); i++) {
+            if (text[i] == '\n') {
+                error.line++;
+                error.column = 1;
+            } else {
+                error.column++;
+            }
+        }
+        error.message = message;
+        return false;
+    }
+
+    bool HandlerStopped() {
+        const std::string& message = handler.RejectMessage();
+        return Fail(message.empty() ? "parseo detenido por el handler" : message);
+    }
+
+    void SkipWhitespace() {
+        while (pos < text.size()) {
+            char c = text[pos];
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+            pos++;
+        }
+    }
+
+    bool ParseString(std::string_view& out);
+    bool ParseNumber();
+    bool ParseLiteral(const char* literal, size_t length);
+    bool ParseValue();
+};
+
+bool Scanner::ParseString(std::string_view& out) {
+    pos++; // comilla inicial
+    size_t start = pos;
+
+    // Camino rápido: sin escapes la cadena es una vista del buffer original
+    while (pos < text.size() && text[pos] != '"' && text[pos] != '\\') {
+        pos++;
+    }
+    if (pos < text.size() && text[pos] == '"') {
+        out = text.substr(start, pos - start);
+        pos++;
+        return true;
+    }
+
+    scratch.assign(text.data() + start, pos - start);
+    while (pos < text.size() && text[pos] != '"') {
+        char c = text[pos++];
+        if (c != '\\') {
+            scratch.push_back(c);
+            continue;
+        }
+        if (pos >= text.size()) break;
+
+        char escaped = text[pos++];
+        switch (escaped) {
+            case '"': scratch.push_back('"'); break;
+            case '\\': scratch.push_back('\\'); break;
+            case '/': scratch.push_back('/'); break;
+            case 'b': scratch.push_back('\b'); break;
+            case 'f': scratch.push_back('\f'); break;
+            case 'n': scratch.push_back('\n'); break;
+            case 'r': scratch.push_back('\r'); break;
+            case 't': scratch.push_back('\t'); break;
+            case 'u': {
+                unsigned code = 0;
+                if (pos + 4 > text.size() ||
+                    std::from_chars(text.data() + pos, text.data() + pos + 4, code, 16).ptr != text.data() + pos + 4) {
+                    return Fail("escape \\u inválido");
+                }
+                pos += 4;
+                // UTF-8 del punto de código (los pares sustitutos se dejan tal cual)
+                if (code < 0x80) {
+                    scratch.push_back((char)code);
+                } else if (code < 0x800) {
+                    scratch.push_back((char)(0xC0 | (code >> 6)));
+                    scratch.push_back((char)(0x80 | (code & 0x3F)));
+                } else {
+                    scratch.push_back((char)(0xE0 | (code >> 12)));
+                    scratch.push_back((char)(0x80 | ((code >> 6) & 0x3F)));
+                    scratch.push_back((char)(0x80 | (code & 0x3F)));
+                }
+                break;
+            }
+            default:
+                return Fail("secuencia de escape inválida");
+        }
+    }
+
+    if (pos >= text.size()) {
+        return Fail("cadena sin cerrar");
+    }
+    pos++;
+    out = scratch;
+    return true;
+}
+
+bool Scanner::ParseNumber() {
+    size_t start = pos;
+    bool integral = true;
+
+    if (pos < text.size() && text[pos] == '-') pos++;
+    while (pos < text.size()) {
+        char c = text[pos];
+        if (c >= '0' && c <= '9') {
+            pos++;
+        } else if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+            integral = false;
+            pos++;
+        } else {
+            break;
+        }
+    }
+
+    const char* begin = text.data() + start;
+    const char* end = text.data() + pos;
+
+    if (integral) {
+        int64_t value = 0;
+        auto result = std::from_chars(begin, end, value);
+        if (result.ec != std::errc() || result.ptr != end) {
+            pos = start;
+            return Fail("número inválido");
+        }
+        return handler.OnInteger(value) || HandlerStopped();
+    }
+
+    double value = 0.0;
+    auto result = std::from_chars(begin, end, value);
+    if (result.ec != std::errc() || result.ptr != end) {
+        pos = start;
+        return Fail("número inválido");
+    }
+    return handler.OnDouble(value) || HandlerStopped();
+}
+
+bool Scanner::ParseLiteral(const char* literal, size_t length) {
+    if (text.compare(pos, length, literal) != 0) {
+        return Fail("valor inválido");
+    }
+    pos += length;
+    return true;
+}
+
+// Un valor escalar o la apertura de un contenedor (el cierre lo maneja Run)
+bool Scanner::ParseValue() {
+    SkipWhitespace();
+    if (pos >= text.size()) {
+        return Fail("se esperaba un valor");
+    }
+
+    char c = text[pos];
+    switch (c) {
+        case '{':
+            pos++;
+            containers.push_back('{');
+            return handler.OnObjectStart() || HandlerStopped();
+        case '[':
+            pos++;
+            containers.push_back('[');
+            return handler.OnArrayStart() || HandlerStopped();
+        case '"': {
+            std::string_view value;
+            if (!ParseString(value)) return false;
+            return handler.OnString(value) || HandlerStopped();
+        }
+        case 't':
+            return ParseLiteral("true", 4) && (handler.OnBool(true) || HandlerStopped());
+        case 'f':
+            return ParseLiteral("false", 5) && (handler.OnBool(false) || HandlerStopped());
+        case 'n':
+            return ParseLiteral("null", 4) && (handler.OnNull() || HandlerStopped());
+        default:
+            if (c == '-' || (c >= '0' && c <= '9')) {
+                return ParseNumber();
+            }
+            return Fail("carácter inesperado");
+    }
+}
+
+bool Scanner::Run() {
+    if (!ParseValue()) return false;
+
+    // 'first' indica si el contenedor actual todavía no tiene elementos
+    bool first = true;
+    while (!containers.empty()) {
+        SkipWhitespace();
+        if (pos >= text.size()) {
+            return Fail("documento incompleto");
+        }
+
+        char closing = containers.back() == '{' ? '}' : ']';
+        if (text[pos] == closing) {
+            pos++;
+            containers.pop_back();
+            bool ok = closing == '}' ? handler.OnObjectEnd() : handler.OnArrayEnd();
+            if (!ok) return HandlerStopped();
+            first = false;
+            continue;
+        }
+
+        if (!first) {
+            if (text[pos] != ',') {
+                return Fail("se esperaba ',' o cierre");
+            }
+            pos++;
+            SkipWhitespace();
+        }
+
+        if (containers.back() == '{') {
+            if (pos >= text.size() || text[pos] != '"') {
+                return Fail("se esperaba una clave");
+            }
+            std::string_view key;
+            if (!ParseString(key)) return false;
+            if (!handler.OnKey(key)) return HandlerStopped();
+
+            SkipWhitespace();
+            if (pos >= text.size() || text[pos] != ':') {
+                return Fail("se esperaba ':'");
+            }
+            pos++;
+        }
+
+        size_t depth = containers.size();
+        if (!ParseValue()) return false;
+        // Si el valor abrió un contenedor nuevo, este aún no tiene elementos
+        first = containers.size() > depth;
+    }
+
+    SkipWhitespace();
+    if (pos != text.size()) {
+        return Fail("contenido extra después del documento");
+    }
+    return true;
+}
+
+} // namespace
+
+bool JsonReader::Parse(std::string_view text, JsonHandler& handler, JsonError& error) {
+    Scanner scanner(text, handler, error);
+    return scanner.Run();
+}
@@ -0,0 +1,46 @@
+// JsonReader.h, lector JSON estilo SAX: una sola pasada, sin construir un árbol en memoria
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+// Recibe los eventos del lector. Devolver false detiene el parseo (con Reject se explica por qué).
+// Las vistas de texto solo son válidas durante la llamada.
+class JsonHandler {
+public:
+    virtual ~JsonHandler() = default;
+    const std::string& RejectMessage() const { return rejectMessage; }
+
+    virtual bool OnObjectStart() { return true; }
+    virtual bool OnObjectEnd() { return true; }
+    virtual bool OnArrayStart() { return true; }
+    virtual bool OnArrayEnd() { return true; }
+    virtual bool OnKey(std::string_view key) { (void)key; return true; }
+    virtual bool OnString(std::string_view value) { (void)value; return true; }
+    virtual bool OnInteger(int64_t value) { (void)value; return true; }
+    virtual bool OnDouble(double value) { (void)value; return true; }
+    virtual bool OnBool(bool value) { (void)value; return true; }
+    virtual bool OnNull() { return true; }
+
+protected:
+    bool Reject(std::string message) {
+        rejectMessage = std::move(message);
+        return false;
+    }
+
+private:
+    std::string rejectMessage;
+};
+
+struct JsonError {
+    int line = 0;
+    int column = 0;
+    std::string message;
+};
+
+class JsonReader {
+public:
+    // Recorre 'text' y emite los eventos en orden; en caso de error llena 'error' con línea y columna
+    static bool Parse(std::string_view text, JsonHandler& handler, JsonError& error);
+};
@@ -0,0 +1,370 @@
+// LevelBinary.cpp, escritura y lectura (zero-copy vía mmap) del formato .etgl
+#include "LevelBinary.h"
+#include "LevelTables.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <vector>
+
+namespace {
+
+const char CELL_CODES[] = {'.', '#', 'S', 'G', 'T'};
+
+uint8_t EncodeCell(char c) {
+    for (uint8_t i = 0; i < sizeof(CELL_CODES); i++) {
+        if (CELL_CODES[i] == c) return i;
+    }
+    return 0;
+}
+
+char DecodeCell(uint8_t code) {
+    return code < sizeof(CELL_CODES) ? CELL_CODES[code] : '.';
+}
+
+// Agrega bytes al buffer de salida dejando la siguiente sección alineada a 8
+uint64_t AppendSection(std::vector<unsigned char>& out, const void* data, size_t bytes) {
+    while (out.size() % 8 != 0) out.push_back(0);
+    uint64_t offset = out.size();
+    const unsigned char* bytesPtr = static_cast<const unsigned char*>(data);
+    out.insert(out.end(), bytesPtr, bytesPtr + bytes);
+    return offset;
+}
+
+bool SectionFits(uint64_t offset, uint64_t count, uint64_t elementSize, uint64_t fileSize) {
+    if (offset % 8 != 0 || offset > fileSize) return false;
+    return count <= (fileSize - offset) / (elementSize == 0 ? 1 : elementSize);
+}
+
+} // namespace
+
+uint64_t LevelBinary::Checksum(const unsigned char* data, size_t size) {
+    uint64_t hash = 1469598103934665603ull;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+bool LevelBinary::Write(const LevelData& levelData, const std::string& filename, bool includeDistanceField) {
+    int width = levelData.width;
+    int height = levelData.height;
+    size_t cellCount = (size_t)width * height;
+
+    // Nombres de patrón: los definidos con GATE_ y los que solo aparecen en un ASSIGN_
+    std::map<std::string, uint32_t> nameIndex;
+    for (const auto& pattern : levelData.gatePatterns) nameIndex[pattern.first] = 0;
+    for (const auto& gate : levelData.gateAssignments) nameIndex[gate.pattern] = 0;
+
+    // Internar horarios: nombres distintos con el mismo patrón de bits comparten entrada
+    std::map<std::vector<bool>, uint32_t> scheduleIndex;
+    std::vector<EtglSchedule> schedules;
+    std::vector<uint8_t> scheduleBits;
+    uint32_t totalBits = 0;
+
+    std::vector<EtglPattern> patterns;
+    std::string names;
+    for (auto& entry : nameIndex) {
+        entry.second = (uint32_t)patterns.size();
+
+        EtglPattern pattern = {};
+        pattern.nameOffset = (uint32_t)names.size();
+        pattern.nameLength = (uint32_t)entry.first.size();
+        pattern.schedule = ETGL_NO_SCHEDULE;
+        names += entry.first;
+
+        auto definition = levelData.gatePatterns.find(entry.first);
+        if (definition != levelData.gatePatterns.end()) {
+            const std::vector<bool>& bits = definition->second;
+            auto interned = scheduleIndex.find(bits);
+            if (interned == scheduleIndex.end()) {
+                EtglSchedule schedule = {totalBits, (uint32_t)bits.size()};
+                for (bool bit : bits) {
+                    if (totalBits % 8 == 0) scheduleBits.push_back(0);
+                    if (bit) scheduleBits.back() |= (uint8_t)(1 << (totalBits % 8));
+                    totalBits++;
+                }
+                interned = scheduleIndex.emplace(bits, (uint32_t)schedules.size()).first;
+                schedules.push_back(schedule);
+            }
+            pattern.schedule = interned->second;
+        }
+        patterns.push_back(pattern);
+    }
+
+    std::vector<uint8_t> cells((cellCount + 1) / 2, 0);
+    for (size_t index = 0; index < cellCount; index++) {
+        uint8_t code = EncodeCell(levelData.cells[index]);
+        cells[index / 2] |= (uint8_t)(code << ((index % 2) * 4));
+    }
+
+    // Las directivas ya vienen ordenadas por (y, x); se escriben en el mismo orden
+    std::vector<EtglGate> gates;
+    for (const auto& gate : levelData.gateAssignments) {
+        gates.push_back({gate.x, gate.y, nameIndex[gate.pattern]});
+    }
+
+    std::vector<EtglTemporal> temporals;
+    for (const auto& wall : levelData.temporalWalls) {
+        temporals.push_back({wall.x, wall.y, wall.turns});
+    }
+
+    std::vector<EtglItem> items;
+    for (const auto& item : levelData.items) {
+        items.push_back({item.first, item.second});
+    }
+
+    std::vector<uint8_t> adjacency = LevelTables::ComputeAdjacency(levelData);
+
+    EtglHeader header = {};
+    std::memcpy(header.magic, "ETGL", 4);
+    header.version = ETGL_VERSION;
+    header.width = width;
+    header.height = height;
+    header.startX = levelData.startX;
+    header.startY = levelData.startY;
+    header.goalX = levelData.goalX;
+    header.goalY = levelData.goalY;
+    header.turnCycleLength = levelData.turnCycleLength;
+    header.patternCount = (uint32_t)patterns.size();
+    header.scheduleCount = (uint32_t)schedules.size();
+    header.gateCount = (uint32_t)gates.size();
+    header.temporalCount = (uint32_t)temporals.size();
+    header.itemCount = (uint32_t)items.size();
+
+    std::vector<unsigned char> out(sizeof(EtglHeader), 0);
+    header.cellsOffset = AppendSection(out, cells.data(), cells.size());
+    header.patternsOffset = AppendSection(out, patterns.data(), patterns.size() * sizeof(EtglPattern));
+    header.schedulesOffset = AppendSection(out, schedules.data(), schedules.size() * sizeof(EtglSchedule));
+    header.scheduleBitsOffset = AppendSection(out, scheduleBits.data(), scheduleBits.size());
+    header.namesOffset = AppendSection(out, names.data(), names.size());
+    header.gatesOffset = AppendSection(out, gates.data(), gates.size() * sizeof(EtglGate));
+    header.temporalOffset = AppendSection(out, temporals.data(), temporals.size() * sizeof(EtglTemporal));
+    header.itemsOffset = AppendSection(out, items.data(), items.size() * sizeof(EtglItem));
+    header.adjacencyOffset = AppendSection(out, adjacency.data(), adjacency.size());
+
+    if (includeDistanceField) {
+        std::vector<uint32_t> distance = LevelTables::ComputeGoalDistances(levelData);
+        header.distanceOffset = AppendSection(out, distance.data(), distance.size() * sizeof(uint32_t));
+        header.flags |= ETGL_FLAG_DISTANCE_FIELD;
+    }
+
+    while (out.size() % 8 != 0) out.push_back(0);
+    header.fileSize = out.size();
+    header.checksum = Checksum(out.data() + sizeof(EtglHeader), out.size() - sizeof(EtglHeader));
+    std::memcpy(out.data(), &header, sizeof(EtglHeader));
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "No se pudo crear el archivo: " << filename << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), (std::streamsize)out.size());
+    if (!file) {
+        std::cout << "Error escribiendo: " << filename << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool LevelBinary::Open(const std::string& filename, bool verifyChecksum) {
+    file = std::make_shared<MappedFile>();
+    header = nullptr;
+
+    if (!file->Open(filename)) {
+        return false;
+    }
+
+    if (file->Size() < sizeof(EtglHeader)) {
+        std::cout << filename << ": archivo .etgl truncado" << std::endl;
+        return false;
+    }
+
+    header = Section<EtglHeader>(0);
+    if (std::memcmp(header->magic, "ETGL", 4) != 0) {
+        std::cout << filename << ": no es un archivo .etgl" << std::endl;
+        header = nullptr;
+        return false;
+    }
+    if (header->version != ETGL_VERSION) {
+        std::cout << filename << ": versión .etgl " << header->version
+                  << " no soportada (se esperaba " << ETGL_VERSION << ")" << std::endl;
+        header = nullptr;
+        return false;
+    }
+    if (!ValidateLayout(filename)) {
+        header = nullptr;
+        return false;
+    }
+
+    if (verifyChecksum) {
+        uint64_t checksum = Checksum(file->Data() + sizeof(EtglHeader), file->Size() - sizeof(EtglHeader));
+        if (checksum != header->checksum) {
+            std::cout << filename << ": checksum inválido, el archivo está corrupto" << std::endl;
+            header = nullptr;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool LevelBinary::ValidateLayout(const std::string& filename) const {
+    uint64_t size = file->Size();
+    const EtglHeader& h = *header;
+
+    bool ok = h.fileSize == size && h.width > 0 && h.height > 0 && h.turnCycleLength > 0;
+    uint64_t cellCount = ok ? (uint64_t)h.width * (uint64_t)h.height : 0;
+
+    ok = ok && SectionFits(h.cellsOffset, (cellCount + 1) / 2, 1, size);
+    ok = ok && SectionFits(h.patternsOffset, h.patternCount, sizeof(EtglPattern), size);
+    ok = ok && SectionFits(h.schedulesOffset, h.scheduleCount, sizeof(EtglSchedule), size);
+    ok = ok && SectionFits(h.gatesOffset, h.gateCount, sizeof(EtglGate), size);
+    ok = ok && SectionFits(h.temporalOffset, h.temporalCount, sizeof(EtglTemporal), size);
+    ok = ok && SectionFits(h.itemsOffset, h.itemCount, sizeof(EtglItem), size);
+    ok = ok && SectionFits(h.adjacencyOffset, cellCount, 1, size);
+    if (ok && (h.flags & ETGL_FLAG_DISTANCE_FIELD)) {
+        ok = SectionFits(h.distanceOffset, cellCount, sizeof(uint32_t), size);
+    }
+
+    if (!ok) {
+        std::cout << filename << ": secciones del .etgl fuera de rango" << std::endl;
+        return false;
+    }
+
+    // Contenido: todo índice o coordenada que después se usa para leer del mapeo o del grid tiene que caer
+    // adentro. Son las secciones chicas (patrones y directivas), las celdas y las tablas no se tocan.
+    auto inside = [&](int32_t x, int32_t y) { return x >= 0 && x < h.width && y >= 0 && y < h.height; };
+    const char* error = nullptr;
+    if (!inside(h.startX, h.startY) || !inside(h.goalX, h.goalY)) {
+        error = "inicio o meta fuera del mapa";
+    }
+
+    const EtglPattern* patterns = Section<EtglPattern>(h.patternsOffset);
+    uint64_t namesEnd = 0;
+    for (uint32_t i = 0; i < h.patternCount && error == nullptr; i++) {
+        namesEnd = std::max(namesEnd, (uint64_t)patterns[i].nameOffset + patterns[i].nameLength);
+        if (patterns[i].schedule != ETGL_NO_SCHEDULE && patterns[i].schedule >= h.scheduleCount) {
+            error = "patrón con horario inexistente";
+        }
+    }
+    if (error == nullptr && h.patternCount > 0 && !SectionFits(h.namesOffset, namesEnd, 1, size)) {
+        error = "nombres de patrón fuera del archivo";
+    }
+
+    const EtglSchedule* schedules = Section<EtglSchedule>(h.schedulesOffset);
+    uint64_t bitsEnd = 0;
+    for (uint32_t i = 0; i < h.scheduleCount; i++) {
+        bitsEnd = std::max(bitsEnd, (uint64_t)schedules[i].bitOffset + schedules[i].length);
+    }
+    if (error == nullptr && h.scheduleCount > 0 && !SectionFits(h.scheduleBitsOffset, (bitsEnd + 7) / 8, 1, size)) {
+        error = "bits de horario fuera del archivo";
+    }
+
+    const EtglGate* gates = Section<EtglGate>(h.gatesOffset);
+    for (uint32_t i = 0; i < h.gateCount && error == nullptr; i++) {
+        if (!inside(gates[i].x, gates[i].y)) error = "compuerta fuera del mapa";
+        else if (gates[i].pattern >= h.patternCount) error = "compuerta con patrón inexistente";
+    }
+    const EtglTemporal* temporals = Section<EtglTemporal>(h.temporalOffset);
+    for (uint32_t i = 0; i < h.temporalCount && error == nullptr; i++) {
+        if (!inside(temporals[i].x, temporals[i].y)) error = "pared temporal fuera del mapa";
+    }
+    const EtglItem* items = Section<EtglItem>(h.itemsOffset);
+    for (uint32_t i = 0; i < h.itemCount && error == nullptr; i++) {
+        if (!inside(items[i].x, items[i].y)) error = "item fuera del mapa";
+    }
+
+    if (error != nullptr) {
+        std::cout << filename << ": " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+char LevelBinary::GetCellChar(int x, int y) const {
+    size_t index = (size_t)y * header->width + x;
+    uint8_t packed = Section<uint8_t>(header->cellsOffset)[index / 2];
+    return DecodeCell((packed >> ((index % 2) * 4)) & 0xF);
+}
+
+uint8_t LevelBinary::GetAdjacency(int x, int y) const {
+    return Section<uint8_t>(header->adjacencyOffset)[(size_t)y * header->width + x];
+}
+
+const uint32_t* LevelBinary::GetGoalDistances() const {
+    if (!(header->flags & ETGL_FLAG_DISTANCE_FIELD)) {
+        return nullptr;
+    }
+    return Section<uint32_t>(header->distanceOffset);
+}
+
+void LevelBinary::DecodeTo(LevelData& levelData) const {
+    const EtglHeader& h = *header;
+
+    levelData.width = h.width;
+    levelData.height = h.height;
+    levelData.startX = h.startX;
+    levelData.startY = h.startY;
+    levelData.goalX = h.goalX;
+    levelData.goalY = h.goalY;
+    levelData.turnCycleLength = h.turnCycleLength;
+
+    size_t cellCount = (size_t)h.width * h.height;
+    const uint8_t* packed = Section<uint8_t>(h.cellsOffset);
+    levelData.cells.resize(cellCount);
+    for (size_t index = 0; index < cellCount; index++) {
+        levelData.cells[index] = DecodeCell((packed[index / 2] >> ((index % 2) * 4)) & 0xF);
+    }
+
+    const EtglPattern* patterns = Section<EtglPattern>(h.patternsOffset);
+    const EtglSchedule* schedules = Section<EtglSchedule>(h.schedulesOffset);
+    const uint8_t* bits = Section<uint8_t>(h.scheduleBitsOffset);
+    const char* names = Section<char>(h.namesOffset);
+
+    std::vector<std::string> patternNames(h.patternCount);
+    levelData.gatePatterns.clear();
+    for (uint32_t i = 0; i < h.patternCount; i++) {
+        patternNames[i].assign(names + patterns[i].nameOffset, patterns[i].nameLength);
+        if (patterns[i].schedule == ETGL_NO_SCHEDULE || patterns[i].schedule >= h.scheduleCount) continue;
+
+        const EtglSchedule& schedule = schedules[patterns[i].schedule];
+        std::vector<bool>& pattern = levelData.gatePatterns[patternNames[i]];
+        pattern.resize(schedule.length);
+        for (uint32_t b = 0; b < schedule.length; b++) {
+            uint32_t bit = schedule.bitOffset + b;
+            pattern[b] = (bits[bit / 8] >> (bit % 8)) & 1;
+        }
+    }
+
+    levelData.gateAssignments.clear();
+    levelData.gateAssignments.reserve(h.gateCount);
+    const EtglGate* gates = Section<EtglGate>(h.gatesOffset);
+    for (uint32_t i = 0; i < h.gateCount; i++) {
+        if (gates[i].pattern < h.patternCount) {
+            levelData.gateAssignments.push_back({gates[i].x, gates[i].y, patternNames[gates[i].pattern]});
+        }
+    }
+
+    levelData.temporalWalls.clear();
+    levelData.temporalWalls.reserve(h.temporalCount);
+    const EtglTemporal* temporals = Section<EtglTemporal>(h.temporalOffset);
+    for (uint32_t i = 0; i < h.temporalCount; i++) {
+        levelData.temporalWalls.push_back({temporals[i].x, temporals[i].y, temporals[i].turns});
+    }
+    levelData.SortDirectives();
+
+    levelData.items.clear();
+    const EtglItem* items = Section<EtglItem>(h.itemsOffset);
+    for (uint32_t i = 0; i < h.itemCount; i++) {
+        levelData.items.push_back({items[i].x, items[i].y});
+    }
+
+    // Las tablas de los solvers no se copian: se usan directo desde el mapeo
+    levelData.tableStorage = file;
+    levelData.adjacency = Section<uint8_t>(h.adjacencyOffset);
+    levelData.goalDistance = GetGoalDistances();
+}
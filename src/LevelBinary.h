@@ -0,0 +1,96 @@
+// LevelBinary.h, formato binario compilado .etgl: encabezado versionado, checksum y tablas para los solvers
+#pragma once
+#include "FileLoader.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Todas las secciones están alineadas a 8 bytes y en little-endian (x86 / ARM)
+const uint32_t ETGL_VERSION = 1;
+const uint32_t ETGL_FLAG_DISTANCE_FIELD = 1u << 0;
+const uint32_t ETGL_NO_SCHEDULE = 0xFFFFFFFFu;
+
+struct EtglHeader {
+    char magic[4];              // "ETGL"
+    uint32_t version;
+    uint32_t flags;
+    int32_t width, height;
+    int32_t startX, startY;
+    int32_t goalX, goalY;
+    int32_t turnCycleLength;
+    uint32_t patternCount;      // Nombres de patrón (GATE_x)
+    uint32_t scheduleCount;     // Horarios únicos, los nombres con el mismo patrón comparten uno
+    uint32_t gateCount;
+    uint32_t temporalCount;
+    uint32_t itemCount;
+    uint32_t reserved;
+    uint64_t fileSize;
+    uint64_t cellsOffset;       // 4 bits por celda
+    uint64_t patternsOffset;
+    uint64_t schedulesOffset;
+    uint64_t scheduleBitsOffset;
+    uint64_t namesOffset;
+    uint64_t gatesOffset;
+    uint64_t temporalOffset;
+    uint64_t itemsOffset;
+    uint64_t adjacencyOffset;   // 1 byte por celda (máscara de 6 vecinos)
+    uint64_t distanceOffset;    // uint32 por celda, solo con ETGL_FLAG_DISTANCE_FIELD
+    uint64_t checksum;          // FNV-1a 64 de todo lo que sigue al encabezado
+};
+
+struct EtglPattern {
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t schedule;          // Índice de horario o ETGL_NO_SCHEDULE si nunca se definió
+    uint32_t reserved;
+};
+
+struct EtglSchedule {
+    uint32_t bitOffset;         // Posición en bits dentro de la sección de bits
+    uint32_t length;
+};
+
+struct EtglGate {
+    int32_t x, y;
+    uint32_t pattern;
+};
+
+struct EtglTemporal {
+    int32_t x, y;
+    int32_t turns;
+};
+
+struct EtglItem {
+    int32_t x, y;
+};
+
+class LevelBinary {
+public:
+    // Compila un nivel ya parseado a .etgl
+    static bool Write(const LevelData& levelData, const std::string& filename, bool includeDistanceField);
+
+    // Mapea el archivo sin leerlo; sin verificar el checksum abrir cuesta O(1) fallos de página
+    bool Open(const std::string& filename, bool verifyChecksum);
+
+    // Rellena un LevelData; las tablas de adyacencia y distancias apuntan directo al archivo mapeado
+    void DecodeTo(LevelData& levelData) const;
+
+    const EtglHeader& Header() const { return *header; }
+    char GetCellChar(int x, int y) const;
+    uint8_t GetAdjacency(int x, int y) const;
+    const uint32_t* GetGoalDistances() const;
+
+    static uint64_t Checksum(const unsigned char* data, size_t size);
+
+private:
+    std::shared_ptr<MappedFile> file;
+    const EtglHeader* header = nullptr;
+
+    template <typename T>
+    const T* Section(uint64_t offset) const {
+        return reinterpret_cast<const T*>(file->Data() + offset);
+    }
+
+    bool ValidateLayout(const std::string& filename) const;
+};
@@ -0,0 +1,240 @@
+// LevelGenerator.cpp, la aleatoriedad sale solo de mt19937_64 con módulo (sin std::uniform_*), así la misma
+// semilla da el mismo nivel con cualquier compilador
+#include "LevelGenerator.h"
+#include "FileLoader.h"
+#include "HexDirections.h"
+#include "LevelTables.h"
+#include "PathFinder.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+uint64_t Uniform(std::mt19937_64& rng, uint64_t count) {
+    return rng() % count;
+}
+
+// Distancia hexagonal en coordenadas offset por columna (las columnas impares bajan media celda)
+int HexDistance(int x1, int y1, int x2, int y2) {
+    int r1 = y1 - (x1 - (x1 & 1)) / 2;
+    int r2 = y2 - (x2 - (x2 & 1)) / 2;
+    int dq = x2 - x1;
+    int dr = r2 - r1;
+    return (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+}
+
+std::string PatternName(int index) {
+    return index < 26 ? std::string(1, (char)('A' + index)) : "P" + std::to_string(index);
+}
+
+} // namespace
+
+bool LevelGenerator::ValidateParams(const GeneratorParams& params) {
+    const char* error = nullptr;
+    if (params.width < 2 || params.height < 2) error = "el nivel debe ser de al menos 2x2";
+    else if ((long long)params.width * params.height > INT_MAX / 2) error = "demasiadas celdas";
+    else if (params.wallPercent < 0 || params.wallPercent > 90) error = "la densidad de paredes va de 0 a 90";
+    else if (params.gatePeriod < 1 || params.gatePeriod > 1024) error = "el período de las compuertas va de 1 a 1024";
+    else if (params.patternCount < 0 || (params.gateCount > 0 && params.patternCount == 0)) error = "hace falta al menos un patrón para las compuertas";
+    else if (params.gateCount < 0 || params.temporalCount < 0 || params.itemCount < 0) error = "las cantidades no pueden ser negativas";
+    else if (params.temporalMinTurns < 0 || params.temporalMaxTurns < params.temporalMinTurns) error = "rango de turnos de paredes temporales inválido";
+    else if (params.corridorObstaclePercent < 0 || params.corridorObstaclePercent > 100) error = "el porcentaje de obstáculos en el corredor va de 0 a 100";
+    else if (params.maxAttempts < 1) error = "hace falta al menos un intento";
+
+    if (error != nullptr) {
+        std::cout << "Generador: " << error << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void LevelGenerator::Build(const GeneratorParams& params, uint64_t seed, std::string& text) {
+    std::mt19937_64 rng(seed);
+    const int width = params.width;
+    const int height = params.height;
+    const size_t cellCount = (size_t)width * height;
+
+    // Inicio en el cuarto izquierdo y meta en el cuarto derecho
+    int quarter = std::max(1, width / 4);
+    int startX = (int)Uniform(rng, quarter), startY = (int)Uniform(rng, height);
+    int goalX = width - 1 - (int)Uniform(rng, quarter), goalY = (int)Uniform(rng, height);
+    if (startX == goalX && startY == goalY) {
+        goalX = startX == 0 ? width - 1 : 0;
+    }
+
+    std::vector<char> map(cellCount, '.');
+    std::vector<uint8_t> corridor(cellCount, 0);
+
+    // Corredor: paseo al azar sesgado hacia la meta (3 de cada 4 pasos acercan)
+    int x = startX, y = startY;
+    corridor[(size_t)y * width + x] = 1;
+    while (x != goalX || y != goalY) {
+        const int (*offsets)[2] = HexOffsetsForColumn(x);
+        int options[6][2];
+        int optionCount = 0;
+        for (int i = 0; i < 6; i++) {
+            int nx = x + offsets[i][0], ny = y + offsets[i][1];
+            if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
+                options[optionCount][0] = nx;
+                options[optionCount][1] = ny;
+                optionCount++;
+            }
+        }
+
+        int choice = (int)Uniform(rng, optionCount);
+        if (Uniform(rng, 4) != 0) {
+            int best = INT_MAX;
+            for (int i = 0; i < optionCount; i++) {
+                int distance = HexDistance(options[i][0], options[i][1], goalX, goalY);
+                if (distance < best) {
+                    best = distance;
+                    choice = i;
+                }
+            }
+        }
+        x = options[choice][0];
+        y = options[choice][1];
+        corridor[(size_t)y * width + x] = 1;
+    }
+
+    for (size_t i = 0; i < cellCount; i++) {
+        if (!corridor[i] && Uniform(rng, 100) < (uint64_t)params.wallPercent) {
+            map[i] = '#';
+        }
+    }
+
+    // Candidatas para compuertas, paredes temporales e items; del corredor solo entra una parte
+    size_t startIndex = (size_t)startY * width + startX;
+    size_t goalIndex = (size_t)goalY * width + goalX;
+    std::vector<uint32_t> candidates;
+    candidates.reserve(cellCount);
+    for (size_t i = 0; i < cellCount; i++) {
+        if (map[i] == '#' || i == startIndex || i == goalIndex) continue;
+        if (corridor[i] && Uniform(rng, 100) >= (uint64_t)params.corridorObstaclePercent) continue;
+        candidates.push_back((uint32_t)i);
+    }
+
+    // Fisher-Yates parcial: solo se mezclan las posiciones que se van a usar
+    size_t wanted = (size_t)params.gateCount + params.temporalCount + params.itemCount;
+    size_t used = std::min(wanted, candidates.size());
+    for (size_t i = 0; i < used; i++) {
+        std::swap(candidates[i], candidates[i + Uniform(rng, candidates.size() - i)]);
+    }
+    size_t gates = std::min((size_t)params.gateCount, used);
+    size_t temporals = std::min((size_t)params.temporalCount, used - gates);
+
+    // Patrones con al menos un turno abierto y uno cerrado
+    std::vector<std::string> patterns(params.patternCount);
+    for (std::string& pattern : patterns) {
+        pattern.resize(params.gatePeriod);
+        for (char& bit : pattern) bit = Uniform(rng, 2) ? '1' : '0';
+        if (params.gatePeriod > 1 && pattern.find('0') == std::string::npos) pattern[Uniform(rng, params.gatePeriod)] = '0';
+        if (pattern.find('1') == std::string::npos) pattern[Uniform(rng, params.gatePeriod)] = '1';
+    }
+
+    for (size_t i = gates + temporals; i < used; i++) {   // El resto son items
+        map[candidates[i]] = 'K';
+    }
+    map[startIndex] = 'S';
+    map[goalIndex] = 'G';
+
+    text.clear();
+    text.reserve(cellCount + (size_t)height + used * 24 + 64);
+    text += std::to_string(width) + " " + std::to_string(height) + "\n";
+    text += std::to_string(startX) + " " + std::to_string(startY) + "\n";
+    text += std::to_string(goalX) + " " + std::to_string(goalY) + "\n";
+    text += std::to_string(params.gatePeriod) + "\n";
+    for (int row = 0; row < height; row++) {
+        text.append(&map[(size_t)row * width], width);
+        text += '\n';
+    }
+
+    text += '\n';
+    for (size_t p = 0; p < patterns.size(); p++) {
+        text += "GATE_" + PatternName((int)p) + " " + patterns[p] + "\n";
+    }
+    for (size_t i = 0; i < gates; i++) {
+        uint32_t index = candidates[i];
+        text += "ASSIGN_" + std::to_string(index % width) + "_" + std::to_string(index / width) + "_" +
+                PatternName((int)Uniform(rng, patterns.size())) + "\n";
+    }
+    int turnRange = params.temporalMaxTurns - params.temporalMinTurns + 1;
+    for (size_t i = gates; i < gates + temporals; i++) {
+        uint32_t index = candidates[i];
+        int turns = params.temporalMinTurns + (int)Uniform(rng, turnRange);
+        text += "TEMPORAL_" + std::to_string(index % width) + "_" + std::to_string(index / width) + "_" +
+                std::to_string(turns) + "\n";
+    }
+}
+
+bool LevelGenerator::Verify(const GeneratorParams& params, const std::string& text, int& optimalMoves) {
+    optimalMoves = -1;
+    LevelData levelData;
+    if (!FileLoader::LoadFromTXTBuffer("generado", text, levelData)) {
+        return false;
+    }
+
+    optimalMoves = LevelTables::ComputeShortestPathLength(levelData);
+    if (optimalMoves < 0) {
+        return false;
+    }
+    if (!params.verifyWithPathFinder) {
+        return true;
+    }
+
+    // Misma regla que el BFS, pero el auto-solve tiene límites propios: se corre el ARA* de ESPACIO con los de
+    // SolverLimits::AnytimeFor. La fecha límite no se aplica (dependería de la máquina y la misma semilla podría dar
+    // otro nivel), así que en una máquina muy lenta el juego todavía podría cortar antes del primer camino.
+    LevelTables::AttachGoalDistances(levelData);
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+    PathFinder pathFinder(&grid);
+    pathFinder.verbose = false;
+    SolverLimits limits = SolverLimits::AnytimeFor(grid);
+    limits.maxTimeMs = INT_MAX;
+    return !pathFinder.FindPathAnytime(limits, AnytimeSettings()).empty();
+}
+
+bool LevelGenerator::Generate(const GeneratorParams& params, GeneratedLevel& level) {
+    if (!ValidateParams(params)) {
+        return false;
+    }
+
+    for (int attempt = 0; attempt < params.maxAttempts; attempt++) {
+        uint64_t seed = params.seed + (uint64_t)attempt * 0x9E3779B97F4A7C15ull;
+        Build(params, seed, level.text);
+        level.attempts = attempt + 1;
+        if (Verify(params, level.text, level.optimalMoves) || !params.requireSolvable) {
+            level.seedUsed = seed;
+            return true;
+        }
+    }
+
+    std::cout << "Generador: ningún intento de " << params.maxAttempts << " quedó resoluble" << std::endl;
+    level.text.clear();
+    level.optimalMoves = -1;
+    return false;
+}
+
+bool LevelGenerator::GenerateToFile(const GeneratorParams& params, const std::string& filename, GeneratedLevel& level) {
+    if (!Generate(params, level)) {
+        return false;
+    }
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "No se pudo crear el archivo: " << filename << std::endl;
+        return false;
+    }
+    file.write(level.text.data(), (std::streamsize)level.text.size());
+    if (!file) {
+        std::cout << "Error escribiendo: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,40 @@
+// LevelGenerator.h, generador procedural de niveles en el formato .txt que lee FileLoader.
+// Talla primero un corredor de inicio a meta y verifica con el solver que haya un camino factible en el tiempo.
+#pragma once
+#include <cstdint>
+#include <string>
+
+struct GeneratorParams {
+    int width = 32, height = 24;
+    int wallPercent = 25;               // Paredes fijas fuera del corredor
+    int patternCount = 3;               // GATE_A, GATE_B, ...
+    int gatePeriod = 8;                 // Largo de cada patrón y del ciclo de turnos
+    int gateCount = 20;
+    int temporalCount = 10;
+    int temporalMinTurns = 2, temporalMaxTurns = 20;
+    int itemCount = 3;
+    int corridorObstaclePercent = 10;   // Parte del corredor que puede tener compuertas o paredes temporales
+    uint64_t seed = 1;
+    int maxAttempts = 32;
+    bool verifyWithPathFinder = true;   // Además del BFS por turnos, exige camino del ARA* de ESPACIO con sus límites
+    bool requireSolvable = true;        // false: devuelve el primer intento aunque no tenga camino (fuzzing)
+};
+
+struct GeneratedLevel {
+    std::string text;                   // Contenido del .txt
+    int optimalMoves = -1;              // Con la regla de los solvers (LevelTables), -1 si no hay camino
+    int attempts = 0;
+    uint64_t seedUsed = 0;              // Semilla del intento que pasó la verificación
+};
+
+class LevelGenerator {
+public:
+    // false si los parámetros son inválidos o ningún intento quedó resoluble
+    static bool Generate(const GeneratorParams& params, GeneratedLevel& level);
+    static bool GenerateToFile(const GeneratorParams& params, const std::string& filename, GeneratedLevel& level);
+
+private:
+    static bool ValidateParams(const GeneratorParams& params);
+    static void Build(const GeneratorParams& params, uint64_t seed, std::string& text);
+    static bool Verify(const GeneratorParams& params, const std::string& text, int& optimalMoves);
+};
@@ -0,0 +1,227 @@
+// LevelPack.cpp, escritura del paquete .etgp y carga perezosa de cada nivel desde el archivo mapeado
+#include "LevelPack.h"
+#include "LevelBinary.h"
+#include "LevelTables.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+
+void AlignTo8(std::vector<unsigned char>& out) {
+    while (out.size() % 8 != 0) out.push_back(0);
+}
+
+bool EndsWith(const std::string& text, const char* suffix) {
+    size_t length = std::strlen(suffix);
+    return text.size() >= length && text.compare(text.size() - length, length, suffix) == 0;
+}
+
+} // namespace
+
+bool LevelPack::Write(const std::vector<LevelPackSource>& sources, const std::string& filename) {
+    std::vector<EtgpEntry> index;
+    std::string names;
+    std::vector<std::string> texts;
+    index.reserve(sources.size());
+    texts.reserve(sources.size());
+
+    for (const LevelPackSource& source : sources) {
+        EtgpEntry entry = {};
+        if (EndsWith(source.filename, ".txt")) {
+            entry.format = ETGP_FORMAT_TXT;
+        } else if (EndsWith(source.filename, ".json")) {
+            entry.format = ETGP_FORMAT_JSON;
+        } else {
+            std::cout << source.filename << ": solo se empaquetan niveles .txt o .json" << std::endl;
+            return false;
+        }
+
+        std::ifstream input(source.filename, std::ios::binary);
+        if (!input.is_open()) {
+            std::cout << "No se pudo abrir el archivo: " << source.filename << std::endl;
+            return false;
+        }
+        std::ostringstream buffer;
+        buffer << input.rdbuf();
+        std::string text = buffer.str();
+
+        // Se parsea igual que en el juego: un nivel inválido no entra al paquete
+        LevelData levelData;
+        bool parsed = entry.format == ETGP_FORMAT_JSON
+            ? FileLoader::LoadFromJSONBuffer(source.filename, text, levelData)
+            : FileLoader::LoadFromTXTBuffer(source.filename, text, levelData);
+        if (!parsed) {
+            return false;
+        }
+
+        entry.size = text.size();
+        entry.contentHash = LevelBinary::Checksum(reinterpret_cast<const unsigned char*>(text.data()), text.size());
+        entry.nameOffset = (uint32_t)names.size();
+        entry.nameLength = (uint32_t)source.name.size();
+        entry.width = levelData.width;
+        entry.height = levelData.height;
+        entry.optimalMoves = LevelTables::ComputeShortestPathLength(levelData);
+        entry.itemCount = (uint32_t)levelData.items.size();
+        entry.gateCount = (uint32_t)levelData.gateAssignments.size();
+        entry.temporalCount = (uint32_t)levelData.temporalWalls.size();
+        names += source.name;
+
+        std::cout << "  " << source.name << ": " << levelData.width << "x" << levelData.height << ", ";
+        if (entry.optimalMoves == ETGP_NO_SOLUTION) {
+            std::cout << "sin solución" << std::endl;
+        } else {
+            std::cout << "óptimo " << entry.optimalMoves << " movimientos" << std::endl;
+        }
+
+        index.push_back(entry);
+        texts.push_back(std::move(text));
+    }
+
+    EtgpHeader header = {};
+    std::memcpy(header.magic, "ETGP", 4);
+    header.version = ETGP_VERSION;
+    header.levelCount = (uint32_t)index.size();
+
+    // Encabezado, índice y nombres van juntos al inicio: el menú solo necesita esas páginas
+    std::vector<unsigned char> out(sizeof(EtgpHeader), 0);
+    header.indexOffset = out.size();
+    out.resize(out.size() + index.size() * sizeof(EtgpEntry));
+    header.namesOffset = out.size();
+    header.namesSize = names.size();
+    out.insert(out.end(), names.begin(), names.end());
+
+    for (size_t i = 0; i < index.size(); i++) {
+        AlignTo8(out);
+        index[i].offset = out.size();
+        out.insert(out.end(), texts[i].begin(), texts[i].end());
+    }
+    AlignTo8(out);
+
+    std::memcpy(out.data() + header.indexOffset, index.data(), index.size() * sizeof(EtgpEntry));
+    header.fileSize = out.size();
+    header.indexChecksum = LevelBinary::Checksum(out.data() + header.indexOffset,
+                                                 header.namesOffset + header.namesSize - header.indexOffset);
+    std::memcpy(out.data(), &header, sizeof(EtgpHeader));
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "No se pudo crear el archivo: " << filename << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(out.data()), (std::streamsize)out.size());
+    if (!file) {
+        std::cout << "Error escribiendo: " << filename << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+bool LevelPack::Open(const std::string& packFile) {
+    file = std::make_shared<MappedFile>();
+    filename = packFile;
+    header = nullptr;
+    entries = nullptr;
+    names = nullptr;
+
+    if (!file->Open(packFile)) {
+        return false;
+    }
+
+    if (file->Size() < sizeof(EtgpHeader)) {
+        std::cout << packFile << ": archivo .etgp truncado" << std::endl;
+        return false;
+    }
+
+    const EtgpHeader* candidate = reinterpret_cast<const EtgpHeader*>(file->Data());
+    if (std::memcmp(candidate->magic, "ETGP", 4) != 0) {
+        std::cout << packFile << ": no es un paquete .etgp" << std::endl;
+        return false;
+    }
+    if (candidate->version != ETGP_VERSION) {
+        std::cout << packFile << ": versión .etgp " << candidate->version
+                  << " no soportada (se esperaba " << ETGP_VERSION << ")" << std::endl;
+        return false;
+    }
+
+    header = candidate;
+    if (!ValidateIndex()) {
+        header = nullptr;
+        return false;
+    }
+
+    entries = reinterpret_cast<const EtgpEntry*>(file->Data() + header->indexOffset);
+    names = reinterpret_cast<const char*>(file->Data() + header->namesOffset);
+    std::cout << "Paquete de niveles: " << packFile << " (" << header->levelCount << " niveles)" << std::endl;
+    return true;
+}
+
+bool LevelPack::ValidateIndex() const {
+    uint64_t size = file->Size();
+    const EtgpHeader& h = *header;
+
+    bool ok = h.fileSize == size && h.indexOffset % 8 == 0 && h.indexOffset <= size &&
+              h.levelCount <= (size - h.indexOffset) / sizeof(EtgpEntry) &&
+              h.namesOffset == h.indexOffset + (uint64_t)h.levelCount * sizeof(EtgpEntry) &&
+              h.namesSize <= size - h.namesOffset;
+
+    if (ok) {
+        uint64_t checksum = LevelBinary::Checksum(file->Data() + h.indexOffset, h.namesOffset + h.namesSize - h.indexOffset);
+        if (checksum != h.indexChecksum) {
+            std::cout << filename << ": checksum del índice inválido, el paquete está corrupto" << std::endl;
+            return false;
+        }
+    }
+
+    // Con el índice íntegro basta revisar que cada entrada caiga dentro del archivo
+    const EtgpEntry* index = reinterpret_cast<const EtgpEntry*>(file->Data() + h.indexOffset);
+    for (uint32_t i = 0; ok && i < h.levelCount; i++) {
+        ok = index[i].offset <= size && index[i].size <= size - index[i].offset &&
+             (uint64_t)index[i].nameOffset + index[i].nameLength <= h.namesSize &&
+             (index[i].format == ETGP_FORMAT_TXT || index[i].format == ETGP_FORMAT_JSON);
+    }
+
+    if (!ok) {
+        std::cout << filename << ": índice del .etgp fuera de rango" << std::endl;
+    }
+    return ok;
+}
+
+std::string_view LevelPack::Name(size_t index) const {
+    return std::string_view(names + entries[index].nameOffset, entries[index].nameLength);
+}
+
+int LevelPack::FindLevel(std::string_view name) const {
+    for (size_t i = 0; i < LevelCount(); i++) {
+        if (Name(i) == name) return (int)i;
+    }
+    return -1;
+}
+
+bool LevelPack::LoadLevel(size_t index, LevelData& levelData, const std::atomic<bool>* cancel) const {
+    if (!IsOpen() || index >= LevelCount()) {
+        std::cout << filename << ": nivel " << index << " no existe en el paquete" << std::endl;
+        return false;
+    }
+
+    const EtgpEntry& entry = entries[index];
+    const unsigned char* data = file->Data() + entry.offset;
+    if (LevelBinary::Checksum(data, entry.size) != entry.contentHash) {
+        std::cout << filename << ": el nivel '" << Name(index) << "' está corrupto (hash distinto)" << std::endl;
+        return false;
+    }
+
+    std::string sourceName = filename + "#" + std::string(Name(index));
+    std::string_view text(reinterpret_cast<const char*>(data), entry.size);
+    bool ok = entry.format == ETGP_FORMAT_JSON
+        ? FileLoader::LoadFromJSONBuffer(sourceName, text, levelData, cancel)
+        : FileLoader::LoadFromTXTBuffer(sourceName, text, levelData, cancel);
+    if (!ok) {
+        return false;
+    }
+
+    std::cout << "Nivel cargado del paquete: " << sourceName << " (" << levelData.width << "x" << levelData.height << ")" << std::endl;
+    return true;
+}
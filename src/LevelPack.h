@@ -0,0 +1,74 @@
+// LevelPack.h, paquete de niveles .etgp: un solo archivo con índice al inicio y los niveles fuente después
+#pragma once
+#include "FileLoader.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Mismo criterio que el .etgl: secciones alineadas a 8 bytes, little-endian
+const uint32_t ETGP_VERSION = 1;
+const uint32_t ETGP_FORMAT_TXT = 0;
+const uint32_t ETGP_FORMAT_JSON = 1;
+const int32_t ETGP_NO_SOLUTION = -1;
+
+struct EtgpHeader {
+    char magic[4];              // "ETGP"
+    uint32_t version;
+    uint32_t levelCount;
+    uint32_t reserved;
+    uint64_t fileSize;
+    uint64_t indexOffset;       // levelCount entradas EtgpEntry
+    uint64_t namesOffset;
+    uint64_t namesSize;
+    uint64_t indexChecksum;     // FNV-1a 64 del índice y los nombres (los niveles llevan su propio hash)
+};
+
+struct EtgpEntry {
+    uint64_t offset;            // Texto fuente del nivel dentro del paquete
+    uint64_t size;
+    uint64_t contentHash;       // FNV-1a 64 del texto fuente
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t format;            // ETGP_FORMAT_TXT o ETGP_FORMAT_JSON
+    int32_t width, height;
+    int32_t optimalMoves;       // Camino mínimo precalculado o ETGP_NO_SOLUTION
+    uint32_t itemCount;
+    uint32_t gateCount;
+    uint32_t temporalCount;
+    uint32_t reserved;
+};
+
+struct LevelPackSource {
+    std::string filename;
+    std::string name;           // Nombre que muestra el menú
+};
+
+class LevelPack {
+public:
+    // Parsea cada nivel para validar y calcular los metadatos, y escribe el paquete
+    static bool Write(const std::vector<LevelPackSource>& sources, const std::string& filename);
+
+    // Solo mapea el archivo y valida el índice; ningún nivel se lee hasta pedirlo
+    bool Open(const std::string& filename);
+    bool IsOpen() const { return header != nullptr; }
+
+    size_t LevelCount() const { return header ? header->levelCount : 0; }
+    const EtgpEntry& Entry(size_t index) const { return entries[index]; }
+    std::string_view Name(size_t index) const;
+    int FindLevel(std::string_view name) const;
+
+    // Verifica el hash del nivel y lo decodifica con el parser de su formato (cancel: ver FileLoader)
+    bool LoadLevel(size_t index, LevelData& levelData, const std::atomic<bool>* cancel = nullptr) const;
+
+private:
+    std::shared_ptr<MappedFile> file;
+    std::string filename;
+    const EtgpHeader* header = nullptr;
+    const EtgpEntry* entries = nullptr;
+    const char* names = nullptr;
+
+    bool ValidateIndex() const;
+};
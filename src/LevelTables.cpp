@@ -0,0 +1,189 @@
+// LevelTables.cpp, adyacencia, campo de distancias a la meta (BFS inverso sobre el mapa estático) y camino mínimo con tiempo
+#include "LevelTables.h"
+#include "HexDirections.h"
+#include <algorithm>
+#include <memory>
+
+bool LevelTables::IsStaticWall(const LevelData& levelData, int x, int y) {
+    return levelData.CellAt(x, y) == '#';
+}
+
+std::vector<uint8_t> LevelTables::ComputeAdjacency(const LevelData& levelData) {
+    int width = levelData.width;
+    int height = levelData.height;
+    std::vector<uint8_t> adjacency((size_t)width * height, 0);
+    
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const int (*offsets)[2] = HexOffsetsForColumn(x);
+            uint8_t mask = 0;
+            for (int i = 0; i < 6; i++) {
+                int nx = x + offsets[i][0];
+                int ny = y + offsets[i][1];
+                if (nx >= 0 && nx < width && ny >= 0 && ny < height && !IsStaticWall(levelData, nx, ny)) {
+                    mask |= (uint8_t)(1 << i);
+                }
+            }
+            adjacency[(size_t)y * width + x] = mask;
+        }
+    }
+    
+    return adjacency;
+}
+
+std::vector<uint32_t> LevelTables::ComputeGoalDistances(const LevelData& levelData) {
+    int width = levelData.width;
+    int height = levelData.height;
+    std::vector<uint32_t> distance((size_t)width * height, UNREACHABLE);
+    
+    int goalX = levelData.goalX;
+    int goalY = levelData.goalY;
+    if (goalX < 0 || goalX >= width || goalY < 0 || goalY >= height) {
+        return distance;
+    }
+    
+    // La vecindad hexagonal es simétrica, así que un BFS desde la meta da la distancia hacia ella
+    std::vector<int> queue;
+    queue.reserve((size_t)width * height);
+    distance[(size_t)goalY * width + goalX] = 0;
+    queue.push_back(goalY * width + goalX);
+    
+    for (size_t head = 0; head < queue.size(); head++) {
+        int index = queue[head];
+        int x = index % width;
+        int y = index / width;
+        uint32_t next = distance[index] + 1;
+        
+        const int (*offsets)[2] = HexOffsetsForColumn(x);
+        for (int i = 0; i < 6; i++) {
+            int nx = x + offsets[i][0];
+            int ny = y + offsets[i][1];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+            
+            int neighborIndex = ny * width + nx;
+            if (distance[neighborIndex] != UNREACHABLE || IsStaticWall(levelData, nx, ny)) continue;
+            
+            distance[neighborIndex] = next;
+            queue.push_back(neighborIndex);
+        }
+    }
+    
+    return distance;
+}
+
+void LevelTables::AttachGoalDistances(LevelData& levelData) {
+    if (levelData.goalDistance != nullptr) {
+        return;
+    }
+    
+    // El almacenamiento anterior (p. ej. el .etgl mapeado con la adyacencia) sigue vivo junto al nuevo
+    struct Storage {
+        std::shared_ptr<const void> previous;
+        std::vector<uint32_t> distances;
+    };
+    auto storage = std::make_shared<Storage>();
+    storage->previous = levelData.tableStorage;
+    storage->distances = ComputeGoalDistances(levelData);
+    
+    levelData.goalDistance = storage->distances.data();
+    levelData.tableStorage = storage;
+}
+
+int LevelTables::ComputeShortestPathLength(const LevelData& levelData) {
+    int width = levelData.width;
+    int height = levelData.height;
+    int cycle = levelData.turnCycleLength > 0 ? levelData.turnCycleLength : 1;
+    size_t cellCount = (size_t)width * height;
+    
+    auto inside = [&](int x, int y) { return x >= 0 && x < width && y >= 0 && y < height; };
+    if (!inside(levelData.startX, levelData.startY) || !inside(levelData.goalX, levelData.goalY)) {
+        return -1;
+    }
+    
+    // Estado dinámico por celda, igual que lo arma Grid::LoadFromLevelData (los items dejan la celda libre)
+    std::vector<const std::vector<bool>*> gatePattern(cellCount, nullptr);
+    std::vector<int> openTurn(cellCount, 0);
+    std::vector<bool> blocked(cellCount, false);
+    int lastOpening = 0;
+    
+    for (size_t i = 0; i < cellCount; i++) {
+        blocked[i] = levelData.cells[i] == '#';
+    }
+    for (const GateAssignment& gate : levelData.gateAssignments) {
+        size_t index = (size_t)gate.y * width + gate.x;
+        auto pattern = levelData.gatePatterns.find(gate.pattern);
+        gatePattern[index] = pattern != levelData.gatePatterns.end() ? &pattern->second : nullptr;
+        blocked[index] = false;
+    }
+    for (const TemporalWall& wall : levelData.temporalWalls) {
+        size_t index = (size_t)wall.y * width + wall.x;
+        gatePattern[index] = nullptr;
+        openTurn[index] = wall.turns;
+        blocked[index] = false;
+        lastOpening = std::max(lastOpening, wall.turns);
+    }
+    for (const auto& item : levelData.items) {
+        if (!inside(item.first, item.second)) continue;
+        size_t index = (size_t)item.second * width + item.first;
+        gatePattern[index] = nullptr;
+        openTurn[index] = 0;
+        blocked[index] = false;
+    }
+    
+    auto isOpen = [&](size_t index, int turn) {
+        if (blocked[index] || turn < openTurn[index]) return false;
+        const std::vector<bool>* pattern = gatePattern[index];
+        return pattern == nullptr || GateOpenAtPhase(*pattern, turn % cycle);
+    };
+    
+    int start = levelData.startY * width + levelData.startX;
+    int goal = levelData.goalY * width + levelData.goalX;
+    if (start == goal) {
+        return 0;
+    }
+    
+    // BFS por capas de turno (no se puede esperar en el lugar). Desde 'lastOpening' el mapa solo
+    // depende de turno % ciclo, así que cada (celda, fase) se expande una vez y la búsqueda termina.
+    std::vector<int> frontier{start}, next;
+    std::vector<int> stamp(cellCount, -1);
+    std::vector<bool> seenPhase;
+    
+    for (int turn = 0; !frontier.empty(); turn++) {
+        bool periodic = turn + 1 >= lastOpening;
+        if (periodic && seenPhase.empty()) {
+            seenPhase.assign(cellCount * cycle, false);
+        }
+        int nextPhase = (turn + 1) % cycle;
+        next.clear();
+        
+        for (int index : frontier) {
+            int x = index % width;
+            int y = index / width;
+            const int (*offsets)[2] = HexOffsetsForColumn(x);
+            
+            for (int i = 0; i < 6; i++) {
+                int nx = x + offsets[i][0];
+                int ny = y + offsets[i][1];
+                if (!inside(nx, ny)) continue;
+                
+                int neighbor = ny * width + nx;
+                if (stamp[neighbor] == turn + 1 || !isOpen(neighbor, turn + 1)) continue;
+                if (periodic) {
+                    size_t state = (size_t)neighbor * cycle + nextPhase;
+                    if (seenPhase[state]) continue;
+                    seenPhase[state] = true;
+                }
+                
+                if (neighbor == goal) {
+                    return turn + 1;
+                }
+                stamp[neighbor] = turn + 1;
+                next.push_back(neighbor);
+            }
+        }
+        
+        frontier.swap(next);
+    }
+    
+    return -1;
+}
@@ -0,0 +1,35 @@
+// LevelTables.h, tablas precalculadas para los solvers a partir de un LevelData
+#pragma once
+#include "FileLoader.h"
+#include <cstdint>
+#include <vector>
+
+class LevelTables {
+public:
+    static constexpr uint32_t UNREACHABLE = 0xFFFFFFFFu;
+    
+    // La regla de compuertas de todos los solvers: las fases que un patrón corto no cubre repiten la última,
+    // que es como queda Grid::UpdateGatesAndWalls al avanzar el turno. Patrón vacío: abierta.
+    static bool GateOpenAtPhase(const std::vector<bool>& phases, int phase) {
+        int last = (int)phases.size() - 1;
+        return last < 0 || phases[phase < last ? phase : last];
+    }
+    
+    // Celdas que nunca se pueden pisar (paredes permanentes)
+    static bool IsStaticWall(const LevelData& levelData, int x, int y);
+    
+    // Máscara de 6 bits por celda: bit i = el vecino en la dirección i existe y no es pared
+    static std::vector<uint8_t> ComputeAdjacency(const LevelData& levelData);
+    
+    // Distancia mínima en movimientos hasta la meta ignorando compuertas y paredes temporales.
+    // Es una cota inferior del camino real, por eso sirve como heurística admisible.
+    static std::vector<uint32_t> ComputeGoalDistances(const LevelData& levelData);
+    
+    // Calcula el campo de distancias y lo cuelga del LevelData (no hace nada si ya trae uno)
+    static void AttachGoalDistances(LevelData& levelData);
+    
+    // Mínimo de movimientos hasta la meta respetando compuertas y paredes temporales, con la regla de
+    // PathFinder::IsValidMoveAtTurn (la celda destino debe estar abierta en el turno de llegada), para que el
+    // óptimo del menú coincida con etg-solve y el auto-solve. -1 si no hay camino.
+    static int ComputeShortestPathLength(const LevelData& levelData);
+};
@@ -0,0 +1,296 @@
+// LevelWatcher.cpp, inotify + poll en un hilo propio; en otras plataformas Start() solo avisa y falla
+#include "LevelWatcher.h"
+#include "Grid.h"
+#include "LevelTables.h"
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// Lo que define a una celda en el LevelData, igual que lo interpreta Grid::LoadFromLevelData
+struct CellSpec {
+    char cellChar;
+    const GateAssignment* gate;
+    const TemporalWall* temporal;
+    bool item;
+};
+
+CellSpec SpecAt(const LevelData& levelData, int x, int y, const std::vector<bool>& items) {
+    return {levelData.CellAt(x, y), levelData.FindGate(x, y), levelData.FindTemporalWall(x, y),
+            items[(size_t)y * levelData.width + x]};
+}
+
+std::vector<bool> ItemMask(const LevelData& levelData) {
+    std::vector<bool> mask((size_t)levelData.width * levelData.height, false);
+    for (const auto& item : levelData.items) {
+        if (item.first >= 0 && item.first < levelData.width && item.second >= 0 && item.second < levelData.height) {
+            mask[(size_t)item.second * levelData.width + item.first] = true;
+        }
+    }
+    return mask;
+}
+
+const std::vector<bool>* PatternBits(const LevelData& levelData, const GateAssignment* gate) {
+    if (gate == nullptr) return nullptr;
+    auto pattern = levelData.gatePatterns.find(gate->pattern);
+    return pattern != levelData.gatePatterns.end() ? &pattern->second : nullptr;
+}
+
+bool SameCell(const LevelData& before, const CellSpec& a, const LevelData& after, const CellSpec& b) {
+    if (a.cellChar != b.cellChar || a.item != b.item) return false;
+    if ((a.gate == nullptr) != (b.gate == nullptr) || (a.temporal == nullptr) != (b.temporal == nullptr)) return false;
+    if (a.temporal && a.temporal->turns != b.temporal->turns) return false;
+    if (a.gate) {
+        // Grid busca el patrón por nombre, así que un renombre también cuenta como cambio
+        const std::vector<bool>* bitsA = PatternBits(before, a.gate);
+        const std::vector<bool>* bitsB = PatternBits(after, b.gate);
+        if (a.gate->pattern != b.gate->pattern) return false;
+        if ((bitsA == nullptr) != (bitsB == nullptr) || (bitsA && *bitsA != *bitsB)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+void LevelDiff::Merge(const LevelDiff& other) {
+    sizeChanged = sizeChanged || other.sizeChanged;
+    startChanged = startChanged || other.startChanged;
+    goalChanged = goalChanged || other.goalChanged;
+    staticWallsChanged = staticWallsChanged || other.staticWallsChanged;
+    cells.insert(cells.end(), other.cells.begin(), other.cells.end());
+}
+
+LevelDiff LevelDiff::Compute(const LevelData& before, const LevelData& after) {
+    LevelDiff diff;
+    if (before.width != after.width || before.height != after.height) {
+        diff.sizeChanged = true;
+        diff.staticWallsChanged = true;
+        return diff;
+    }
+
+    diff.startChanged = before.startX != after.startX || before.startY != after.startY;
+    diff.goalChanged = before.goalX != after.goalX || before.goalY != after.goalY;
+    if (before.turnCycleLength != after.turnCycleLength) {
+        // El ciclo cambia la fase de todas las compuertas
+        for (const GateAssignment& gate : after.gateAssignments) diff.cells.push_back({gate.x, gate.y});
+    }
+
+    std::vector<bool> itemsBefore = ItemMask(before);
+    std::vector<bool> itemsAfter = ItemMask(after);
+
+    for (int y = 0; y < after.height; y++) {
+        for (int x = 0; x < after.width; x++) {
+            CellSpec a = SpecAt(before, x, y, itemsBefore);
+            CellSpec b = SpecAt(after, x, y, itemsAfter);
+            if (!SameCell(before, a, after, b)) {
+                diff.cells.push_back({x, y});
+                if ((a.cellChar == '#') != (b.cellChar == '#')) {
+                    diff.staticWallsChanged = true;
+                }
+            }
+        }
+    }
+
+    if (diff.goalChanged) {
+        diff.staticWallsChanged = true;
+    }
+    return diff;
+}
+
+LevelWatcher::LevelWatcher()
+    : running(false), hasPending(false), inotifyFd(-1), watchDescriptor(-1) {}
+
+LevelWatcher::~LevelWatcher() {
+    Stop();
+}
+
+bool LevelWatcher::Start() {
+#ifdef __linux__
+    if (running.load()) {
+        return true;
+    }
+
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotifyFd < 0) {
+        std::cout << "Recarga en caliente: no se pudo iniciar inotify" << std::endl;
+        return false;
+    }
+
+    running.store(true);
+    thread = std::thread(&LevelWatcher::Run, this);
+    std::cout << "Recarga en caliente activada" << std::endl;
+    return true;
+#else
+    std::cout << "Recarga en caliente solo disponible en Linux (inotify)" << std::endl;
+    return false;
+#endif
+}
+
+void LevelWatcher::Stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+#ifdef __linux__
+    close(inotifyFd);
+#endif
+    inotifyFd = -1;
+    watchDescriptor = -1;
+}
+
+void LevelWatcher::Watch(const std::string& filename, std::shared_ptr<const LevelData> levelData) {
+    std::lock_guard<std::mutex> lock(mutex);
+    watchedFile = filename;
+    baseline = std::move(levelData);
+    hasPending = false;
+
+#ifdef __linux__
+    if (!running.load()) {
+        return;
+    }
+
+    // Se vigila la carpeta y no el archivo: los editores suelen guardar con un archivo temporal + rename
+    size_t slash = filename.find_last_of('/');
+    std::string directory = slash == std::string::npos ? "." : filename.substr(0, slash);
+    if (watchDescriptor >= 0) {
+        inotify_rm_watch(inotifyFd, watchDescriptor);
+    }
+    watchDescriptor = inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (watchDescriptor < 0) {
+        std::cout << "Recarga en caliente: no se pudo vigilar " << directory << std::endl;
+    }
+#endif
+}
+
+bool LevelWatcher::TakeReload(LevelReload& out) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasPending) {
+        return false;
+    }
+    out = std::move(pending);
+    pending = LevelReload();
+    hasPending = false;
+    return true;
+}
+
+void LevelWatcher::Run() {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+
+    // Lee todos los eventos pendientes; true si alguno toca el archivo vigilado
+    auto drainEvents = [&]() {
+        std::string file;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            size_t slash = watchedFile.find_last_of('/');
+            file = slash == std::string::npos ? watchedFile : watchedFile.substr(slash + 1);
+        }
+
+        bool touched = false;
+        ssize_t length;
+        while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+            for (char* ptr = buffer; ptr < buffer + length;) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+                if (event->len > 0 && file == event->name) {
+                    touched = true;
+                }
+                ptr += sizeof(inotify_event) + event->len;
+            }
+        }
+        return touched;
+    };
+
+    while (running.load()) {
+        pollfd descriptor = {inotifyFd, POLLIN, 0};
+        if (poll(&descriptor, 1, 100) <= 0) {
+            continue;
+        }
+
+        bool touched = drainEvents();
+        // Un guardado suele generar varios eventos seguidos: se juntan antes de reparsear
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        touched = drainEvents() || touched;
+
+        if (touched) {
+            Reload();
+        }
+    }
+#endif
+}
+
+void LevelWatcher::Reload() {
+    std::string filename;
+    std::shared_ptr<const LevelData> previous;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        filename = watchedFile;
+        previous = baseline;
+    }
+    if (filename.empty() || previous == nullptr) {
+        return;
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    auto levelData = std::make_shared<LevelData>();
+    if (!FileLoader::LoadLevel(filename, *levelData)) {
+        // Un archivo a medio editar no rompe la partida: se sigue con la versión anterior
+        std::cout << "Recarga en caliente: " << filename << " tiene errores, se mantiene la versión anterior" << std::endl;
+        return;
+    }
+
+    LevelDiff diff = LevelDiff::Compute(*previous, *levelData);
+    if (diff.Empty()) {
+        return;
+    }
+
+    // Campo de distancias: se reutiliza si ni las paredes ni la meta cambiaron (y si el nivel nuevo no trae su
+    // propio almacenamiento, como la adyacencia de un .etgl, que se perdería al pisar tableStorage)
+    if (!diff.staticWallsChanged && previous->goalDistance != nullptr && levelData->goalDistance == nullptr &&
+        levelData->tableStorage == nullptr) {
+        levelData->goalDistance = previous->goalDistance;
+        levelData->tableStorage = previous->tableStorage;
+    } else {
+        LevelTables::AttachGoalDistances(*levelData);
+    }
+    
+    // La tabla de turnos a la meta es O(celdas × (ciclo + turnos transitorios)): también se arma acá y no con la
+    // simulación parada. Solo depende de tipos, patrones y paredes temporales, así que sale igual del nivel nuevo.
+    // Si cambió el tamaño el juego rearma todo con PrepareLevel y no hace falta.
+    std::unique_ptr<TimeToGoalTable> timeToGoal;
+    if (!diff.sizeChanged) {
+        Grid grid(1, 1);
+        grid.LoadFromLevelData(*levelData);
+        timeToGoal = std::make_unique<TimeToGoalTable>();
+        timeToGoal->Build(grid);
+    }
+
+    auto endTime = std::chrono::steady_clock::now();
+    std::cout << "Recarga en caliente: " << filename << " (" << diff.cells.size() << " celdas cambiadas, "
+              << std::chrono::duration<double, std::milli>(endTime - startTime).count() << " ms)" << std::endl;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (filename != watchedFile) {
+        return; // Se cambió de nivel mientras se parseaba
+    }
+    baseline = levelData;
+    if (hasPending) {
+        // La recarga anterior todavía no se aplicó: el diff acumulado cubre ambas
+        pending.diff.Merge(diff);
+        pending.levelData = levelData;
+        pending.timeToGoal = std::move(timeToGoal);
+    } else {
+        pending.filename = filename;
+        pending.levelData = levelData;
+        pending.diff = std::move(diff);
+        pending.timeToGoal = std::move(timeToGoal);
+        hasPending = true;
+    }
+}
@@ -0,0 +1,69 @@
+// LevelWatcher.h, recarga en caliente: vigila el archivo del nivel actual (inotify en Linux),
+// lo vuelve a parsear en un hilo aparte y entrega el nivel nuevo junto con las celdas que cambiaron
+#pragma once
+#include "FileLoader.h"
+#include "TimeToGoalTable.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Diferencias entre dos versiones del mismo nivel
+struct LevelDiff {
+    bool sizeChanged = false;           // Cambió el tamaño: no hay diff por celda, se rearma todo
+    bool startChanged = false;
+    bool goalChanged = false;
+    bool staticWallsChanged = false;    // Hay que recalcular el campo de distancias
+    std::vector<std::pair<int, int>> cells;
+
+    bool Empty() const { return !sizeChanged && !startChanged && !goalChanged && cells.empty(); }
+    void Merge(const LevelDiff& other);
+
+    // Compara celda por celda (tipo, compuerta con su patrón, pared temporal, item)
+    static LevelDiff Compute(const LevelData& before, const LevelData& after);
+};
+
+struct LevelReload {
+    std::string filename;
+    std::shared_ptr<const LevelData> levelData;
+    LevelDiff diff;
+    std::unique_ptr<TimeToGoalTable> timeToGoal;    // Ya armada en el hilo del watcher (nullptr si cambió el tamaño)
+};
+
+class LevelWatcher {
+public:
+    LevelWatcher();
+    ~LevelWatcher();
+
+    LevelWatcher(const LevelWatcher&) = delete;
+    LevelWatcher& operator=(const LevelWatcher&) = delete;
+
+    // false si la plataforma no tiene inotify
+    bool Start();
+    void Stop();
+    bool IsRunning() const { return running.load(); }
+
+    // Cambia el archivo vigilado; 'baseline' es la versión contra la que se calcula el diff
+    void Watch(const std::string& filename, std::shared_ptr<const LevelData> baseline);
+
+    // Lo llama el hilo principal cada frame; true si hay una recarga lista para aplicar
+    bool TakeReload(LevelReload& out);
+
+private:
+    std::atomic<bool> running;
+    std::thread thread;
+    std::mutex mutex;                   // Protege todo lo que sigue
+    std::string watchedFile;
+    std::shared_ptr<const LevelData> baseline;
+    bool hasPending;
+    LevelReload pending;
+
+    int inotifyFd;
+    int watchDescriptor;
+
+    void Run();
+    void Reload();
+};
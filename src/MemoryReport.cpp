@@ -0,0 +1,40 @@
+// MemoryReport.cpp
+#include "MemoryReport.h"
+#include <cstdio>
+
+void MemoryReport::Add(const std::string& subsystem, size_t bytes) {
+    for (auto& entry : entries) {
+        if (entry.first == subsystem) {
+            entry.second += bytes;
+            return;
+        }
+    }
+    entries.emplace_back(subsystem, bytes);
+}
+
+size_t MemoryReport::Bytes(const std::string& subsystem) const {
+    for (const auto& entry : entries) {
+        if (entry.first == subsystem) return entry.second;
+    }
+    return 0;
+}
+
+size_t MemoryReport::Total() const {
+    size_t total = 0;
+    for (const auto& entry : entries) {
+        total += entry.second;
+    }
+    return total;
+}
+
+void MemoryReport::Print(std::ostream& out) const {
+    size_t total = Total();
+    char line[128];
+    for (const auto& entry : entries) {
+        double percent = total > 0 ? 100.0 * entry.second / total : 0.0;
+        std::snprintf(line, sizeof(line), "  %-24s %10.1f KB  %5.1f%%\n", entry.first.c_str(), entry.second / 1024.0, percent);
+        out << line;
+    }
+    std::snprintf(line, sizeof(line), "  %-24s %10.1f KB\n", "total", total / 1024.0);
+    out << line;
+}
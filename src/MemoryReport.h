@@ -0,0 +1,24 @@
+// MemoryReport.h, cuánto ocupa cada subsistema de una partida: grid, tablas de compuertas, solver, historial
+// del jugador, tabla de turnos a la meta y lo que se copia para dibujar. Cada parte suma sus propios bytes
+// (capacidades de los vectores, no el heap real), así que es una cuenta aproximada pero comparable entre niveles.
+#pragma once
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+class MemoryReport {
+public:
+    // Suma bytes al subsistema (lo agrega al final la primera vez, para respetar el orden del reporte)
+    void Add(const std::string& subsystem, size_t bytes);
+
+    size_t Bytes(const std::string& subsystem) const;   // 0 si no está
+    size_t Total() const;
+
+    // Una línea por subsistema con KB y porcentaje del total
+    void Print(std::ostream& out) const;
+
+private:
+    std::vector<std::pair<std::string, size_t>> entries;
+};
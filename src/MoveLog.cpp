@@ -0,0 +1,100 @@
+// MoveLog.cpp, codificación de pasos en 3 bits con checkpoints para acceso aleatorio
+#include "MoveLog.h"
+#include "HexDirections.h"
+
+MoveLog::MoveLog() : count(0), startX(0), startY(0), lastX(0), lastY(0) {}
+
+void MoveLog::Clear(int x, int y) {
+    words.clear();
+    checkpoints.clear();
+    jumps.clear();
+    count = 1;
+    startX = lastX = x;
+    startY = lastY = y;
+    checkpoints.push_back({x, y, 0});
+}
+
+void MoveLog::Append(int x, int y) {
+    if (count == 0) {
+        Clear(x, y);
+        return;
+    }
+
+    int code;
+    if (x == lastX && y == lastY) {
+        code = CODE_STAY;
+    } else {
+        code = HexDirectionBetween(lastX, lastY, x, y);
+        if (code < 0) {
+            code = CODE_JUMP;
+            jumps.push_back({x, y});
+        }
+    }
+
+    PushCode(code);
+    lastX = x;
+    lastY = y;
+    count++;
+
+    if (count % CHECKPOINT_INTERVAL == 1) {
+        checkpoints.push_back({x, y, (int)jumps.size()});
+    }
+}
+
+void MoveLog::PushCode(int code) {
+    int step = count - 1;
+    int word = step / CODES_PER_WORD;
+    int shift = (step % CODES_PER_WORD) * 3;
+
+    if (word >= static_cast<int>(words.size())) {
+        words.push_back(0);
+    }
+    words[word] |= (uint64_t)code << shift;
+}
+
+int MoveLog::GetCode(int step) const {
+    int word = step / CODES_PER_WORD;
+    int shift = (step % CODES_PER_WORD) * 3;
+    return (int)((words[word] >> shift) & 0x7);
+}
+
+void MoveLog::ApplyCode(int code, int& x, int& y, size_t& jumpIndex) const {
+    if (code == CODE_STAY) {
+        return;
+    }
+    if (code == CODE_JUMP) {
+        x = jumps[jumpIndex].first;
+        y = jumps[jumpIndex].second;
+        jumpIndex++;
+        return;
+    }
+    const int (*offsets)[2] = HexOffsetsForColumn(x);
+    x += offsets[code][0];
+    y += offsets[code][1];
+}
+
+void MoveLog::GetPosition(int index, int& outX, int& outY) const {
+    if (index < 0 || index >= count) {
+        outX = lastX;
+        outY = lastY;
+        return;
+    }
+
+    // Partir del checkpoint más cercano y reproducir como máximo CHECKPOINT_INTERVAL pasos
+    const Checkpoint& cp = checkpoints[index / CHECKPOINT_INTERVAL];
+    int px = cp.x, py = cp.y;
+    size_t jumpIndex = cp.jumpIndex;
+
+    for (int i = (index / CHECKPOINT_INTERVAL) * CHECKPOINT_INTERVAL + 1; i <= index; i++) {
+        ApplyCode(GetCode(i - 1), px, py, jumpIndex);
+    }
+
+    outX = px;
+    outY = py;
+}
+
+size_t MoveLog::MemoryBytes() const {
+    return words.capacity() * sizeof(uint64_t) +
+           checkpoints.capacity() * sizeof(Checkpoint) +
+           jumps.capacity() * sizeof(std::pair<int, int>);
+}
@@ -0,0 +1,57 @@
+// MoveLog.h, historial compacto de movimientos: 3 bits por paso con acceso aleatorio a posiciones
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+class MoveLog {
+public:
+    // Códigos de paso: 0-5 son direcciones hexagonales (ver HexDirections.h)
+    static const int CODE_STAY = 6;   // Se queda en la misma celda
+    static const int CODE_JUMP = 7;   // Salto no adyacente, la posición se guarda aparte
+
+    MoveLog();
+
+    // Reinicia el log con la posición inicial, conserva la memoria reservada
+    void Clear(int startX, int startY);
+    void Append(int x, int y);
+
+    int Size() const { return count; }
+    bool Empty() const { return count == 0; }
+    void GetPosition(int index, int& outX, int& outY) const;
+    int GetCode(int step) const;
+
+    // Recorre todas las posiciones en orden sin pagar el costo del acceso aleatorio
+    template <typename Fn>
+    void ForEach(Fn fn) const {
+        if (count == 0) return;
+        int px = startX, py = startY;
+        size_t jumpIndex = 0;
+        fn(0, px, py);
+        for (int i = 1; i < count; i++) {
+            ApplyCode(GetCode(i - 1), px, py, jumpIndex);
+            fn(i, px, py);
+        }
+    }
+
+    size_t MemoryBytes() const;
+
+private:
+    static const int CODES_PER_WORD = 21;          // 21 * 3 = 63 bits por palabra
+    static const int CHECKPOINT_INTERVAL = 128;    // Posición absoluta cada N pasos
+
+    struct Checkpoint {
+        int x, y;
+        int jumpIndex;
+    };
+
+    std::vector<uint64_t> words;
+    std::vector<Checkpoint> checkpoints;
+    std::vector<std::pair<int, int>> jumps;
+    int count;
+    int startX, startY;
+    int lastX, lastY;
+
+    void PushCode(int code);
+    void ApplyCode(int code, int& x, int& y, size_t& jumpIndex) const;
+};
@@ -0,0 +1,315 @@
+// MultiAgentPlanner.cpp
+#include "MultiAgentPlanner.h"
+#include "HexDirections.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+
+bool ReservationTable::CanMove(int agent, int fromCell, int toCell, int turn) const {
+    int owner = Owner(toCell, turn);
+    if (owner >= 0 && owner != agent) {
+        return false;
+    }
+    if (fromCell != toCell) {
+        int other = Owner(fromCell, turn);
+        if (other >= 0 && other != agent && Owner(toCell, turn - 1) == other) {
+            return false;
+        }
+    }
+    return true;
+}
+
+MultiAgentPlanner::MultiAgentPlanner(std::shared_ptr<const SharedLevel> sharedLevel, const MultiAgentSettings& plannerSettings)
+    : level(std::move(sharedLevel)), settings(plannerSettings), heuristicExpansions(0), turn(0), lastRound(0), rounds(0),
+      priorityRetries(0) {
+    settings.window = std::max(1, settings.window);
+    settings.replanEvery = std::max(1, std::min(settings.replanEvery, settings.window));
+}
+
+int MultiAgentPlanner::AddAgent(const AgentSpec& spec) {
+    auto valid = [this](GridPos pos) {
+        return pos.x >= 0 && pos.x < level->width && pos.y >= 0 && pos.y < level->height &&
+               !level->IsWall(CellIndex(pos));
+    };
+    if (spec.route.empty() || !valid(spec.start)) {
+        return -1;
+    }
+    for (const GridPos& goal : spec.route) {
+        if (!valid(goal)) return -1;
+    }
+
+    specs.push_back(spec);
+    agents.emplace_back();
+    agents.back().pos = spec.start;
+    int id = (int)agents.size() - 1;
+    priority.push_back(id);
+    ArriveAt(id);
+    return id;
+}
+
+// Distancia en pasos entre dos celdas del grid hexagonal (columnas impares corridas hacia abajo)
+int MultiAgentPlanner::HexDistance(int fromCell, int toCell) const {
+    GridPos from = CellPos(fromCell), to = CellPos(toCell);
+    int q1 = from.x, r1 = from.y - (from.x - (from.x & 1)) / 2;
+    int q2 = to.x, r2 = to.y - (to.x - (to.x & 1)) / 2;
+    int dq = q2 - q1, dr = r2 - r1;
+    return (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+}
+
+int MultiAgentPlanner::AbstractDistance(int goalCell, int cell) {
+    std::unique_ptr<GoalDistances>& slot = goalDistances[goalCell];
+    if (slot == nullptr) {
+        slot = std::make_unique<GoalDistances>();
+        slot->origin = cell;
+        slot->best[goalCell] = 0;
+        int h = HexDistance(goalCell, cell);
+        slot->open.push({h, h, goalCell});
+    }
+    GoalDistances& distances = *slot;
+    auto known = distances.closed.find(cell);
+    if (known != distances.closed.end()) {
+        return known->second;
+    }
+
+    // Se sigue la búsqueda desde la meta hasta cerrar la celda pedida; con la distancia hexagonal como
+    // heurística (consistente) todo lo cerrado ya tiene su distancia exacta, aunque se haya apuntado a otra celda
+    while (!distances.open.empty()) {
+        SearchEntry entry = distances.open.top();
+        distances.open.pop();
+        int current = entry.node;
+        if (distances.closed.count(current)) continue;
+        int g = distances.best[current];
+        distances.closed[current] = g;
+        heuristicExpansions++;
+
+        GridPos pos = CellPos(current);
+        const int (*offsets)[2] = HexOffsetsForColumn(pos.x);
+        for (int direction = 0; direction < 6; direction++) {
+            int nx = pos.x + offsets[direction][0];
+            int ny = pos.y + offsets[direction][1];
+            if (nx < 0 || nx >= level->width || ny < 0 || ny >= level->height) continue;
+            int next = ny * level->width + nx;
+            if (level->IsWall(next) || distances.closed.count(next)) continue;
+            auto best = distances.best.find(next);
+            if (best == distances.best.end() || g + 1 < best->second) {
+                distances.best[next] = g + 1;
+                int h = HexDistance(next, distances.origin);
+                distances.open.push({g + 1 + h, h, next});
+            }
+        }
+        if (current == cell) {
+            return g;
+        }
+    }
+    return -1;
+}
+
+bool MultiAgentPlanner::CanMove(int id, int fromCell, int toCell, int departTurn, bool forcedWait) const {
+    if (fromCell == toCell) {
+        if (!specs[id].canWait && !forcedWait) return false;
+    } else if (!level->IsOpen(toCell, departTurn)) {
+        return false;
+    }
+    return !settings.cooperative || reservations.CanMove(id, fromCell, toCell, departTurn + 1);
+}
+
+// Avanza en la ruta mientras esté parado sobre la meta actual (rutas con metas repetidas o que arrancan en una)
+void MultiAgentPlanner::ArriveAt(int id) {
+    const AgentSpec& spec = specs[id];
+    AgentState& agent = agents[id];
+    for (size_t guard = 0; guard < spec.route.size() && !agent.finished; guard++) {
+        const GridPos& goal = spec.route[agent.routeIndex];
+        if (agent.pos.x != goal.x || agent.pos.y != goal.y) break;
+        agent.routeIndex++;
+        if (agent.routeIndex == (int)spec.route.size()) {
+            if (spec.loop) {
+                agent.routeIndex = 0;
+            } else {
+                agent.finished = true;
+            }
+        }
+    }
+}
+
+// Todos desde cero en orden de prioridad, con la celda actual de cada uno ya reservada en este turno. Si alguno
+// queda sin ningún paso posible (los de más prioridad le tomaron la celda y todas las salidas), se repite la
+// ronda con ese agente adelante en la prioridad y su celda reservada también para el turno siguiente. Un fijado
+// siempre puede quedarse, y los fijados se acumulan entre intentos: a lo sumo un intento por agente.
+void MultiAgentPlanner::ReplanAll() {
+    rounds++;
+    lastRound = turn;
+    std::vector<int> stuck, pinned;
+    for (size_t attempt = 0; attempt <= agents.size(); attempt++) {
+        if (attempt > 0) {
+            priorityRetries++;
+            pinned.insert(pinned.end(), stuck.begin(), stuck.end());
+            std::stable_partition(priority.begin(), priority.end(), [&pinned](int id) {
+                return std::find(pinned.begin(), pinned.end(), id) != pinned.end();
+            });
+        }
+        reservations.Clear();
+        if (settings.cooperative) {
+            for (int id = 0; id < (int)agents.size(); id++) {
+                if (!agents[id].finished) reservations.Reserve(CellIndex(agents[id].pos), turn, id);
+            }
+            for (int id : pinned) {
+                reservations.Reserve(CellIndex(agents[id].pos), turn + 1, id);
+            }
+        }
+        stuck.clear();
+        for (int id : priority) {
+            if (agents[id].finished) continue;
+            PlanAgent(id);
+            if (agents[id].plan.empty()) stuck.push_back(id);
+        }
+        if (stuck.empty() || !settings.cooperative) break;
+    }
+}
+
+void MultiAgentPlanner::PlanAgent(int id) {
+    auto startTime = std::chrono::steady_clock::now();
+    const AgentSpec& spec = specs[id];
+    AgentState& agent = agents[id];
+    agent.plan.clear();
+    agent.planStep = 0;
+
+    int startCell = CellIndex(agent.pos);
+    int goalCell = CellIndex(spec.route[agent.routeIndex]);
+    nodes.clear();
+    nodeIndex.clear();
+    open.clear();
+
+    // Moverse o esperar cuesta un turno; a quien no puede esperar, quedarse le cuesta forcedWaitCost y solo
+    // lo elige si no hay otra forma de esquivar las reservas (en el juego sería un click rechazado)
+    int waitCost = spec.canWait ? 1 : std::max(1, settings.forcedWaitCost);
+    bool forcedWait = settings.cooperative && !spec.canWait;
+    int found = -1;
+    int best = 0;
+    long long expansions = 0;
+    int startDistance = AbstractDistance(goalCell, startCell);
+    if (startDistance >= 0) {
+        nodes.push_back({startCell, 0, 0, startDistance, -1, false});
+        nodeIndex[(uint64_t)startCell] = 0;
+        open.push_back({startDistance, startDistance, 0});
+    }
+
+    size_t cellCount = level->CellCount();
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<SearchEntry>());
+        SearchEntry entry = open.back();
+        open.pop_back();
+        SearchNode& current = nodes[entry.node];
+        if (current.closed || entry.f != current.f) {
+            continue;       // Entrada vieja de un nodo que después se mejoró
+        }
+        current.closed = true;
+        SearchNode node = current;
+        expansions++;
+
+        // Si no se llega, se usa el nodo más cerca de la meta (y más profundo, a igual distancia)
+        const SearchNode& bestNode = nodes[best];
+        if (entry.h < bestNode.f - bestNode.g || (entry.h == bestNode.f - bestNode.g && node.depth > bestNode.depth)) {
+            best = entry.node;
+        }
+        if (node.cell == goalCell || node.depth == settings.window) {
+            found = entry.node;
+            break;
+        }
+        if (expansions >= settings.maxExpansions) {
+            break;
+        }
+
+        int departTurn = turn + node.depth;
+        GridPos pos = CellPos(node.cell);
+        const int (*offsets)[2] = HexOffsetsForColumn(pos.x);
+        for (int direction = 0; direction <= 6; direction++) {
+            int next = node.cell;       // La dirección 6 es quedarse
+            if (direction < 6) {
+                int nx = pos.x + offsets[direction][0];
+                int ny = pos.y + offsets[direction][1];
+                if (nx < 0 || nx >= level->width || ny < 0 || ny >= level->height) continue;
+                next = ny * level->width + nx;
+            }
+            if (!CanMove(id, node.cell, next, departTurn, forcedWait)) continue;
+            int h = AbstractDistance(goalCell, next);
+            if (h < 0) continue;
+
+            int g = node.g + (next == node.cell ? waitCost : 1);
+            uint64_t key = (uint64_t)(node.depth + 1) * cellCount + (uint64_t)next;
+            auto existing = nodeIndex.find(key);
+            if (existing == nodeIndex.end()) {
+                int index = (int)nodes.size();
+                nodes.push_back({next, node.depth + 1, g, g + h, entry.node, false});
+                nodeIndex[key] = index;
+                open.push_back({g + h, h, index});
+            } else {
+                SearchNode& other = nodes[existing->second];
+                if (other.closed || g >= other.g) continue;
+                other.g = g;
+                other.f = g + h;
+                other.parent = entry.node;
+                open.push_back({g + h, h, existing->second});
+            }
+            std::push_heap(open.begin(), open.end(), std::greater<SearchEntry>());
+        }
+    }
+
+    if (found < 0) {
+        agent.cost.failedSearches++;
+        found = nodes.empty() ? -1 : best;
+    }
+    for (int index = found; index > 0; index = nodes[index].parent) {
+        agent.plan.push_back(CellPos(nodes[index].cell));
+    }
+    std::reverse(agent.plan.begin(), agent.plan.end());
+
+    // Sin llegar a la meta y con un plan corto, se queda donde termina hasta la próxima replanificación
+    // mientras nadie haya reservado esa celda; si no, el plan se corta y se replanifica en el turno siguiente
+    bool reachesGoal = found >= 0 && nodes[found].cell == goalCell && !agent.plan.empty();
+    GridPos last = agent.plan.empty() ? agent.pos : agent.plan.back();
+    while (!reachesGoal && (int)agent.plan.size() < settings.replanEvery) {
+        int arrival = turn + 1 + (int)agent.plan.size();
+        int owner = reservations.Owner(CellIndex(last), arrival);
+        if (settings.cooperative && owner >= 0 && owner != id) break;
+        agent.plan.push_back(last);
+    }
+
+    if (settings.cooperative) {
+        for (size_t step = 0; step < agent.plan.size(); step++) {
+            reservations.Reserve(CellIndex(agent.plan[step]), turn + 1 + (int)step, id);
+        }
+    }
+
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime).count();
+    agent.cost.replans++;
+    agent.cost.expansions += expansions;
+    agent.cost.micros += micros;
+    agent.cost.maxMicros = std::max(agent.cost.maxMicros, micros);
+}
+
+int MultiAgentPlanner::Step() {
+    bool replan = rounds == 0 || turn - lastRound >= settings.replanEvery;
+    for (const AgentState& agent : agents) {
+        if (!agent.finished && agent.planStep >= agent.plan.size()) replan = true;
+    }
+    if (replan) {
+        ReplanAll();
+    }
+
+    int moved = 0;
+    for (int id = 0; id < (int)agents.size(); id++) {
+        AgentState& agent = agents[id];
+        if (agent.finished) continue;
+        GridPos next = agent.planStep < agent.plan.size() ? agent.plan[agent.planStep++] : agent.pos;
+        if (next.x == agent.pos.x && next.y == agent.pos.y) {
+            if (!specs[id].canWait) agent.forcedWaits++;
+        } else {
+            moved++;
+        }
+        agent.pos = next;
+        ArriveAt(id);
+    }
+    turn++;
+    return moved;
+}
@@ -0,0 +1,143 @@
+// MultiAgentPlanner.h, varios agentes (jugadores, guardias) moviéndose a la vez sobre un SharedLevel sin chocar.
+// Windowed Hierarchical Cooperative A*: cada agente, en orden de prioridad, busca con A* en (celda, turno) solo
+// dentro de una ventana de turnos y anota su camino en una tabla de reservas compartida; los que planifican
+// después la esquivan. La heurística es la distancia exacta sin tiempo (Reverse Resumable A* desde cada meta).
+// Las reglas de paso son las del juego vía SharedLevel::IsOpen.
+#pragma once
+#include "GridPos.h"
+#include "SharedLevel.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+struct AgentSpec {
+    GridPos start = {0, 0};
+    std::vector<GridPos> route;     // Metas en orden
+    bool loop = false;              // Patrulla: después de la última meta vuelve a la primera
+    bool canWait = false;           // Quedarse quieto un turno (el jugador no puede; un guardia sí)
+};
+
+// Lo que gastó un agente en replanificar, acumulado
+struct AgentCost {
+    int replans = 0;
+    int failedSearches = 0;         // Sin camino en la ventana o cortadas por maxExpansions
+    long long expansions = 0;
+    double micros = 0.0;
+    double maxMicros = 0.0;
+};
+
+struct AgentState {
+    GridPos pos = {0, 0};
+    int routeIndex = 0;
+    bool finished = false;          // Llegó a la última meta (sin loop) y salió del mapa
+    int forcedWaits = 0;            // Turnos que se quedó quieto sin poder esperar (no tenía otra salida)
+    std::vector<GridPos> plan;      // Posiciones de los próximos turnos, desde el de la última replanificación
+    size_t planStep = 0;
+    AgentCost cost;
+};
+
+struct MultiAgentSettings {
+    int window = 16;                // Turnos que mira hacia adelante cada búsqueda
+    int replanEvery = 8;            // Cada cuántos turnos se replanifica a todos (<= window)
+    int maxExpansions = 4096;       // Por búsqueda de un agente
+    int forcedWaitCost = 8;         // Turnos que "cuesta" quedarse quieto a quien no puede esperar: solo si no
+                                    // hay otra forma de no chocar
+    bool cooperative = true;        // false: cada uno planifica solo, sin reservas (para comparar choques)
+};
+
+// Quién ocupa cada (celda, turno). Un movimiento a -> b al llegar en 'turn' choca si b ya está tomada en ese
+// turno o si el dueño de a en 'turn' venía de b (intercambio de lugares).
+class ReservationTable {
+public:
+    void Clear() { owners.clear(); }
+    void Reserve(int cell, int turn, int agent) { owners[Key(cell, turn)] = agent; }
+    int Owner(int cell, int turn) const {
+        auto found = owners.find(Key(cell, turn));
+        return found != owners.end() ? found->second : -1;
+    }
+    bool CanMove(int agent, int fromCell, int toCell, int turn) const;
+    size_t Size() const { return owners.size(); }
+
+private:
+    static uint64_t Key(int cell, int turn) { return ((uint64_t)(uint32_t)turn << 32) | (uint32_t)cell; }
+    std::unordered_map<uint64_t, int> owners;
+};
+
+class MultiAgentPlanner {
+public:
+    MultiAgentPlanner(std::shared_ptr<const SharedLevel> sharedLevel, const MultiAgentSettings& plannerSettings);
+
+    // -1 si el inicio o alguna meta está fuera del mapa o en una pared. La prioridad empieza por el orden de
+    // alta; los que quedan sin salida en una ronda pasan adelante.
+    int AddAgent(const AgentSpec& spec);
+
+    // Avanza un turno a todos los agentes; antes replanifica si pasaron replanEvery turnos o algún agente
+    // se quedó sin plan (llegó a una meta intermedia). Devuelve cuántos cambiaron de celda.
+    int Step();
+
+    int Turn() const { return turn; }
+    int AgentCount() const { return (int)agents.size(); }
+    const AgentSpec& Spec(int id) const { return specs[id]; }
+    const AgentState& Agent(int id) const { return agents[id]; }
+    const ReservationTable& Reservations() const { return reservations; }
+    const MultiAgentSettings& Settings() const { return settings; }
+    int Rounds() const { return rounds; }
+    int PriorityRetries() const { return priorityRetries; }
+    long long HeuristicExpansions() const { return heuristicExpansions; }
+
+    // Distancia sin tiempo de la celda a la meta, ignorando compuertas (-1 si no hay camino); la calcula a
+    // demanda y la guarda por meta
+    int AbstractDistance(int goalCell, int cell);
+
+private:
+    struct SearchNode {
+        int cell;
+        int depth;                  // Turnos desde el comienzo de la ventana
+        int g, f;
+        int parent;
+        bool closed;
+    };
+    struct SearchEntry {
+        int f, h;
+        int node;
+        bool operator>(const SearchEntry& other) const { return f > other.f || (f == other.f && h > other.h); }
+    };
+    // Reverse Resumable A*: búsqueda desde la meta hacia el primer agente que la pidió, que se retoma cuando
+    // se pregunta por una celda todavía no cerrada
+    struct GoalDistances {
+        int origin;                 // Objetivo de la heurística de esta búsqueda
+        std::unordered_map<int, int> closed;
+        std::unordered_map<int, int> best;
+        std::priority_queue<SearchEntry, std::vector<SearchEntry>, std::greater<SearchEntry>> open;
+    };
+
+    std::shared_ptr<const SharedLevel> level;
+    MultiAgentSettings settings;
+    std::vector<AgentSpec> specs;
+    std::vector<AgentState> agents;
+    ReservationTable reservations;
+    std::unordered_map<int, std::unique_ptr<GoalDistances>> goalDistances;
+    long long heuristicExpansions;
+    int turn;
+    int lastRound;
+    int rounds;
+    int priorityRetries;
+    std::vector<int> priority;          // Orden en que planifican
+
+    // Reusados entre búsquedas para no reservar memoria en cada una
+    std::vector<SearchNode> nodes;
+    std::unordered_map<uint64_t, int> nodeIndex;
+    std::vector<SearchEntry> open;      // Heap con std::greater
+
+    int CellIndex(GridPos pos) const { return pos.y * level->width + pos.x; }
+    GridPos CellPos(int cell) const { return {cell % level->width, cell / level->width}; }
+    int HexDistance(int fromCell, int toCell) const;
+    void ReplanAll();
+    void PlanAgent(int id);
+    bool CanMove(int id, int fromCell, int toCell, int departTurn, bool forcedWait) const;
+    void ArriveAt(int id);
+};
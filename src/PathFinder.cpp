@@ -1,98 +1,183 @@
 // PathFinder.cpp, algorithm de búsqueda de caminos para un juego de hexágonos con mecánicas especiales.
 #include "PathFinder.h"
+#include "LevelTables.h"
+#include "HexDirections.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <queue>
 #include <chrono>
+#include <climits>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
 
-PathFinder::PathFinder(Grid* g) : grid(g) {}
+PathFinder::PathFinder(Grid* g) : grid(g), verbose(true), trace(nullptr) {}
 
-std::vector<Vector2> PathFinder::FindPathAStar() {
-    const int MAX_ITERATIONS = 10000;
-    const int MAX_TIME_MS = 5000;
+namespace {
+
+// Entrada de la cola de prioridad; se compara por (fCost, hCost) como el A* original
+struct OpenEntry {
+    int fCost, hCost;
+    PathNode* node;
     
-    auto startTime = std::chrono::high_resolution_clock::now();
+    bool operator>(const OpenEntry& other) const {
+        return fCost > other.fCost || (fCost == other.fCost && hCost > other.hCost);
+    }
+};
+
+// Entrada del anytime: clave g + peso * h en punto fijo, para cambiar el peso sin perder orden exacto
+struct AnytimeEntry {
+    long long key;
+    int hCost;
+    PathNode* node;
     
-    std::vector<PathNode*> openList;
-    std::vector<PathNode*> closedList;
+    bool operator>(const AnytimeEntry& other) const {
+        return key > other.key || (key == other.key && hCost > other.hCost);
+    }
+};
+
+const long long WEIGHT_SCALE = 1000;
+
+double MillisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+SolverLimits SolverLimits::AnytimeFor(const Grid& grid) {
+    SolverLimits limits = AStarDefaults();
+    size_t cellCount = (size_t)grid.width * grid.height;
+    int distance = grid.width + grid.height;
+    if (grid.goalDistance != nullptr && grid.startPos.x >= 0 && grid.startPos.x < grid.width &&
+        grid.startPos.y >= 0 && grid.startPos.y < grid.height) {
+        uint32_t fromStart = grid.goalDistance[(size_t)grid.startPos.y * grid.width + grid.startPos.x];
+        if (fromStart != LevelTables::UNREACHABLE) distance = (int)fromStart;
+    }
+    int latestOpen = 0;
+    for (size_t i = 0; i < cellCount; i++) {
+        const HexCell& cell = grid.cells[i];
+        if (cell.type == CellType::TEMPORAL_WALL) latestOpen = std::max(latestOpen, cell.TurnsToOpen());
+    }
+    
+    limits.maxIterations = INT_MAX;
+    limits.maxTimeMs = ANYTIME_TIME_MS;
+    limits.maxTurn = std::max(limits.maxTurn, latestOpen + 4 * distance + 4 * grid.turnCycleLength);
+    limits.maxNodes = std::max(limits.maxNodes, std::min(ANYTIME_MAX_NODES, cellCount * 8));
+    return limits;
+}
+
+uint64_t PathFinder::StateKey(int x, int y, int turn) const {
+    return ((uint64_t)(uint32_t)turn * (uint64_t)grid->height + (uint64_t)y) * (uint64_t)grid->width + (uint64_t)x;
+}
+
+std::vector<GridPos> PathFinder::FindPathAStar() {
+    return FindPathAStar(SolverLimits::AStarDefaults());
+}
+
+std::vector<GridPos> PathFinder::FindPathAStar(const SolverLimits& limits) {
+    auto startTime = std::chrono::steady_clock::now();
+    lastStats = SolverStats();
     
-    int startX = (int)grid->startPos.x;
-    int startY = (int)grid->startPos.y;
-    int goalX = (int)grid->goalPos.x;
-    int goalY = (int)grid->goalPos.y;
+    int startX = grid->startPos.x;
+    int startY = grid->startPos.y;
+    int goalX = grid->goalPos.x;
+    int goalY = grid->goalPos.y;
     
-    std::cout << "A* iniciando desde (" << startX << "," << startY << ") hacia (" << goalX << "," << goalY << ")" << std::endl;
+    if (verbose) {
+        std::cout << "A* iniciando desde (" << startX << "," << startY << ") hacia (" << goalX << "," << goalY << ")" << std::endl;
+    }
     
     // Verificar posiciones válidas
     if (startX < 0 || startX >= grid->width || startY < 0 || startY >= grid->height ||
         goalX < 0 || goalX >= grid->width || goalY < 0 || goalY >= grid->height) {
         std::cout << "ERROR: Posiciones inválidas!" << std::endl;
-        return std::vector<Vector2>();
+        lastStats.stop = SolverStop::INVALID_LEVEL;
+        if (trace) trace->Finish();
+        return std::vector<GridPos>();
     }
     
-    PathNode* startNode = new PathNode(startX, startY, 0);
+    // Arena de nodos (deque: los punteros a padres no se invalidan al crecer),
+    // cola de prioridad con borrado perezoso y tabla hash (celda, turno) -> nodo
+    std::deque<PathNode> arena;
+    std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<OpenEntry>> openQueue;
+    std::unordered_map<uint64_t, PathNode*> nodes;
+    nodes.reserve(std::min<size_t>(limits.maxNodes, (size_t)grid->width * grid->height));
+    size_t peakQueue = 0;
+    
+    arena.emplace_back(startX, startY, 0);
+    PathNode* startNode = &arena.back();
     startNode->gCost = 0;
-    startNode->hCost = CalculateHeuristic(startX, startY, goalX, goalY);
+    startNode->hCost = EstimateToGoal(startX, startY, goalX, goalY);
     startNode->fCost = startNode->gCost + startNode->hCost;
-    
-    openList.push_back(startNode);
+    nodes[StateKey(startX, startY, 0)] = startNode;
+    openQueue.push({startNode->fCost, startNode->hCost, startNode});
+    if (trace) trace->OnGenerated(startX, startY, 0);
     
     int iterations = 0;
+    std::vector<GridPos> path;
+    lastStats.stop = SolverStop::EXHAUSTED;
     
-    while (!openList.empty() && iterations < MAX_ITERATIONS) {
+    while (!openQueue.empty()) {
+        if (iterations >= limits.maxIterations) {
+            lastStats.stop = SolverStop::ITERATION_LIMIT;
+            break;
+        }
+        
+        // Entradas viejas de nodos ya cerrados o mejorados se descartan al salir
+        OpenEntry entry = openQueue.top();
+        openQueue.pop();
+        PathNode* currentNode = entry.node;
+        if (currentNode->closed || entry.fCost != currentNode->fCost) {
+            continue;
+        }
+        
         iterations++;
         
         // Progress check cada 100 iteraciones
         if (iterations % 100 == 0) {
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - startTime).count();
-            
-            if (elapsed > MAX_TIME_MS) {
-                std::cout << "TIMEOUT: A* excedió " << MAX_TIME_MS << "ms" << std::endl;
+            double elapsed = MillisSince(startTime);
+            if (elapsed > limits.maxTimeMs) {
+                if (verbose) std::cout << "TIMEOUT: A* excedió " << limits.maxTimeMs << "ms" << std::endl;
+                lastStats.stop = SolverStop::TIME_LIMIT;
+                break;
+            }
+            if (trace && trace->Cancelled()) {
+                if (verbose) std::cout << "A* cancelado" << std::endl;
+                lastStats.stop = SolverStop::CANCELLED;
                 break;
             }
             
-            std::cout << "A* progreso: " << iterations << " iteraciones, " 
-                      << openList.size() << " abiertos, " << closedList.size() << " cerrados" << std::endl;
-        }
-        
-        // Encontrar nodo con menor fCost
-        PathNode* currentNode = openList[0];
-        for (size_t i = 1; i < openList.size(); i++) {
-            if (openList[i]->fCost < currentNode->fCost || 
-                (openList[i]->fCost == currentNode->fCost && openList[i]->hCost < currentNode->hCost)) {
-                currentNode = openList[i];
+            if (verbose) {
+                std::cout << "A* progreso: " << iterations << " iteraciones, " 
+                          << openQueue.size() << " en cola, " << arena.size() << " nodos" << std::endl;
             }
         }
         
-        // Mover de openList a closedList
-        openList.erase(std::find(openList.begin(), openList.end(), currentNode));
-        closedList.push_back(currentNode);
+        currentNode->closed = true;
+        if (trace) trace->OnExpanded(currentNode->x, currentNode->y);
         
         // ¿Llegamos al objetivo?
         if (currentNode->x == goalX && currentNode->y == goalY) {
-            std::cout << "¡ÉXITO A*! Camino encontrado en " << iterations << " iteraciones." << std::endl;
-            std::vector<Vector2> path = ReconstructPath(currentNode);
-            
-            // Limpiar memoria
-            for (PathNode* node : openList) delete node;
-            for (PathNode* node : closedList) delete node;
-            
-            return path;
+            if (verbose) std::cout << "¡ÉXITO A*! Camino encontrado en " << iterations << " iteraciones." << std::endl;
+            path = ReconstructPath(currentNode);
+            lastStats.stop = SolverStop::FOUND;
+            break;
         }
         
         // Límite de profundidad razonable
-        if (currentNode->turn > 100) {
+        if (currentNode->turn > limits.maxTurn) {
             continue;
         }
         
-        // Examinar vecinos
-        std::vector<Vector2> neighbors = grid->GetNeighbors(currentNode->x, currentNode->y);
-        
-        for (const Vector2& neighbor : neighbors) {
-            int nx = (int)neighbor.x;
-            int ny = (int)neighbor.y;
+        // Examinar vecinos (con la adyacencia del .etgl las paredes fijas ni se miran)
+        const int (*offsets)[2] = HexOffsetsForColumn(currentNode->x);
+        uint8_t neighborMask = grid->NeighborMask(currentNode->x, currentNode->y);
+        for (int direction = 0; direction < 6; direction++) {
+            if ((neighborMask & (1 << direction)) == 0) continue;
+            int nx = currentNode->x + offsets[direction][0];
+            int ny = currentNode->y + offsets[direction][1];
             int newTurn = currentNode->turn + 1;
             
             // Validar movimiento
@@ -100,162 +185,359 @@ std::vector<Vector2> PathFinder::FindPathAStar() {
                 continue;
             }
             
-            // Verificar si ya está en closedList (VERSIÓN SIMPLE)
-            bool inClosedList = false;
-            for (PathNode* closedNode : closedList) {
-                if (closedNode->x == nx && closedNode->y == ny && closedNode->turn == newTurn) {
-                    inClosedList = true;
-                    break;
-                }
-            }
-            
-            if (inClosedList) {
+            // Con campo de distancias se descartan celdas desde las que la meta es inalcanzable
+            if (grid->goalDistance != nullptr &&
+                grid->goalDistance[ny * grid->width + nx] == LevelTables::UNREACHABLE) {
                 continue;
             }
             
             int tentativeGCost = currentNode->gCost + 1;
-            
-            // Buscar en openList (VERSIÓN SIMPLE)
-            PathNode* existingNode = nullptr;
-            for (PathNode* openNode : openList) {
-                if (openNode->x == nx && openNode->y == ny && openNode->turn == newTurn) {
-                    existingNode = openNode;
-                    break;
-                }
-            }
+            PathNode*& existingNode = nodes[StateKey(nx, ny, newTurn)];
             
             if (existingNode == nullptr) {
                 // Nuevo nodo
-                PathNode* neighborNode = new PathNode(nx, ny, newTurn);
+                arena.emplace_back(nx, ny, newTurn);
+                PathNode* neighborNode = &arena.back();
                 neighborNode->gCost = tentativeGCost;
-                neighborNode->hCost = CalculateHeuristic(nx, ny, goalX, goalY);
+                neighborNode->hCost = EstimateToGoal(nx, ny, goalX, goalY);
                 neighborNode->fCost = neighborNode->gCost + neighborNode->hCost;
                 neighborNode->parent = currentNode;
-                openList.push_back(neighborNode);
-            } else if (tentativeGCost < existingNode->gCost) {
+                existingNode = neighborNode;
+                openQueue.push({neighborNode->fCost, neighborNode->hCost, neighborNode});
+                if (trace) trace->OnGenerated(nx, ny, newTurn);
+            } else if (!existingNode->closed && tentativeGCost < existingNode->gCost) {
                 // Mejor camino al nodo existente
                 existingNode->gCost = tentativeGCost;
                 existingNode->fCost = existingNode->gCost + existingNode->hCost;
                 existingNode->parent = currentNode;
+                openQueue.push({existingNode->fCost, existingNode->hCost, existingNode});
             }
         }
+        peakQueue = std::max(peakQueue, openQueue.size());
         
         // Límite de memoria simple
-        if (openList.size() + closedList.size() > 10000) {
-            std::cout << "Límite de memoria alcanzado" << std::endl;
+        if (arena.size() > limits.maxNodes) {
+            if (verbose) std::cout << "Límite de memoria alcanzado" << std::endl;
+            lastStats.stop = SolverStop::NODE_LIMIT;
             break;
         }
     }
     
-    // No se encontró camino
-    std::cout << "A* FALLÓ después de " << iterations << " iteraciones." << std::endl;
-    std::cout << "Nodos explorados: " << closedList.size() << ", En cola: " << openList.size() << std::endl;
+    lastStats.expansions = iterations;
+    lastStats.generated = arena.size();
+    lastStats.peakBytes = arena.size() * sizeof(PathNode) + peakQueue * sizeof(OpenEntry) +
+                          nodes.bucket_count() * sizeof(void*) + nodes.size() * (sizeof(uint64_t) + 2 * sizeof(void*));
+    lastStats.millis = MillisSince(startTime);
+    if (trace) trace->Finish();
+    
+    if (lastStats.stop != SolverStop::FOUND && verbose) {
+        std::cout << "A* FALLÓ después de " << iterations << " iteraciones." << std::endl;
+        std::cout << "Nodos creados: " << arena.size() << ", En cola: " << openQueue.size() << std::endl;
+    }
+    return path;
+}
+
+// Como g es siempre el turno, un nodo cerrado nunca mejora: entre pasadas alcanza con cambiar el peso y reordenar
+// los abiertos (no hace falta la lista INCONS del ARA* general). La cota sale de la heurística admisible: ningún
+// camino mejor puede costar menos que el menor g + h de los abiertos.
+std::vector<GridPos> PathFinder::FindPathAnytime(const SolverLimits& limits, const AnytimeSettings& settings,
+                                                 const std::function<void(const AnytimeSolution&)>& onSolution) {
+    auto startTime = std::chrono::steady_clock::now();
+    lastStats = SolverStats();
+    
+    int startX = grid->startPos.x;
+    int startY = grid->startPos.y;
+    int goalX = grid->goalPos.x;
+    int goalY = grid->goalPos.y;
+    
+    if (startX < 0 || startX >= grid->width || startY < 0 || startY >= grid->height ||
+        goalX < 0 || goalX >= grid->width || goalY < 0 || goalY >= grid->height) {
+        std::cout << "ERROR: Posiciones inválidas!" << std::endl;
+        lastStats.stop = SolverStop::INVALID_LEVEL;
+        if (trace) trace->Finish();
+        return std::vector<GridPos>();
+    }
+    
+    double weight = std::max(1.0, settings.initialWeight);
+    double weightStep = settings.weightStep > 0.0 ? settings.weightStep : weight;
+    long long scaledWeight = std::llround(weight * WEIGHT_SCALE);
+    
+    std::deque<PathNode> arena;
+    std::vector<AnytimeEntry> open;     // Heap con std::greater
+    std::unordered_map<uint64_t, PathNode*> nodes;
+    nodes.reserve(std::min<size_t>(limits.maxNodes, (size_t)grid->width * grid->height));
+    size_t peakQueue = 0;
+    
+    arena.emplace_back(startX, startY, 0);
+    PathNode* startNode = &arena.back();
+    startNode->hCost = AdmissibleEstimate(startX, startY, goalX, goalY);
+    startNode->fCost = startNode->hCost;
+    nodes[StateKey(startX, startY, 0)] = startNode;
+    open.push_back({scaledWeight * startNode->hCost, startNode->hCost, startNode});
+    if (trace) trace->OnGenerated(startX, startY, 0);
+    
+    PathNode* best = (startX == goalX && startY == goalY) ? startNode : nullptr;
+    int iterations = 0;
+    lastStats.stop = SolverStop::EXHAUSTED;
+    bool limited = false;
+    
+    // Avisa si mejoró el camino o la cota; la cota se calcula recorriendo los abiertos (solo en cada mejora)
+    auto publish = [&](bool newPath) {
+        int lowest = best->gCost;
+        for (const AnytimeEntry& entry : open) {
+            lowest = std::min(lowest, entry.node->fCost);
+        }
+        double bound = lowest > 0 ? std::max(1.0, (double)best->gCost / lowest) : 1.0;
+        if (!newPath && bound >= lastStats.bound) {
+            return;
+        }
+        if (newPath) {
+            lastStats.solutions++;
+            if (lastStats.solutions == 1) lastStats.firstMillis = MillisSince(startTime);
+        }
+        lastStats.bound = bound;
+        if (verbose) {
+            std::cout << "ARA* " << (newPath ? "camino" : "cota") << ": " << best->gCost << " turnos, peso " << weight
+                      << ", cota " << bound << " (" << iterations << " iteraciones)" << std::endl;
+        }
+        if (onSolution) {
+            onSolution({ReconstructPath(best), weight, bound, iterations, MillisSince(startTime)});
+        }
+    };
+    if (best != nullptr) {
+        publish(true);
+    }
     
-    for (PathNode* node : openList) delete node;
-    for (PathNode* node : closedList) delete node;
+    while (!limited) {
+        // Una pasada con el peso actual: termina cuando ningún abierto puede dar un camino más corto que el mejor
+        while (!open.empty()) {
+            if (best != nullptr && open.front().key >= best->gCost * WEIGHT_SCALE) {
+                break;
+            }
+            if (iterations >= limits.maxIterations) {
+                lastStats.stop = SolverStop::ITERATION_LIMIT;
+                limited = true;
+                break;
+            }
+            std::pop_heap(open.begin(), open.end(), std::greater<AnytimeEntry>());
+            PathNode* currentNode = open.back().node;
+            open.pop_back();
+            iterations++;
+            
+            if (iterations % 100 == 0) {
+                if (MillisSince(startTime) > limits.maxTimeMs) {
+                    if (verbose) std::cout << "ARA*: fecha límite de " << limits.maxTimeMs << "ms" << std::endl;
+                    lastStats.stop = SolverStop::TIME_LIMIT;
+                    limited = true;
+                    break;
+                }
+                if (trace && trace->Cancelled()) {
+                    if (verbose) std::cout << "ARA* cancelado" << std::endl;
+                    lastStats.stop = SolverStop::CANCELLED;
+                    limited = true;
+                    break;
+                }
+            }
+            
+            currentNode->closed = true;
+            if (trace) trace->OnExpanded(currentNode->x, currentNode->y);
+            
+            // La meta se toma al generarla; los que ya no pueden mejorar el camino no se expanden
+            if ((currentNode->x == goalX && currentNode->y == goalY) || currentNode->turn > limits.maxTurn ||
+                (best != nullptr && currentNode->fCost >= best->gCost)) {
+                continue;
+            }
+            
+            const int (*offsets)[2] = HexOffsetsForColumn(currentNode->x);
+            uint8_t neighborMask = grid->NeighborMask(currentNode->x, currentNode->y);
+            for (int direction = 0; direction < 6; direction++) {
+                if ((neighborMask & (1 << direction)) == 0) continue;
+                int nx = currentNode->x + offsets[direction][0];
+                int ny = currentNode->y + offsets[direction][1];
+                int newTurn = currentNode->turn + 1;
+                
+                if (!IsValidMoveAtTurn(currentNode->x, currentNode->y, nx, ny, newTurn)) {
+                    continue;
+                }
+                if (grid->goalDistance != nullptr &&
+                    grid->goalDistance[ny * grid->width + nx] == LevelTables::UNREACHABLE) {
+                    continue;
+                }
+                
+                // Mismo (celda, turno) es mismo g: un nodo que ya existe no tiene nada que mejorar
+                int hCost = AdmissibleEstimate(nx, ny, goalX, goalY);
+                if (best != nullptr && newTurn + hCost >= best->gCost) {
+                    continue;
+                }
+                PathNode*& existingNode = nodes[StateKey(nx, ny, newTurn)];
+                if (existingNode != nullptr) {
+                    continue;
+                }
+                arena.emplace_back(nx, ny, newTurn);
+                PathNode* neighborNode = &arena.back();
+                neighborNode->gCost = newTurn;
+                neighborNode->hCost = hCost;
+                neighborNode->fCost = newTurn + hCost;
+                neighborNode->parent = currentNode;
+                existingNode = neighborNode;
+                open.push_back({(long long)newTurn * WEIGHT_SCALE + scaledWeight * hCost, hCost, neighborNode});
+                std::push_heap(open.begin(), open.end(), std::greater<AnytimeEntry>());
+                if (trace) trace->OnGenerated(nx, ny, newTurn);
+                
+                if (nx == goalX && ny == goalY && (best == nullptr || newTurn < best->gCost)) {
+                    best = neighborNode;
+                    publish(true);
+                }
+            }
+            peakQueue = std::max(peakQueue, open.size());
+            
+            if (arena.size() > limits.maxNodes) {
+                if (verbose) std::cout << "Límite de memoria alcanzado" << std::endl;
+                lastStats.stop = SolverStop::NODE_LIMIT;
+                limited = true;
+                break;
+            }
+        }
+        if (limited || best == nullptr) {
+            break;
+        }
+        
+        // Fin de la pasada: la cota ya no supera el peso. Con peso 1 (o sin abiertos) el camino es óptimo.
+        publish(false);
+        if (weight <= 1.0 || lastStats.bound <= 1.0) {
+            break;
+        }
+        weight = std::max(1.0, weight - weightStep);
+        scaledWeight = std::llround(weight * WEIGHT_SCALE);
+        for (AnytimeEntry& entry : open) {
+            entry.key = (long long)entry.node->gCost * WEIGHT_SCALE + scaledWeight * entry.node->hCost;
+        }
+        std::make_heap(open.begin(), open.end(), std::greater<AnytimeEntry>());
+    }
     
-    return std::vector<Vector2>();
+    std::vector<GridPos> path;
+    if (best != nullptr) {
+        path = ReconstructPath(best);
+        lastStats.stop = SolverStop::FOUND;
+    }
+    lastStats.expansions = iterations;
+    lastStats.generated = arena.size();
+    lastStats.peakBytes = arena.size() * sizeof(PathNode) + peakQueue * sizeof(AnytimeEntry) +
+                          nodes.bucket_count() * sizeof(void*) + nodes.size() * (sizeof(uint64_t) + 2 * sizeof(void*));
+    lastStats.millis = MillisSince(startTime);
+    if (trace) trace->Finish();
+    return path;
+}
+
+std::vector<GridPos> PathFinder::FindPathBFS() {
+    return FindPathBFS(SolverLimits::BFSDefaults());
 }
 
-std::vector<Vector2> PathFinder::FindPathBFS() {
-    const int MAX_ITERATIONS = 5000;
-    const int MAX_TIME_MS = 3000;
+std::vector<GridPos> PathFinder::FindPathBFS(const SolverLimits& limits) {
+    auto startTime = std::chrono::steady_clock::now();
+    lastStats = SolverStats();
     
-    auto startTime = std::chrono::high_resolution_clock::now();
+    int startX = grid->startPos.x;
+    int startY = grid->startPos.y;
+    int goalX = grid->goalPos.x;
+    int goalY = grid->goalPos.y;
     
-    std::queue<PathNode*> queue;
-    std::vector<PathNode*> visited;
+    if (verbose) {
+        std::cout << "BFS iniciando desde (" << startX << "," << startY << ") hacia (" << goalX << "," << goalY << ")" << std::endl;
+    }
     
-    int startX = (int)grid->startPos.x;
-    int startY = (int)grid->startPos.y;
-    int goalX = (int)grid->goalPos.x;
-    int goalY = (int)grid->goalPos.y;
+    if (startX < 0 || startX >= grid->width || startY < 0 || startY >= grid->height ||
+        goalX < 0 || goalX >= grid->width || goalY < 0 || goalY >= grid->height) {
+        std::cout << "ERROR: Posiciones inválidas!" << std::endl;
+        lastStats.stop = SolverStop::INVALID_LEVEL;
+        return std::vector<GridPos>();
+    }
     
-    std::cout << "BFS iniciando desde (" << startX << "," << startY << ") hacia (" << goalX << "," << goalY << ")" << std::endl;
+    // La arena hace de cola: los nodos se crean en orden de visita y se recorren con un índice
+    std::deque<PathNode> arena;
+    std::unordered_set<uint64_t> visited;
+    visited.reserve(std::min<size_t>(limits.maxNodes, (size_t)grid->width * grid->height));
     
-    PathNode* startNode = new PathNode(startX, startY, 0);
-    queue.push(startNode);
-    visited.push_back(startNode);
+    arena.emplace_back(startX, startY, 0);
+    visited.insert(StateKey(startX, startY, 0));
     
+    size_t head = 0;
     int iterations = 0;
+    std::vector<GridPos> path;
+    lastStats.stop = SolverStop::EXHAUSTED;
     
-    while (!queue.empty() && iterations < MAX_ITERATIONS) {
+    while (head < arena.size()) {
+        if (iterations >= limits.maxIterations) {
+            lastStats.stop = SolverStop::ITERATION_LIMIT;
+            break;
+        }
         iterations++;
         
         if (iterations % 100 == 0) {
-            auto currentTime = std::chrono::high_resolution_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - startTime).count();
-            
-            if (elapsed > MAX_TIME_MS) {
-                std::cout << "TIMEOUT BFS: " << elapsed << "ms" << std::endl;
+            double elapsed = MillisSince(startTime);
+            if (elapsed > limits.maxTimeMs) {
+                if (verbose) std::cout << "TIMEOUT BFS: " << elapsed << "ms" << std::endl;
+                lastStats.stop = SolverStop::TIME_LIMIT;
                 break;
             }
             
-            std::cout << "BFS progreso: " << iterations << " iteraciones" << std::endl;
+            if (verbose) std::cout << "BFS progreso: " << iterations << " iteraciones" << std::endl;
         }
         
-        PathNode* currentNode = queue.front();
-        queue.pop();
+        PathNode* currentNode = &arena[head++];
         
         // ¿Llegamos al objetivo?
         if (currentNode->x == goalX && currentNode->y == goalY) {
-            std::cout << "¡ÉXITO BFS! Camino encontrado en " << iterations << " iteraciones." << std::endl;
-            std::vector<Vector2> path = ReconstructPath(currentNode);
-            
-            // Limpiar memoria
-            for (PathNode* node : visited) delete node;
-            
-            return path;
+            if (verbose) std::cout << "¡ÉXITO BFS! Camino encontrado en " << iterations << " iteraciones." << std::endl;
+            path = ReconstructPath(currentNode);
+            lastStats.stop = SolverStop::FOUND;
+            break;
         }
         
         // Límite de profundidad
-        if (currentNode->turn > 50) {
+        if (currentNode->turn > limits.maxTurn) {
             continue;
         }
         
         // Examinar vecinos
-        std::vector<Vector2> neighbors = grid->GetNeighbors(currentNode->x, currentNode->y);
-        
-        for (const Vector2& neighbor : neighbors) {
-            int nx = (int)neighbor.x;
-            int ny = (int)neighbor.y;
+        const int (*offsets)[2] = HexOffsetsForColumn(currentNode->x);
+        uint8_t neighborMask = grid->NeighborMask(currentNode->x, currentNode->y);
+        for (int direction = 0; direction < 6; direction++) {
+            if ((neighborMask & (1 << direction)) == 0) continue;
+            int nx = currentNode->x + offsets[direction][0];
+            int ny = currentNode->y + offsets[direction][1];
             int newTurn = currentNode->turn + 1;
             
             if (!IsValidMoveAtTurn(currentNode->x, currentNode->y, nx, ny, newTurn)) {
                 continue;
             }
             
-            // Verificar si ya fue visitado (VERSIÓN SIMPLE)
-            bool alreadyVisited = false;
-            for (PathNode* visitedNode : visited) {
-                if (visitedNode->x == nx && visitedNode->y == ny && visitedNode->turn == newTurn) {
-                    alreadyVisited = true;
-                    break;
-                }
-            }
-            
-            if (alreadyVisited) {
+            if (!visited.insert(StateKey(nx, ny, newTurn)).second) {
                 continue;
             }
             
-            PathNode* neighborNode = new PathNode(nx, ny, newTurn);
-            neighborNode->parent = currentNode;
-            queue.push(neighborNode);
-            visited.push_back(neighborNode);
+            arena.emplace_back(nx, ny, newTurn);
+            arena.back().parent = currentNode;
         }
         
         // Límite de memoria
-        if (visited.size() > 5000) {
-            std::cout << "Límite de memoria BFS alcanzado" << std::endl;
+        if (arena.size() > limits.maxNodes) {
+            if (verbose) std::cout << "Límite de memoria BFS alcanzado" << std::endl;
+            lastStats.stop = SolverStop::NODE_LIMIT;
             break;
         }
     }
     
-    // Limpiar memoria
-    for (PathNode* node : visited) delete node;
+    lastStats.expansions = iterations;
+    lastStats.generated = arena.size();
+    lastStats.peakBytes = arena.size() * sizeof(PathNode) +
+                          visited.bucket_count() * sizeof(void*) + visited.size() * (sizeof(uint64_t) + sizeof(void*));
+    lastStats.millis = MillisSince(startTime);
     
-    std::cout << "BFS FALLÓ después de " << iterations << " iteraciones" << std::endl;
-    return std::vector<Vector2>();
+    if (lastStats.stop != SolverStop::FOUND && verbose) {
+        std::cout << "BFS FALLÓ después de " << iterations << " iteraciones" << std::endl;
+    }
+    return path;
 }
 
 // VERSIÓN SIMPLIFICADA de IsValidMoveAtTurn (elimina complejidad innecesaria)
@@ -265,40 +547,27 @@ bool PathFinder::IsValidMoveAtTurn(int fromX, int fromY, int toX, int toY, int t
         return false;
     }
     
-    // Verificar que sea vecino hexagonal válido
-    std::vector<Vector2> neighbors = grid->GetNeighbors(fromX, fromY);
-    bool isNeighbor = false;
-    for (const Vector2& neighbor : neighbors) {
-        if ((int)neighbor.x == toX && (int)neighbor.y == toY) {
-            isNeighbor = true;
-            break;
-        }
-    }
-    
-    if (!isNeighbor) {
+    // Verificar que sea vecino hexagonal válido (sin armar el vector de vecinos)
+    if (HexDirectionBetween(fromX, fromY, toX, toY) < 0) {
         return false;
     }
     
     // Verificar tipo de celda
-    HexCell& targetCell = grid->cells[toY][toX];
+    const HexCell& targetCell = grid->CellAt(toX, toY);
     
     switch (targetCell.type) {
         case CellType::WALL:
             return false;
             
         case CellType::GATE:
-            // Verificar estado de compuerta
-            if (grid->gatePatterns.find(targetCell.gatePattern) != grid->gatePatterns.end()) {
-                int cyclePosition = turn % grid->turnCycleLength;
-                std::vector<bool>& pattern = grid->gatePatterns[targetCell.gatePattern];
-                if (cyclePosition < static_cast<int>(pattern.size())) {
-                    return pattern[cyclePosition];
-                }
+            // Verificar estado de compuerta (sin patrón queda abierta)
+            {
+                const GatePattern& pattern = grid->GatePatternOf(targetCell);
+                return !pattern.defined || LevelTables::GateOpenAtPhase(pattern.phases, turn % grid->turnCycleLength);
             }
-            return true; // Default abierta
             
         case CellType::TEMPORAL_WALL:
-            return (turn >= targetCell.turnsToOpen);
+            return (turn >= targetCell.TurnsToOpen());
             
         default:
             return true; // FREE, START, GOAL, ITEM son válidos
@@ -310,12 +579,38 @@ int PathFinder::CalculateHeuristic(int x1, int y1, int x2, int y2) {
     return abs(x2 - x1) + abs(y2 - y1);
 }
 
-std::vector<Vector2> PathFinder::ReconstructPath(PathNode* endNode) {
-    std::vector<Vector2> path;
+// Usa el campo de distancias precalculado si el nivel lo trae; si no, la heurística simple
+int PathFinder::EstimateToGoal(int x, int y, int goalX, int goalY) {
+    if (grid->goalDistance != nullptr) {
+        uint32_t distance = grid->goalDistance[y * grid->width + x];
+        if (distance != LevelTables::UNREACHABLE) {
+            return (int)distance;
+        }
+    }
+    return CalculateHeuristic(x, y, goalX, goalY);
+}
+
+// Para el anytime la cota necesita una heurística que nunca sobreestime: el campo de distancias o, sin él, la
+// distancia hexagonal (la de CalculateHeuristic cuenta de más en diagonal)
+int PathFinder::AdmissibleEstimate(int x, int y, int goalX, int goalY) {
+    if (grid->goalDistance != nullptr) {
+        uint32_t distance = grid->goalDistance[y * grid->width + x];
+        if (distance != LevelTables::UNREACHABLE) {
+            return (int)distance;
+        }
+    }
+    int q1 = x, r1 = y - (x - (x & 1)) / 2;
+    int q2 = goalX, r2 = goalY - (goalX - (goalX & 1)) / 2;
+    int dq = q2 - q1, dr = r2 - r1;
+    return (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+}
+
+std::vector<GridPos> PathFinder::ReconstructPath(PathNode* endNode) {
+    std::vector<GridPos> path;
     PathNode* current = endNode;
     
     while (current != nullptr) {
-        path.push_back({(float)current->x, (float)current->y});
+        path.push_back({current->x, current->y});
         current = current->parent;
     }
     
@@ -351,7 +646,7 @@ PathNode* PathFinder::GetNodeFromListOptimized(std::vector<PathNode*>& list, int
     return GetNodeFromList(list, x, y, turn);
 }
 
-std::vector<Vector2> PathFinder::FindPathDijkstra() {
+std::vector<GridPos> PathFinder::FindPathDijkstra() {
     std::cout << "Usando BFS en lugar de Dijkstra..." << std::endl;
     return FindPathBFS();
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #pragma once
 #include "Grid.h"
+#include "SearchTrace.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <queue>
 
@@ -8,26 +12,94 @@ struct PathNode {
     int turn;       
     int gCost, hCost, fCost;
     PathNode* parent;
+    bool closed;
     
     PathNode(int x, int y, int turn) : x(x), y(y), turn(turn), 
-                                       gCost(0), hCost(0), fCost(0), parent(nullptr) {}
+                                       gCost(0), hCost(0), fCost(0), parent(nullptr), closed(false) {}
+};
+
+// Límites de una búsqueda; los valores por defecto son los que usa el juego
+struct SolverLimits {
+    int maxIterations;
+    int maxTimeMs;
+    int maxTurn;            // Profundidad máxima en turnos
+    size_t maxNodes;        // Nodos creados (abiertos + cerrados)
+    
+    static SolverLimits AStarDefaults() { return {10000, 5000, 100, 10000}; }
+    static SolverLimits BFSDefaults() { return {5000, 3000, 50, 5000}; }
+    
+    // Las del anytime del juego: la profundidad sale de lo lejos que está la meta (campo de distancias, o ancho +
+    // alto sin él) más la última pared temporal, y el corte es la fecha límite; los nodos solo topan la memoria
+    static SolverLimits AnytimeFor(const Grid& grid);
+    static const int ANYTIME_TIME_MS = 5000;
+    static const size_t ANYTIME_MAX_NODES = (size_t)1 << 22;   // ~400 MB entre arena, tabla y cola
+};
+
+enum class SolverStop {
+    FOUND,
+    EXHAUSTED,              // Se recorrió todo lo alcanzable sin llegar a la meta
+    ITERATION_LIMIT,
+    TIME_LIMIT,
+    NODE_LIMIT,
+    INVALID_LEVEL,
+    CANCELLED               // SearchTrace::Cancel desde otro hilo
+};
+
+// Estadísticas de la última búsqueda
+struct SolverStats {
+    SolverStop stop = SolverStop::EXHAUSTED;
+    int expansions = 0;
+    size_t generated = 0;
+    size_t peakBytes = 0;   // Estimado: arena de nodos + cola + tabla hash
+    double millis = 0.0;
+    // Solo el anytime: cuántas veces mejoró y cuándo llegó la primera solución
+    int solutions = 0;
+    double bound = 0.0;     // Cota de la solución devuelta: turnos <= bound * óptimo (1 = óptima)
+    double firstMillis = 0.0;
+};
+
+// Cada mejora del anytime: el camino (con la celda de inicio, como FindPathAStar) y su cota
+struct AnytimeSolution {
+    std::vector<GridPos> path;
+    double weight;          // Peso de la heurística con el que se encontró
+    double bound;           // turnos <= bound * turnos del óptimo
+    int expansions;         // Acumuladas desde el comienzo
+    double millis;
+};
+
+struct AnytimeSettings {
+    double initialWeight = 3.0;
+    double weightStep = 0.5;    // Se resta después de cada pasada hasta llegar a 1
 };
 
 class PathFinder {
 public:
     Grid* grid;
+    bool verbose;           // Log de progreso por consola (el solver por lotes lo apaga)
+    SolverStats lastStats;
+    SearchTrace* trace;     // Opcional (solo A*): progreso por celda para el mapa de calor; Begin lo llama quien lo pasa
     
     PathFinder(Grid* g);
     
     
-    std::vector<Vector2> FindPathAStar();
-    std::vector<Vector2> FindPathDijkstra();
-    std::vector<Vector2> FindPathBFS();
+    std::vector<GridPos> FindPathAStar();
+    std::vector<GridPos> FindPathAStar(const SolverLimits& limits);
+    std::vector<GridPos> FindPathDijkstra();
+    std::vector<GridPos> FindPathBFS();
+    std::vector<GridPos> FindPathBFS(const SolverLimits& limits);
+    
+    // ARA*: A* con peso en la heurística que devuelve enseguida un primer camino y lo va mejorando con pesos
+    // menores, sin rehacer lo ya expandido. Con límites (maxTimeMs es la fecha límite) devuelve la mejor solución
+    // hasta ahí en vez de nada. onSolution se llama desde el hilo de la búsqueda en cada mejora del camino o de la cota.
+    std::vector<GridPos> FindPathAnytime(const SolverLimits& limits, const AnytimeSettings& settings,
+                                         const std::function<void(const AnytimeSolution&)>& onSolution = nullptr);
     
     
     bool IsValidMoveAtTurn(int fromX, int fromY, int toX, int toY, int turn);
     int CalculateHeuristic(int x1, int y1, int x2, int y2);
-    std::vector<Vector2> ReconstructPath(PathNode* endNode);
+    int EstimateToGoal(int x, int y, int goalX, int goalY);
+    int AdmissibleEstimate(int x, int y, int goalX, int goalY);
+    std::vector<GridPos> ReconstructPath(PathNode* endNode);
     
 private:
     
@@ -37,4 +109,7 @@ private:
     
     bool IsNodeInListOptimized(std::vector<PathNode*>& list, int x, int y, int turn);
     PathNode* GetNodeFromListOptimized(std::vector<PathNode*>& list, int x, int y, int turn);
+    
+    // Clave única de un estado (celda, turno) para la tabla hash de nodos
+    uint64_t StateKey(int x, int y, int turn) const;
 };
\ No newline at end of file
@@ -1,21 +1,41 @@
 #pragma once
+#ifndef ETG_HEADLESS
 #include "raylib.h"
+#endif
+#include "GridPos.h"
+#include "MoveLog.h"
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 class Player {
 public:
+    static const int START_SCORE = 1000;
+    static const int BACKTRACK_PENALTY = 50;   // Por volver a pisar una celda ya visitada
+    
     int x, y;           
     int score;
-    std::vector<Vector2> path;      
-    std::vector<Vector2> items;     
+    MoveLog path;       // Historial compacto (3 bits por paso)
+    std::vector<GridPos> items;     
     
-    Player(int startX, int startY);
+    Player(int startX, int startY, int gridWidth, int gridHeight);
+    void Reset(int startX, int startY);
     void MoveTo(int newX, int newY);
     void AddToPath(int x, int y);
-    bool HasVisited(int x, int y);
+    bool HasVisited(int x, int y) const;
+    int GetVisitCount(int x, int y) const;
+    GridPos GetPathPosition(int index) const;
     void ReduceScoreForBacktrack();
-    void Draw(float hexSize);
+    size_t MemoryBytes() const;     // Historial, conteo de visitas e items (sin el objeto)
+#ifndef ETG_HEADLESS
+    void Draw(float hexSize);   // PlayerRender.cpp
+#endif
     
 private:
+    int gridWidth, gridHeight;
+    std::vector<uint8_t> visitCounts;   // Conteo de visitas por celda (satura en 255)
+    
+#ifndef ETG_HEADLESS
     Vector2 GetScreenPos(int x, int y, float hexSize);
-};
\ No newline at end of file
+#endif
+};
@@ -0,0 +1,49 @@
+// RenderBudget.cpp
+#include "RenderBudget.h"
+#include <algorithm>
+
+RenderBudget::RenderBudget() : detail(RenderDetail::FULL), averageFrame(BUDGET_MS), averageDraw(0.0), framesAtLevel(0),
+                               upFrames(UP_FRAMES), steppedUp(false) {}
+
+bool RenderBudget::AddFrame(double frameMillis, double drawMillis) {
+    averageFrame += (frameMillis - averageFrame) * SMOOTHING;
+    averageDraw += (drawMillis - averageDraw) * SMOOTHING;
+    framesAtLevel++;
+    if (steppedUp && framesAtLevel == upFrames) {
+        upFrames = UP_FRAMES;       // El nivel al que se subió aguantó: la espera vuelve a la normal
+    }
+
+    // Bajar: se perdió el ritmo de 60 FPS o el dibujo solo ya se come casi todo el frame
+    bool overBudget = averageFrame > BUDGET_MS * 1.15 || averageDraw > BUDGET_MS * 0.85;
+    if (overBudget && framesAtLevel >= DOWN_FRAMES && detail != RenderDetail::POINTS) {
+        // Histéresis: si recién se subió y no aguantó, la próxima vez se espera el doble
+        if (steppedUp && framesAtLevel < upFrames) {
+            upFrames = std::min(upFrames * 2, MAX_UP_FRAMES);
+        }
+        detail = (RenderDetail)((int)detail + 1);
+        framesAtLevel = 0;
+        steppedUp = false;
+        return true;
+    }
+
+    // Subir: el dibujo usa menos de la mitad del presupuesto y el frame va a tiempo, sostenido
+    bool headroom = averageFrame < BUDGET_MS * 1.05 && averageDraw < BUDGET_MS * 0.45;
+    if (headroom && framesAtLevel >= upFrames && detail != RenderDetail::FULL) {
+        detail = (RenderDetail)((int)detail - 1);
+        framesAtLevel = 0;
+        steppedUp = true;
+        return true;
+    }
+    return false;
+}
+
+const char* RenderBudget::DetailName(RenderDetail detail) {
+    switch (detail) {
+        case RenderDetail::FULL: return "completo";
+        case RenderDetail::NO_SHADOWS: return "sin sombras";
+        case RenderDetail::NO_BORDERS: return "sin bordes";
+        case RenderDetail::FLAT: return "plano";
+        case RenderDetail::POINTS: return "puntos";
+    }
+    return "?";
+}
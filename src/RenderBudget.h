@@ -0,0 +1,41 @@
+// RenderBudget.h, nivel de detalle del dibujo según el tiempo de frame. Cada frame se le pasa lo que duró el
+// frame completo y lo que tardó el dibujo; si no entra en el presupuesto baja un nivel (sin sombras, sin bordes,
+// relleno plano, puntos) y si sobra margen por un rato vuelve a subir. Es solo la cuenta, sin raylib.
+#pragma once
+#include <cstdint>
+
+enum class RenderDetail : uint8_t {
+    FULL,           // Sombras, bordes, brillo y símbolos
+    NO_SHADOWS,
+    NO_BORDERS,     // Tampoco bordes blancos; las gemas y el jugador con un solo círculo
+    FLAT,           // Solo el relleno de cada hexágono
+    POINTS          // Un cuadrado por celda
+};
+
+class RenderBudget {
+public:
+    static constexpr double BUDGET_MS = 1000.0 / 60.0;
+    static constexpr double SMOOTHING = 0.1;        // Peso del frame nuevo en el promedio
+    static constexpr int DOWN_FRAMES = 30;          // Frames mínimos en un nivel antes de bajar
+    static constexpr int UP_FRAMES = 180;           // Frames con margen antes de subir (3 s a 60 FPS)
+    static constexpr int MAX_UP_FRAMES = 1800;      // Tope de la espera si subir vuelve a pasarse
+
+    RenderBudget();
+
+    // frameMillis: frame completo (GetFrameTime, con la espera de vsync); drawMillis: solo el trabajo de dibujo.
+    // Devuelve true si cambió el nivel.
+    bool AddFrame(double frameMillis, double drawMillis);
+
+    RenderDetail Detail() const { return detail; }
+    double AverageFrameMillis() const { return averageFrame; }
+    double AverageDrawMillis() const { return averageDraw; }
+
+    static const char* DetailName(RenderDetail detail);
+
+private:
+    RenderDetail detail;
+    double averageFrame, averageDraw;
+    int framesAtLevel;
+    int upFrames;                   // Espera actual para subir; se duplica si al subir hubo que bajar enseguida
+    bool steppedUp;                 // El último cambio fue hacia arriba
+};
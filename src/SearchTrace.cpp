@@ -0,0 +1,100 @@
+// SearchTrace.cpp
+#include "SearchTrace.h"
+#include <algorithm>
+
+SearchTrace::SearchTrace() : publishCount(0), cancelled(false), sinceCheck(0) {}
+
+void SearchTrace::Begin(int width, int height, int searchId) {
+    size_t cellCount = (size_t)width * height;
+    size_t chunkCount = (cellCount + SearchSnapshot::CHUNK_CELLS - 1) / SearchSnapshot::CHUNK_CELLS;
+    // Los arreglos se reusan entre búsquedas del mismo tamaño: alcanza con cambiar de generación
+    if (working.cells.size() != cellCount) {
+        working.cells.assign(cellCount, SearchCell());
+        chunkChanged.assign(chunkCount, 0);
+    }
+    working.searchId = searchId;
+    working.width = width;
+    working.height = height;
+    working.expansions = 0;
+    working.maxExpanded = 0;
+    working.finished = false;
+    working.generation++;
+    cancelled.store(false, std::memory_order_relaxed);
+    sinceCheck = 0;
+
+    // Enseguida un snapshot sin celdas, así el dibujo deja de mostrar la búsqueda anterior sin pagar una copia:
+    // con la generación nueva ninguna celda cuenta todavía
+    SearchSnapshot& snapshot = snapshots.WriteBuffer();
+    snapshot.searchId = searchId;
+    snapshot.width = width;
+    snapshot.height = height;
+    snapshot.expansions = 0;
+    snapshot.maxExpanded = 0;
+    snapshot.finished = false;
+    snapshot.generation = working.generation;
+    snapshot.version = ++publishCount;
+    if (snapshot.cells.size() != cellCount) {
+        snapshot.cells.clear();
+    }
+    snapshots.Publish();
+    lastPublish = std::chrono::steady_clock::now();
+}
+
+// Al terminar los arreglos de trabajo ya no hacen falta: se intercambian con el buffer en vez de copiarse. Lo que
+// vuelve al solver son celdas de otra publicación, pero la próxima búsqueda las limpia al tocarlas (Begin cambia
+// de generación); a los otros buffers les sigue llegando todo bloque que cambie, porque chunkChanged no se toca.
+void SearchTrace::Finish() {
+    working.finished = true;
+    SearchSnapshot& snapshot = snapshots.WriteBuffer();
+    if (snapshot.cells.size() != working.cells.size()) {
+        Publish();
+        return;
+    }
+    snapshot.cells.swap(working.cells);
+    snapshot.searchId = working.searchId;
+    snapshot.width = working.width;
+    snapshot.height = working.height;
+    snapshot.expansions = working.expansions;
+    snapshot.maxExpanded = working.maxExpanded;
+    snapshot.finished = true;
+    snapshot.generation = working.generation;
+    snapshot.version = ++publishCount;
+    snapshots.Publish();
+}
+
+// El reloj se mira cada PUBLISH_CHECK_EXPANSIONS y se copia a lo sumo una vez por PUBLISH_INTERVAL_MS:
+// como solo viajan los bloques tocados, la copia sigue a la frontera y no al tamaño del mapa
+void SearchTrace::MaybePublish() {
+    sinceCheck = 0;
+    auto now = std::chrono::steady_clock::now();
+    if (std::chrono::duration<double, std::milli>(now - lastPublish).count() >= PUBLISH_INTERVAL_MS) {
+        Publish();
+    }
+}
+
+void SearchTrace::Publish() {
+    SearchSnapshot& snapshot = snapshots.WriteBuffer();
+    size_t cellCount = working.cells.size();
+    uint64_t copiedUpTo = snapshot.version;
+    if (snapshot.cells.size() != cellCount) {
+        // Buffer de otro tamaño (o vaciado por Begin): se copia todo lo que se tocó alguna vez
+        snapshot.cells.assign(cellCount, SearchCell());
+        copiedUpTo = 0;
+    }
+    for (size_t chunk = 0; chunk < chunkChanged.size(); chunk++) {
+        if (chunkChanged[chunk] <= copiedUpTo) continue;
+        size_t begin = chunk * SearchSnapshot::CHUNK_CELLS;
+        size_t end = std::min(begin + SearchSnapshot::CHUNK_CELLS, cellCount);
+        std::copy(working.cells.begin() + begin, working.cells.begin() + end, snapshot.cells.begin() + begin);
+    }
+    snapshot.searchId = working.searchId;
+    snapshot.width = working.width;
+    snapshot.height = working.height;
+    snapshot.expansions = working.expansions;
+    snapshot.maxExpanded = working.maxExpanded;
+    snapshot.finished = working.finished;
+    snapshot.generation = working.generation;
+    snapshot.version = ++publishCount;
+    snapshots.Publish();
+    lastPublish = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,117 @@
+// SearchTrace.h, progreso de una búsqueda celda por celda (expandida, en la frontera, primer turno de llegada).
+// El solver lo anota en arreglos propios y cada tanto lo publica sin locks; el dibujo lo muestra como mapa
+// de calor mientras la búsqueda corre en otro hilo. Cada celda guarda de qué búsqueda es (una celda de otra se lee
+// como vacía), así Begin no limpia el mapa entero, y cada publicación copia solo los bloques de CHUNK_CELLS celdas
+// que cambiaron desde la última vez que se usó ese buffer.
+#pragma once
+#include "SimulationChannels.h"
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Lo de una celda junto, así cada anotación toca una sola línea de caché
+struct SearchCell {
+    uint16_t expandedCount = 0;             // Nodos cerrados en la celda (uno por turno distinto, satura)
+    uint16_t openCount = 0;                 // Nodos de la celda que siguen en la frontera
+    int32_t earliestTurn = -1;              // Primer turno en que se generó la celda (-1 = nunca)
+    uint32_t generation = 0;                // Búsqueda (interna de SearchTrace) que escribió la celda
+};
+
+struct SearchSnapshot {
+    static const int CHUNK_CELLS = 64;
+
+    int searchId = 0;                       // El que pasó Begin, para no mostrar la búsqueda de otro nivel
+    int width = 0, height = 0;
+    int expansions = 0;
+    int maxExpanded = 0;                    // Mayor expandedCount, para normalizar el color
+    bool finished = false;
+    uint32_t generation = 0;                // Búsqueda interna de SearchTrace
+    uint64_t version = 0;                   // Publicación de la que salió este buffer
+    // Vacío en el snapshot de Begin si cambió el tamaño; si no, puede traer celdas de búsquedas anteriores:
+    // leer siempre con Reached
+    std::vector<SearchCell> cells;
+
+    // true si esta búsqueda llegó a la celda; recién ahí vale cells[index]
+    bool Reached(size_t index) const {
+        return cells[index].generation == generation && cells[index].earliestTurn >= 0;
+    }
+};
+
+class SearchTrace {
+public:
+    static const int PUBLISH_CHECK_EXPANSIONS = 256;     // Cada cuántas expansiones se mira el reloj
+    static constexpr double PUBLISH_INTERVAL_MS = 16.0;  // Un snapshot por frame alcanza
+
+    SearchTrace();
+
+    SearchTrace(const SearchTrace&) = delete;
+    SearchTrace& operator=(const SearchTrace&) = delete;
+
+    // Lado del solver, siempre desde un solo hilo a la vez. Begin va antes de lanzar el hilo del solver
+    // y también borra un Cancel anterior.
+    void Begin(int width, int height, int searchId);
+    void Finish();
+
+    void OnGenerated(int x, int y, int turn) {
+        size_t index = (size_t)y * working.width + x;
+        SearchCell& cell = Touch(index);
+        cell.openCount++;
+        if (cell.earliestTurn < 0 || turn < cell.earliestTurn) {
+            cell.earliestTurn = turn;
+        }
+    }
+
+    void OnExpanded(int x, int y) {
+        size_t index = (size_t)y * working.width + x;
+        SearchCell& cell = Touch(index);
+        cell.openCount--;
+        if (cell.expandedCount < UINT16_MAX) {
+            int count = ++cell.expandedCount;
+            working.maxExpanded = count > working.maxExpanded ? count : working.maxExpanded;
+        }
+        working.expansions++;
+        if (++sinceCheck == PUBLISH_CHECK_EXPANSIONS) {
+            MaybePublish();
+        }
+    }
+
+    // Desde cualquier hilo; el solver lo revisa junto con su límite de tiempo
+    void Cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool Cancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+    // Lado del dibujo: true si llegó un snapshot nuevo
+    bool Update() { return snapshots.Update(); }
+    SearchSnapshot& Latest() { return snapshots.ReadBuffer(); }
+
+    // Lo que ocupan los arreglos por celda de un grid así: el del solver y los tres del triple buffer
+    static size_t BytesFor(int width, int height) {
+        size_t cellCount = (size_t)width * height;
+        size_t chunkCount = (cellCount + SearchSnapshot::CHUNK_CELLS - 1) / SearchSnapshot::CHUNK_CELLS;
+        return 4 * cellCount * sizeof(SearchCell) + chunkCount * sizeof(uint64_t);
+    }
+
+private:
+    SearchSnapshot working;                 // Solo la toca el solver
+    std::vector<uint64_t> chunkChanged;     // Publicación en la que cambió cada bloque por última vez
+    uint64_t publishCount;                  // Las anotaciones de ahora salen en la publicación publishCount + 1
+    TripleBuffer<SearchSnapshot> snapshots;
+    std::atomic<bool> cancelled;
+    int sinceCheck;
+    std::chrono::steady_clock::time_point lastPublish;
+
+    // Limpia la celda la primera vez que esta búsqueda la toca y marca su bloque para la próxima publicación
+    SearchCell& Touch(size_t index) {
+        SearchCell& cell = working.cells[index];
+        if (cell.generation != working.generation) {
+            cell = SearchCell();
+            cell.generation = working.generation;
+        }
+        chunkChanged[index / SearchSnapshot::CHUNK_CELLS] = publishCount + 1;
+        return cell;
+    }
+
+    void MaybePublish();
+    void Publish();
+};
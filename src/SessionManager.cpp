@@ -0,0 +1,191 @@
+// SessionManager.cpp
+#include "SessionManager.h"
+#include "HexDirections.h"
+#include "Player.h"
+#include <algorithm>
+#include <atomic>
+
+Session::Session() : x(0), y(0), turn(0), score(0), moveCount(0), itemCount(0), state(GameState::PLAYING), itemWordOffset(0) {}
+
+Session::Session(std::shared_ptr<const SharedLevel> sharedLevel) : Session() {
+    level = std::move(sharedLevel);
+    size_t cellWords = (level->CellCount() + 63) / 64;
+    size_t itemWords = ((size_t)level->ItemCount() + 63) / 64;
+    bits.assign(cellWords + itemWords, 0);
+    itemWordOffset = cellWords;
+    Reset();
+}
+
+// Como Grid::ResetState + Player::Reset: solo se limpian los bits, sin reservar memoria
+void Session::Reset() {
+    std::fill(bits.begin(), bits.end(), 0);
+    x = level->startPos.x;
+    y = level->startPos.y;
+    turn = 0;
+    score = Player::START_SCORE;
+    moveCount = 0;
+    itemCount = 0;
+    state = GameState::PLAYING;
+
+    int start = y * level->width + x;
+    bits[start >> 6] |= 1ull << (start & 63);
+}
+
+// Mismo orden que Game::ApplyClick: validar, pisar la celda (penalización, item, turno) y después
+// chequear victoria o estado sin salida con la tabla del nivel
+bool Session::Move(int toX, int toY) {
+    if (state != GameState::PLAYING || toX < 0 || toX >= level->width || toY < 0 || toY >= level->height) {
+        return false;
+    }
+    int target = toY * level->width + toX;
+    if (!level->IsOpen(target, turn) || HexDirectionBetween(x, y, toX, toY) < 0) {
+        return false;
+    }
+
+    if (HasVisited(target)) {
+        score = std::max(0, score - Player::BACKTRACK_PENALTY);
+    }
+    x = toX;
+    y = toY;
+    bits[target >> 6] |= 1ull << (target & 63);
+
+    int item = level->ItemIndex(target);
+    if (item >= 0 && !HasItem(item)) {
+        bits[itemWordOffset + (item >> 6)] |= 1ull << (item & 63);
+        itemCount++;
+        score += GameRules::ITEM_SCORE;
+    }
+    moveCount++;
+    turn++;
+
+    if (x == level->goalPos.x && y == level->goalPos.y) {
+        state = GameState::WIN;
+    } else if (level->TimeToGoal().Ready() && !level->TimeToGoal().CanReachGoal(x, y, turn)) {
+        state = GameState::GAME_OVER;
+    }
+    return true;
+}
+
+bool Session::HasItem(int item) const {
+    return (bits[itemWordOffset + (item >> 6)] >> (item & 63)) & 1;
+}
+
+size_t Session::MemoryBytes() const {
+    return sizeof(Session) + bits.capacity() * sizeof(uint64_t);
+}
+
+SessionManager::SessionManager(unsigned threadCount) : pool(threadCount) {}
+
+std::shared_ptr<const SharedLevel> SessionManager::AddLevel(const std::string& key, const LevelData& levelData) {
+    auto found = levels.find(key);
+    if (found != levels.end()) {
+        return found->second;
+    }
+    auto level = std::make_shared<SharedLevel>();
+    if (!level->Build(levelData)) {
+        return nullptr;
+    }
+    levels[key] = level;
+    return level;
+}
+
+std::shared_ptr<const SharedLevel> SessionManager::FindLevel(const std::string& key) const {
+    auto found = levels.find(key);
+    return found != levels.end() ? found->second : nullptr;
+}
+
+int SessionManager::CreateSession(const std::shared_ptr<const SharedLevel>& level) {
+    if (level == nullptr) {
+        return -1;
+    }
+    sessions.emplace_back(level);
+    inputs.emplace_back();
+    return (int)sessions.size() - 1;
+}
+
+// Suelta la referencia al nivel y los bits; el lugar queda para que los ids no cambien
+void SessionManager::CloseSession(int id) {
+    if (id < 0 || id >= (int)sessions.size()) {
+        return;
+    }
+    sessions[id] = Session();
+    inputs[id] = SessionInput();
+}
+
+bool SessionManager::PostMove(int id, int x, int y) {
+    SessionInput input;
+    input.type = SessionInputType::MOVE;
+    input.x = x;
+    input.y = y;
+    return Post(id, input);
+}
+
+bool SessionManager::PostReset(int id) {
+    SessionInput input;
+    input.type = SessionInputType::RESET;
+    return Post(id, input);
+}
+
+bool SessionManager::Post(int id, const SessionInput& input) {
+    if (id < 0 || id >= (int)sessions.size() || sessions[id].level == nullptr ||
+        inputs[id].type != SessionInputType::NONE) {
+        return false;
+    }
+    inputs[id] = input;
+    return true;
+}
+
+bool SessionManager::Apply(Session& session, const SessionInput& input) {
+    switch (input.type) {
+        case SessionInputType::MOVE:
+            return session.Move(input.x, input.y);
+        case SessionInputType::RESET:
+            session.Reset();
+            return false;
+        case SessionInputType::NONE:
+            break;
+    }
+    return false;
+}
+
+long long SessionManager::Step(const Controller& controller) {
+    std::atomic<long long> accepted{0};
+    int count = (int)sessions.size();
+
+    for (int first = 0; first < count; first += SESSIONS_PER_TASK) {
+        int last = std::min(count, first + SESSIONS_PER_TASK);
+        pool.Submit([this, &controller, &accepted, first, last]() {
+            long long moves = 0;
+            for (int id = first; id < last; id++) {
+                Session& session = sessions[id];
+                if (session.level == nullptr) continue;
+
+                SessionInput input = inputs[id];
+                inputs[id] = SessionInput();
+                if (input.type == SessionInputType::NONE && controller) {
+                    input = controller(id, session);
+                }
+                if (Apply(session, input)) moves++;
+            }
+            accepted.fetch_add(moves, std::memory_order_relaxed);
+        });
+    }
+    pool.Wait();
+    return accepted.load();
+}
+
+size_t SessionManager::SessionBytes() const {
+    size_t bytes = inputs.capacity() * sizeof(SessionInput) + (sessions.capacity() - sessions.size()) * sizeof(Session);
+    for (const Session& session : sessions) {
+        bytes += session.MemoryBytes();
+    }
+    return bytes;
+}
+
+size_t SessionManager::LevelBytes() const {
+    size_t bytes = 0;
+    for (const auto& level : levels) {
+        bytes += level.second->MemoryBytes();
+    }
+    return bytes;
+}
@@ -0,0 +1,102 @@
+// SessionManager.h, muchas partidas headless en un mismo proceso (bots, torneos). El nivel se comparte entre
+// sesiones como SharedLevel inmutable; cada sesión guarda solo lo que cambia al jugar: posición, turno, puntaje,
+// celdas visitadas e items recogidos, en bits. Step aplica un movimiento por sesión en paralelo sobre el pool.
+#pragma once
+#include "GameRules.h"
+#include "SharedLevel.h"
+#include "WorkStealingPool.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Estado mutable de una partida sobre un SharedLevel, con las mismas reglas que Game::ApplyClick
+class Session {
+public:
+    std::shared_ptr<const SharedLevel> level;   // nullptr = sesión cerrada
+    int x, y;
+    int turn;
+    int score;
+    int moveCount;
+    int itemCount;
+    GameState state;
+
+    Session();
+    explicit Session(std::shared_ptr<const SharedLevel> sharedLevel);
+
+    void Reset();
+
+    // Click en (toX, toY): false si la partida terminó o el movimiento no es válido (y entonces no cambia nada)
+    bool Move(int toX, int toY);
+
+    bool HasVisited(int index) const { return (bits[index >> 6] >> (index & 63)) & 1; }
+    bool HasItem(int item) const;
+
+    size_t MemoryBytes() const;
+
+private:
+    std::vector<uint64_t> bits;     // Primero un bit por celda visitada, después uno por item recogido
+    size_t itemWordOffset;
+};
+
+enum class SessionInputType : uint8_t {
+    NONE,
+    MOVE,
+    RESET
+};
+
+struct SessionInput {
+    SessionInputType type = SessionInputType::NONE;
+    int x = 0, y = 0;
+};
+
+class SessionManager {
+public:
+    static const int SESSIONS_PER_TASK = 256;
+
+    // Bots dentro del proceso: se consulta en el hilo del pool para cada sesión sin entrada pendiente en el Step
+    using Controller = std::function<SessionInput(int id, const Session& session)>;
+
+    // 0 hilos = uno por núcleo
+    explicit SessionManager(unsigned threadCount = 0);
+
+    SessionManager(const SessionManager&) = delete;
+    SessionManager& operator=(const SessionManager&) = delete;
+
+    // Compila el nivel la primera vez que se pide la clave; después devuelve el mismo. nullptr si no es válido.
+    std::shared_ptr<const SharedLevel> AddLevel(const std::string& key, const LevelData& levelData);
+    std::shared_ptr<const SharedLevel> FindLevel(const std::string& key) const;
+
+    // Los ids no se reutilizan. Las referencias que devuelve GetSession valen hasta el próximo CreateSession.
+    int CreateSession(const std::shared_ptr<const SharedLevel>& level);
+    void CloseSession(int id);
+    Session& GetSession(int id) { return sessions[id]; }
+    const Session& GetSession(int id) const { return sessions[id]; }
+    int SessionCount() const { return (int)sessions.size(); }
+
+    // Entradas para el próximo Step, desde un solo hilo y entre Steps. Una por sesión y por Step:
+    // false si la sesión no existe, está cerrada o ya tiene una entrada pendiente.
+    bool PostMove(int id, int x, int y);
+    bool PostReset(int id);
+
+    // Aplica las entradas pendientes (y las del controller) a todas las sesiones abiertas, en bloques de
+    // SESSIONS_PER_TASK por tarea. Cada sesión la toca un solo hilo; el nivel compartido solo se lee.
+    // Devuelve cuántos movimientos se aceptaron.
+    long long Step(const Controller& controller = nullptr);
+
+    unsigned ThreadCount() const { return pool.ThreadCount(); }
+    size_t SessionBytes() const;        // Sesiones y entradas pendientes
+    size_t LevelBytes() const;          // Niveles compartidos, una vez cada uno
+
+private:
+    WorkStealingPool pool;
+    std::map<std::string, std::shared_ptr<const SharedLevel>> levels;
+    std::vector<Session> sessions;
+    std::vector<SessionInput> inputs;
+
+    bool Post(int id, const SessionInput& input);
+    static bool Apply(Session& session, const SessionInput& input);
+};
@@ -0,0 +1,485 @@
+// SessionRecording.cpp, codificación de eventos en bytes (varints LEB128 para lo que no entra en el tag)
+#include "SessionRecording.h"
+#include "HexDirections.h"
+#include "ItemRoutePlanner.h"
+#include "LevelBinary.h"
+#include "PathFinder.h"
+#include "TimeToGoalTable.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+
+const int DIR_SAME_CELL = 6;
+const int DIR_ABSOLUTE = 7;
+const int TURN_EXPLICIT = 3;
+
+uint32_t ZigZag(int value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+int UnZigZag(uint32_t value) {
+    return (int)(value >> 1) ^ -(int)(value & 1);
+}
+
+void PushVarint(std::vector<unsigned char>& out, uint32_t value) {
+    while (value >= 0x80) {
+        out.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((unsigned char)value);
+}
+
+class EventReader {
+public:
+    EventReader(const unsigned char* data, size_t size) : data(data), size(size), position(0) {}
+
+    bool AtEnd() const { return position >= size; }
+
+    bool ReadByte(uint8_t& value) {
+        if (position >= size) return false;
+        value = data[position++];
+        return true;
+    }
+
+    bool ReadVarint(uint32_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            uint8_t byte;
+            if (!ReadByte(byte)) return false;
+            value |= (uint32_t)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+
+    bool ReadSigned(int& value) {
+        uint32_t raw;
+        if (!ReadVarint(raw)) return false;
+        value = UnZigZag(raw);
+        return true;
+    }
+
+private:
+    const unsigned char* data;
+    size_t size;
+    size_t position;
+};
+
+bool HasPosition(SessionEventType type) {
+    return type == SessionEventType::CLICK_MOVE || type == SessionEventType::CLICK_REJECTED ||
+           type == SessionEventType::SOLVER_STEP;
+}
+
+bool MovesPlayer(SessionEventType type) {
+    return type == SessionEventType::CLICK_MOVE || type == SessionEventType::SOLVER_STEP;
+}
+
+bool Diverged(ReplayResult& result, int eventIndex, const std::string& error) {
+    result.ok = false;
+    result.divergenceEvent = eventIndex;
+    result.error = error;
+    return false;
+}
+
+std::string Cell(int x, int y) {
+    return "(" + std::to_string(x) + "," + std::to_string(y) + ")";
+}
+
+} // namespace
+
+SessionRecorder::SessionRecorder() : active(false), header(), eventCount(0), lastX(0), lastY(0), expectedTurn(0) {}
+
+void SessionRecorder::Begin(const std::string& key, const LevelData& levelData) {
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, "ETGR", 4);
+    header.version = ETGR_VERSION;
+    header.levelFingerprint = GameRules::LevelFingerprint(levelData);
+    header.width = levelData.width;
+    header.height = levelData.height;
+    header.startX = levelData.startX;
+    header.startY = levelData.startY;
+
+    levelKey = key;
+    events.clear();
+    eventCount = 0;
+    lastX = levelData.startX;
+    lastY = levelData.startY;
+    expectedTurn = 0;
+    active = true;
+}
+
+void SessionRecorder::PushEvent(SessionEventType type, int turn, int x, int y, bool hasPosition) {
+    int direction = 0;
+    if (hasPosition) {
+        direction = (x == lastX && y == lastY) ? DIR_SAME_CELL : HexDirectionBetween(lastX, lastY, x, y);
+        if (direction < 0) direction = DIR_ABSOLUTE;
+    }
+
+    int turnDelta = turn - expectedTurn;
+    int turnCode = (turnDelta >= 0 && turnDelta < TURN_EXPLICIT) ? turnDelta : TURN_EXPLICIT;
+
+    events.push_back((unsigned char)(((int)type << 5) | (direction << 2) | turnCode));
+    if (turnCode == TURN_EXPLICIT) {
+        PushVarint(events, ZigZag(turnDelta));
+    }
+    if (direction == DIR_ABSOLUTE) {
+        PushVarint(events, ZigZag(x));
+        PushVarint(events, ZigZag(y));
+    }
+
+    if (MovesPlayer(type)) {
+        lastX = x;
+        lastY = y;
+        expectedTurn = turn + 1;
+    } else {
+        expectedTurn = turn;
+    }
+    eventCount++;
+}
+
+void SessionRecorder::RecordClick(int turn, int x, int y, bool accepted) {
+    if (!active) return;
+    PushEvent(accepted ? SessionEventType::CLICK_MOVE : SessionEventType::CLICK_REJECTED, turn, x, y, true);
+}
+
+void SessionRecorder::RecordAutoSolve(int turn, int pathLength) {
+    if (!active) return;
+    PushEvent(SessionEventType::AUTO_SOLVE, turn, 0, 0, false);
+    PushVarint(events, (uint32_t)pathLength);
+}
+
+void SessionRecorder::RecordScoreSolve(int turn, int pathLength) {
+    if (!active) return;
+    PushEvent(SessionEventType::SCORE_SOLVE, turn, 0, 0, false);
+    PushVarint(events, (uint32_t)pathLength);
+}
+
+void SessionRecorder::RecordAnytimeSolve(int turn, int remainingSteps) {
+    if (!active) return;
+    PushEvent(SessionEventType::ANYTIME_SOLVE, turn, 0, 0, false);
+    PushVarint(events, (uint32_t)remainingSteps);
+}
+
+void SessionRecorder::RecordSolverStep(int turn, GridPos position) {
+    if (!active) return;
+    PushEvent(SessionEventType::SOLVER_STEP, turn, position.x, position.y, true);
+}
+
+void SessionRecorder::RecordReset() {
+    if (!active) return;
+    PushEvent(SessionEventType::RESET, expectedTurn, 0, 0, false);
+    lastX = header.startX;
+    lastY = header.startY;
+    expectedTurn = 0;
+}
+
+bool SessionRecorder::Finish(const Grid& grid, const Player& player, GameState state, const std::string& filename) {
+    if (!active) return false;
+    active = false;
+
+    PushEvent(SessionEventType::END, grid.currentTurn, 0, 0, false);
+    PushVarint(events, ZigZag(player.score));
+    PushVarint(events, ZigZag(player.x));
+    PushVarint(events, ZigZag(player.y));
+    PushVarint(events, (uint32_t)player.items.size());
+    PushVarint(events, (uint32_t)player.path.Size());
+    PushVarint(events, (uint32_t)state);
+
+    std::vector<unsigned char> payload(levelKey.begin(), levelKey.end());
+    payload.insert(payload.end(), events.begin(), events.end());
+    header.keyLength = (uint32_t)levelKey.size();
+    header.eventBytes = (uint32_t)events.size();
+    header.checksum = LevelBinary::Checksum(payload.data(), payload.size());
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "No se pudo crear el archivo: " << filename << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(payload.data()), (std::streamsize)payload.size());
+    if (!file) {
+        std::cout << "Error escribiendo: " << filename << std::endl;
+        return false;
+    }
+    std::cout << "Partida grabada: " << filename << " (" << eventCount << " eventos, "
+              << sizeof(header) + payload.size() << " bytes)" << std::endl;
+    return true;
+}
+
+bool SessionReplayer::Load(const std::string& filename, SessionRecording& recording) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "No se pudo abrir la grabación: " << filename << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    EtgrHeader header;
+    if (bytes.size() < sizeof(header)) {
+        std::cout << "Grabación truncada: " << filename << std::endl;
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (std::memcmp(header.magic, "ETGR", 4) != 0 || header.version != ETGR_VERSION) {
+        std::cout << "No es una grabación .etgr compatible: " << filename << std::endl;
+        return false;
+    }
+    if ((uint64_t)header.keyLength + header.eventBytes != bytes.size() - sizeof(header)) {
+        std::cout << "Tamaño de grabación inconsistente: " << filename << std::endl;
+        return false;
+    }
+    const unsigned char* payload = bytes.data() + sizeof(header);
+    if (LevelBinary::Checksum(payload, header.keyLength + header.eventBytes) != header.checksum) {
+        std::cout << "Checksum inválido en la grabación: " << filename << std::endl;
+        return false;
+    }
+
+    recording = SessionRecording();
+    recording.levelKey.assign(reinterpret_cast<const char*>(payload), header.keyLength);
+    recording.levelFingerprint = header.levelFingerprint;
+    recording.width = header.width;
+    recording.height = header.height;
+    recording.startX = header.startX;
+    recording.startY = header.startY;
+
+    // Se reconstruyen posición y turno esperado igual que los llevó el grabador
+    EventReader reader(payload + header.keyLength, header.eventBytes);
+    int lastX = header.startX, lastY = header.startY;
+    int expectedTurn = 0;
+    bool ended = false;
+
+    while (!reader.AtEnd() && !ended) {
+        uint8_t tag;
+        reader.ReadByte(tag);
+        SessionEvent event = {};
+        event.type = (SessionEventType)(tag >> 5);
+        int direction = (tag >> 2) & 0x7;
+        int turnCode = tag & 0x3;
+        if (event.type > SessionEventType::ANYTIME_SOLVE) {
+            std::cout << "Evento desconocido en la grabación: " << filename << std::endl;
+            return false;
+        }
+
+        int turnDelta = turnCode;
+        if (turnCode == TURN_EXPLICIT && !reader.ReadSigned(turnDelta)) break;
+        event.turn = expectedTurn + turnDelta;
+
+        if (HasPosition(event.type)) {
+            if (direction == DIR_ABSOLUTE) {
+                if (!reader.ReadSigned(event.x) || !reader.ReadSigned(event.y)) break;
+            } else if (direction == DIR_SAME_CELL) {
+                event.x = lastX;
+                event.y = lastY;
+            } else {
+                const int (*offsets)[2] = HexOffsetsForColumn(lastX);
+                event.x = lastX + offsets[direction][0];
+                event.y = lastY + offsets[direction][1];
+            }
+        }
+
+        if (event.type == SessionEventType::AUTO_SOLVE || event.type == SessionEventType::SCORE_SOLVE ||
+            event.type == SessionEventType::ANYTIME_SOLVE) {
+            uint32_t pathLength;
+            if (!reader.ReadVarint(pathLength)) break;
+            event.value = (int)pathLength;
+        }
+
+        if (event.type == SessionEventType::END) {
+            SessionSummary& final = recording.final;
+            uint32_t itemCount, moveCount, state;
+            if (!reader.ReadSigned(final.score) || !reader.ReadSigned(final.x) || !reader.ReadSigned(final.y) ||
+                !reader.ReadVarint(itemCount) || !reader.ReadVarint(moveCount) || !reader.ReadVarint(state)) break;
+            final.turn = event.turn;
+            final.itemCount = (int)itemCount;
+            final.moveCount = (int)moveCount;
+            final.state = (GameState)state;
+            ended = true;
+            break;
+        }
+
+        if (MovesPlayer(event.type)) {
+            lastX = event.x;
+            lastY = event.y;
+            expectedTurn = event.turn + 1;
+        } else if (event.type == SessionEventType::RESET) {
+            lastX = header.startX;
+            lastY = header.startY;
+            expectedTurn = 0;
+        } else {
+            expectedTurn = event.turn;
+        }
+        recording.events.push_back(event);
+    }
+
+    if (!ended || !reader.AtEnd()) {
+        std::cout << "Grabación corrupta o sin cierre: " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool SessionReplayer::Replay(const SessionRecording& recording, Grid& grid, Player& player, ReplayResult& result) {
+    result = ReplayResult();
+    if (grid.width != recording.width || grid.height != recording.height ||
+        grid.startPos.x != recording.startX || grid.startPos.y != recording.startY) {
+        result.error = "el nivel no coincide con el de la grabación";
+        return false;
+    }
+
+    grid.ResetState();
+    player.Reset(grid.startPos.x, grid.startPos.y);
+    PathFinder pathFinder(&grid);
+    pathFinder.verbose = false;
+    TimeToGoalTable timeToGoal;
+    timeToGoal.Build(grid);
+
+    GameState state = GameState::PLAYING;
+    std::vector<GridPos> solutionPath;
+    int solutionStep = 0;
+    int anytimeLength = 0;      // Con camino del anytime: largo total; sus pasos se validan en vez de compararse
+    GridPos anytimeFrom = {0, 0};
+
+    for (size_t i = 0; i < recording.events.size(); i++) {
+        const SessionEvent& event = recording.events[i];
+        int index = (int)i;
+        bool checksTurn = event.type != SessionEventType::RESET;
+        if (checksTurn && event.turn != grid.currentTurn) {
+            return Diverged(result, index, "turno " + std::to_string(grid.currentTurn) + ", la grabación dice " +
+                                           std::to_string(event.turn));
+        }
+
+        switch (event.type) {
+            case SessionEventType::CLICK_MOVE:
+            case SessionEventType::CLICK_REJECTED: {
+                // HandleMouseInput y después, en el mismo cuadro, grid->Update() y el chequeo de victoria
+                bool accepted = GameRules::ApplyPlayerMove(grid, player, event.x, event.y);
+                if (accepted != (event.type == SessionEventType::CLICK_MOVE)) {
+                    return Diverged(result, index, std::string("click en ") + Cell(event.x, event.y) +
+                                                   (accepted ? " aceptado" : " rechazado") + ", en la grabación no");
+                }
+                grid.Update();
+                if (GameRules::IsWon(grid, player)) {
+                    state = GameState::WIN;
+                } else if (timeToGoal.Ready() && !timeToGoal.CanReachGoal(player.x, player.y, grid.currentTurn)) {
+                    state = GameState::GAME_OVER;   // Como Game::ApplyClick: ya no se llega a la meta
+                }
+                break;
+            }
+
+            case SessionEventType::AUTO_SOLVE:
+            case SessionEventType::SCORE_SOLVE:
+                // El planner por puntaje no tiene límites de tiempo, así que da el mismo camino que en la partida
+                if (event.type == SessionEventType::AUTO_SOLVE) {
+                    solutionPath = pathFinder.FindPathAStar();
+                } else {
+                    solutionPath = ItemRoutePlanner::PlanFor(grid, player).path;
+                }
+                if ((int)solutionPath.size() != event.value) {
+                    return Diverged(result, index, "el auto-solve encontró " + std::to_string(solutionPath.size()) +
+                                                   " pasos, la grabación " + std::to_string(event.value));
+                }
+                if (!solutionPath.empty()) {
+                    state = GameState::AUTO_SOLVING;
+                    solutionStep = 0;
+                    anytimeLength = 0;
+                }
+                break;
+
+            case SessionEventType::ANYTIME_SOLVE:
+                // Qué camino tenía el ARA* en cada momento depende del reloj: no se recalcula, se valida paso a paso
+                if (state == GameState::PLAYING && event.value > 0) {
+                    state = GameState::AUTO_SOLVING;
+                    solutionPath.clear();
+                    solutionStep = 0;
+                    anytimeLength = event.value;
+                } else if (state == GameState::AUTO_SOLVING && anytimeLength > 0 && event.value > 0) {
+                    anytimeLength = solutionStep + event.value;
+                } else if (event.value > 0) {
+                    return Diverged(result, index, "camino del anytime sin auto-solve que lo use");
+                }
+                break;
+
+            case SessionEventType::SOLVER_STEP: {
+                if (anytimeLength > 0) {
+                    // Como en la búsqueda: el paso k sale de la celda de inicio en el turno 0 y llega en el turno k
+                    GridPos next = {event.x, event.y};
+                    bool valid = solutionStep == 0 ? next == grid.startPos
+                                                   : pathFinder.IsValidMoveAtTurn(anytimeFrom.x, anytimeFrom.y, next.x, next.y, solutionStep);
+                    if (!valid) {
+                        return Diverged(result, index, "paso automático inválido a " + Cell(next.x, next.y) +
+                                                       " (paso " + std::to_string(solutionStep) + ")");
+                    }
+                    GameRules::ApplySolverStep(grid, player, next);
+                    anytimeFrom = next;
+                    solutionStep++;
+                    if (solutionStep >= anytimeLength) {
+                        state = GameRules::IsWon(grid, player) ? GameState::WIN : GameState::PLAYING;
+                        anytimeLength = 0;
+                    }
+                    grid.Update();
+                    break;
+                }
+                if (solutionStep >= (int)solutionPath.size()) {
+                    return Diverged(result, index, "paso automático sin camino pendiente");
+                }
+                GridPos next = solutionPath[solutionStep];
+                if (next.x != event.x || next.y != event.y) {
+                    return Diverged(result, index, "paso automático a " + Cell(next.x, next.y) + ", la grabación va a " +
+                                                   Cell(event.x, event.y));
+                }
+                GameRules::ApplySolverStep(grid, player, next);
+                solutionStep++;
+                if (solutionStep >= (int)solutionPath.size()) {
+                    state = GameRules::IsWon(grid, player) ? GameState::WIN : GameState::PLAYING;
+                }
+                grid.Update();
+                break;
+            }
+
+            case SessionEventType::RESET:
+                grid.ResetState();
+                player.Reset(grid.startPos.x, grid.startPos.y);
+                solutionPath.clear();
+                solutionStep = 0;
+                anytimeLength = 0;
+                state = GameState::PLAYING;
+                break;
+
+            case SessionEventType::END:
+                break;
+        }
+        result.eventsApplied++;
+    }
+
+    SessionSummary& final = result.final;
+    final.score = player.score;
+    final.x = player.x;
+    final.y = player.y;
+    final.turn = grid.currentTurn;
+    final.itemCount = (int)player.items.size();
+    final.moveCount = player.path.Size();
+    final.state = state;
+
+    const SessionSummary& expected = recording.final;
+    int endIndex = (int)recording.events.size();
+    if (final.score != expected.score) {
+        return Diverged(result, endIndex, "puntaje " + std::to_string(final.score) + ", la grabación " + std::to_string(expected.score));
+    }
+    if (final.x != expected.x || final.y != expected.y || final.turn != expected.turn) {
+        return Diverged(result, endIndex, "termina en " + Cell(final.x, final.y) + " turno " + std::to_string(final.turn) +
+                                          ", la grabación en " + Cell(expected.x, expected.y) + " turno " + std::to_string(expected.turn));
+    }
+    if (final.itemCount != expected.itemCount || final.moveCount != expected.moveCount) {
+        return Diverged(result, endIndex, "items o largo del camino distintos");
+    }
+    if (final.state != expected.state) {
+        return Diverged(result, endIndex, "estado final distinto");
+    }
+
+    result.ok = true;
+    return true;
+}
@@ -0,0 +1,111 @@
+// SessionRecording.h, grabación binaria compacta de una partida (.etgr) y su replayer headless.
+// Se guardan los clicks, el pedido de auto-solve (A* o por puntaje) y cada paso automático con su turno; el replayer los vuelve
+// a pasar por GameRules sin reloj ni raylib y compara puntaje y estado final.
+#pragma once
+#include "FileLoader.h"
+#include "GameRules.h"
+#include "Grid.h"
+#include "Player.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Encabezado fijo; después vienen la clave del nivel y el flujo de eventos. Little-endian como el .etgl
+const uint32_t ETGR_VERSION = 1;
+
+struct EtgrHeader {
+    char magic[4];              // "ETGR"
+    uint32_t version;
+    uint64_t levelFingerprint;  // GameRules::LevelFingerprint del nivel grabado
+    int32_t width, height;
+    int32_t startX, startY;
+    uint32_t keyLength;         // Ruta del nivel o "pack:<índice>"
+    uint32_t eventBytes;
+    uint64_t checksum;          // FNV-1a 64 de la clave y los eventos
+};
+
+// Cada evento ocupa un byte en el caso común: 3 bits de tipo, 3 de dirección hexagonal desde la posición
+// del jugador y 2 de turno (0 = el turno esperado, 3 = viene la diferencia aparte)
+enum class SessionEventType : uint8_t {
+    CLICK_MOVE = 0,             // Click aceptado, el jugador se movió
+    CLICK_REJECTED = 1,         // Click sobre una celda a la que no se podía ir
+    AUTO_SOLVE = 2,             // Se pidió el auto-solve; lleva el largo del camino encontrado (0 = sin camino)
+    SOLVER_STEP = 3,
+    RESET = 4,
+    END = 5,
+    SCORE_SOLVE = 6,            // Auto-solve por puntaje (ItemRoutePlanner); lleva el largo del camino como AUTO_SOLVE
+    ANYTIME_SOLVE = 7           // Camino del anytime adoptado o reemplazado; lleva los pasos que faltan (0 = sin camino)
+};
+
+struct SessionEvent {
+    SessionEventType type;
+    int turn;                   // grid->currentTurn al momento del evento
+    int x, y;                   // Celda del click o del paso
+    int value;                  // AUTO_SOLVE y SCORE_SOLVE: largo del camino; ANYTIME_SOLVE: pasos que faltan
+};
+
+// Estado al cerrar la sesión, lo que el replayer tiene que reproducir
+struct SessionSummary {
+    int score = 0;
+    int x = 0, y = 0;
+    int turn = 0;
+    int itemCount = 0;
+    int moveCount = 0;          // Posiciones en el camino del jugador
+    GameState state = GameState::PLAYING;
+};
+
+struct SessionRecording {
+    std::string levelKey;
+    uint64_t levelFingerprint = 0;
+    int width = 0, height = 0;
+    int startX = 0, startY = 0;
+    std::vector<SessionEvent> events;
+    SessionSummary final;
+};
+
+class SessionRecorder {
+public:
+    SessionRecorder();
+
+    void Begin(const std::string& levelKey, const LevelData& levelData);
+    bool IsActive() const { return active; }
+    int EventCount() const { return eventCount; }
+
+    void RecordClick(int turn, int x, int y, bool accepted);
+    void RecordAutoSolve(int turn, int pathLength);
+    void RecordScoreSolve(int turn, int pathLength);
+    void RecordAnytimeSolve(int turn, int remainingSteps);
+    void RecordSolverStep(int turn, GridPos position);
+    void RecordReset();
+
+    // Cierra la sesión con el estado final y la escribe; queda inactivo aunque falle la escritura
+    bool Finish(const Grid& grid, const Player& player, GameState state, const std::string& filename);
+
+private:
+    bool active;
+    EtgrHeader header;
+    std::string levelKey;
+    std::vector<unsigned char> events;
+    int eventCount;
+    int lastX, lastY;           // Posición del jugador según los eventos, igual que la reconstruye el lector
+    int expectedTurn;
+
+    void PushEvent(SessionEventType type, int turn, int x, int y, bool hasPosition);
+};
+
+struct ReplayResult {
+    bool ok = false;
+    std::string error;          // Motivo de la primera divergencia
+    int divergenceEvent = -1;   // Índice del evento que no coincidió (-1 si todo coincidió o falló antes)
+    int eventsApplied = 0;
+    SessionSummary final;
+};
+
+class SessionReplayer {
+public:
+    static bool Load(const std::string& filename, SessionRecording& recording);
+
+    // Re-ejecuta la sesión sobre un grid y un jugador ya armados para el nivel (se reinician antes de empezar).
+    // Sigue el mismo orden que Game::Update: mover, actualizar compuertas, chequear victoria.
+    static bool Replay(const SessionRecording& recording, Grid& grid, Player& player, ReplayResult& result);
+};
@@ -0,0 +1,60 @@
+// SharedLevel.cpp
+#include "SharedLevel.h"
+#include "Grid.h"
+#include <iostream>
+
+SharedLevel::SharedLevel() : width(0), height(0), cycle(1), startPos{0, 0}, goalPos{0, 0}, itemCount(0) {}
+
+// Se pasa por un Grid para heredar tal cual cómo interpreta el nivel (caracteres, directivas, items); el
+// Grid se descarta al terminar y lo único que queda son las tablas planas
+bool SharedLevel::Build(const LevelData& levelData) {
+    if (levelData.width <= 0 || levelData.height <= 0 || levelData.turnCycleLength <= 0) {
+        std::cout << "Nivel compartido inválido: " << levelData.width << "x" << levelData.height
+                  << ", ciclo " << levelData.turnCycleLength << std::endl;
+        return false;
+    }
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+    return Build(grid);
+}
+
+// Del estado del grid solo se leen tipos, patrones y turnos de apertura; los items ya recogidos (FREE) quedan afuera
+bool SharedLevel::Build(const Grid& grid) {
+    if (grid.width <= 0 || grid.height <= 0 || grid.turnCycleLength <= 0) {
+        std::cout << "Nivel compartido inválido: " << grid.width << "x" << grid.height << ", ciclo "
+                  << grid.turnCycleLength << std::endl;
+        return false;
+    }
+    if (grid.startPos.x < 0 || grid.startPos.x >= grid.width || grid.startPos.y < 0 || grid.startPos.y >= grid.height ||
+        grid.goalPos.x < 0 || grid.goalPos.x >= grid.width || grid.goalPos.y < 0 || grid.goalPos.y >= grid.height) {
+        std::cout << "Nivel compartido con inicio o meta fuera del mapa" << std::endl;
+        return false;
+    }
+
+    width = grid.width;
+    height = grid.height;
+    cycle = grid.turnCycleLength;
+    startPos = grid.startPos;
+    goalPos = grid.goalPos;
+    size_t cellCount = CellCount();
+
+    itemIndex.assign(cellCount, -1);
+    itemCount = 0;
+    for (size_t index = 0; index < cellCount; index++) {
+        if (grid.cells[index].type == CellType::ITEM) {
+            itemIndex[index] = itemCount++;
+        }
+    }
+
+    // Sin distancias se juega igual (sin fin de partida anticipado); sin el horario de paso no hay nivel
+    timeToGoal.Build(grid);
+    if (!timeToGoal.HasSchedule()) {
+        std::cout << "Nivel compartido sin memoria para el horario de paso" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+size_t SharedLevel::MemoryBytes() const {
+    return sizeof(SharedLevel) + itemIndex.capacity() * sizeof(int32_t) + timeToGoal.MemoryBytes();
+}
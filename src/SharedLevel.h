@@ -0,0 +1,44 @@
+// SharedLevel.h, contenido inmutable de un nivel listo para simular: cuándo deja pasar cada celda, dónde hay
+// items y la tabla de turnos a la meta. Se arma una vez por nivel y lo comparten por shared_ptr todas las
+// sesiones que lo juegan; después de Build nadie lo modifica, así que se lee desde cualquier hilo sin locks.
+#pragma once
+#include "FileLoader.h"
+#include "GridPos.h"
+#include "TimeToGoalTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Grid;
+
+class SharedLevel {
+public:
+    int width, height;
+    int cycle;
+    GridPos startPos, goalPos;
+
+    SharedLevel();
+
+    // Copia las reglas de Grid::LoadFromLevelData y Grid::UpdateGatesAndWalls; false si el nivel es inválido
+    bool Build(const LevelData& levelData);
+    bool Build(const Grid& grid);
+
+    size_t CellCount() const { return (size_t)width * height; }
+
+    // El horario de paso es el de la tabla de turnos a la meta (se arma aunque sus distancias no entren)
+    bool IsOpen(int index, int turn) const { return timeToGoal.IsOpen(index, turn); }
+    bool IsWall(int index) const { return timeToGoal.IsWall(index); }
+
+    // Índice del item en la celda (para los bits de la sesión), -1 si no hay
+    int ItemIndex(int index) const { return itemIndex[index]; }
+    int ItemCount() const { return itemCount; }
+
+    const TimeToGoalTable& TimeToGoal() const { return timeToGoal; }
+
+    size_t MemoryBytes() const;
+
+private:
+    std::vector<int32_t> itemIndex;
+    int itemCount;
+    TimeToGoalTable timeToGoal;
+};
@@ -0,0 +1,86 @@
+// SimulationChannels.h, comunicación sin locks entre el hilo de simulación y el de dibujo:
+// un triple buffer para el snapshot (simulación -> dibujo) y una cola de comandos (dibujo -> simulación).
+// Los dos son de un solo productor y un solo consumidor.
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// El escritor siempre tiene un buffer propio para llenar y el lector otro para leer; el tercero es el último
+// publicado. Publicar y tomar son un solo exchange, nadie espera al otro. El lector puede saltearse snapshots,
+// nunca ve uno a medio escribir.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : shared(1), writeIndex(0), readIndex(2) {}
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // Lado del escritor: se llena WriteBuffer() completo y después Publish()
+    T& WriteBuffer() { return buffers[writeIndex]; }
+
+    void Publish() {
+        uint8_t previous = shared.exchange(writeIndex | FRESH, std::memory_order_acq_rel);
+        writeIndex = previous & INDEX_MASK;
+    }
+
+    // Lado del lector: true si había un snapshot nuevo y ahora es el de ReadBuffer()
+    bool Update() {
+        if ((shared.load(std::memory_order_acquire) & FRESH) == 0) {
+            return false;
+        }
+        uint8_t previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    T& ReadBuffer() { return buffers[readIndex]; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t FRESH = 0x4;
+
+    T buffers[3];
+    std::atomic<uint8_t> shared;        // Índice del buffer intermedio | FRESH si el lector todavía no lo tomó
+    uint8_t writeIndex;                 // Solo lo toca el escritor
+    uint8_t readIndex;                  // Solo lo toca el lector
+};
+
+// Cola circular de capacidad fija (potencia de 2). Push desde un hilo, Pop desde otro.
+template <typename T, size_t Capacity>
+class CommandQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "la capacidad tiene que ser potencia de 2");
+
+public:
+    CommandQueue() : head(0), tail(0) {}
+
+    CommandQueue(const CommandQueue&) = delete;
+    CommandQueue& operator=(const CommandQueue&) = delete;
+
+    // false si está llena (el comando se descarta)
+    bool Push(const T& item) {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[currentTail & (Capacity - 1)] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T& item) {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[Capacity];
+    alignas(64) std::atomic<size_t> head;   // Lo avanza el consumidor
+    alignas(64) std::atomic<size_t> tail;   // Lo avanza el productor
+};
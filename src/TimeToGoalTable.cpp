@@ -0,0 +1,177 @@
+// TimeToGoalTable.cpp
+#include "TimeToGoalTable.h"
+#include "HexDirections.h"
+#include "LevelTables.h"
+#include <algorithm>
+#include <climits>
+#include <iostream>
+#include <new>
+
+TimeToGoalTable::TimeToGoalTable() : ready(false), width(0), height(0), cellCount(0), cycle(1), transientTurns(0), goal(-1) {}
+
+bool TimeToGoalTable::Build(const Grid& grid) {
+    ready = false;
+    width = grid.width;
+    height = grid.height;
+    cellCount = (size_t)width * height;
+    cycle = grid.turnCycleLength > 0 ? grid.turnCycleLength : 1;
+    transientTurns = 0;
+    goal = -1;
+
+    // Horario de paso por celda: lo necesitan las distancias y también SharedLevel, que lo lee de acá
+    try {
+        openTurn.assign(cellCount, 0);
+        openAtPhase.assign(cellCount * cycle, 1);
+    } catch (const std::bad_alloc&) {
+        std::cout << "Turnos a la meta: sin memoria para la tabla" << std::endl;
+        std::vector<int>().swap(openTurn);
+        std::vector<uint8_t>().swap(openAtPhase);
+        return Fail();
+    }
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const HexCell& cell = grid.CellAt(x, y);
+            int index = y * width + x;
+            if (cell.type == CellType::WALL) {
+                openTurn[index] = INT_MAX;
+            } else if (cell.type == CellType::TEMPORAL_WALL) {
+                openTurn[index] = cell.TurnsToOpen();
+                transientTurns = std::max(transientTurns, cell.TurnsToOpen());
+            } else if (cell.type == CellType::GATE) {
+                // Como Grid::UpdateGatesAndWalls: en las fases que un patrón corto no cubre queda como en la última
+                const GatePattern& pattern = grid.GatePatternOf(cell);
+                if (!pattern.defined || pattern.phases.empty()) continue;
+                for (int phase = 0; phase < cycle; phase++) {
+                    openAtPhase[(size_t)phase * cellCount + index] = LevelTables::GateOpenAtPhase(pattern.phases, phase) ? 1 : 0;
+                }
+            }
+        }
+    }
+
+    // Las distancias crecen con el turno de la pared temporal más tardía: se mide antes de reservar
+    size_t bytes = DistanceBytes(cellCount, cycle, transientTurns);
+    if (bytes > MAX_BYTES) {
+        std::cout << "Turnos a la meta: la tabla ocuparía " << (bytes >> 20) << " MB (" << transientTurns
+                  << " turnos transitorios), sin pistas ni detección de fin de partida" << std::endl;
+        return Fail();
+    }
+    try {
+        transient.assign((size_t)transientTurns * cellCount, UNREACHABLE);
+        periodic.assign((size_t)cycle * cellCount, UNREACHABLE);
+    } catch (const std::bad_alloc&) {
+        std::cout << "Turnos a la meta: sin memoria para la tabla" << std::endl;
+        return Fail();
+    }
+
+    ready = true;
+    if (grid.goalPos.x < 0 || grid.goalPos.x >= width || grid.goalPos.y < 0 || grid.goalPos.y >= height) {
+        return true;
+    }
+    goal = grid.goalPos.y * width + grid.goalPos.x;
+
+    // Parte periódica: BFS hacia atrás sobre los estados (celda, fase) desde la meta en todas las fases.
+    // Se llega a (n, f + 1) desde (c, f) si c y n son vecinos y n está abierta en la fase f; la adyacencia
+    // hexagonal es simétrica, así que los predecesores de n son sus propios vecinos.
+    std::vector<uint32_t> queue;
+    try {
+        queue.reserve(cellCount * cycle);
+    } catch (const std::bad_alloc&) {
+        std::cout << "Turnos a la meta: sin memoria para la tabla" << std::endl;
+        return Fail();
+    }
+    for (int phase = 0; phase < cycle; phase++) {
+        periodic[(size_t)phase * cellCount + goal] = 0;
+        queue.push_back((uint32_t)(phase * cellCount + goal));
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        uint32_t state = queue[head];
+        int phase = (int)(state / cellCount);
+        int index = (int)(state % cellCount);
+        int previousPhase = (phase + cycle - 1) % cycle;
+        // Pasado transientTurns las paredes temporales ya abrieron: solo quedan las paredes fijas y la fase
+        if (openTurn[index] == INT_MAX || openAtPhase[(size_t)previousPhase * cellCount + index] == 0) {
+            continue;
+        }
+
+        uint32_t value = periodic[state] + 1;
+        int x = index % width;
+        int y = index / width;
+        const int (*offsets)[2] = HexOffsetsForColumn(x);
+        for (int i = 0; i < 6; i++) {
+            int nx = x + offsets[i][0];
+            int ny = y + offsets[i][1];
+            if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+
+            size_t predecessor = (size_t)previousPhase * cellCount + ny * width + nx;
+            if (periodic[predecessor] == UNREACHABLE) {
+                periodic[predecessor] = value;
+                queue.push_back((uint32_t)predecessor);
+            }
+        }
+    }
+
+    // Parte transitoria, turno por turno hacia atrás: el turno t solo depende del t + 1
+    for (int turn = transientTurns - 1; turn >= 0; turn--) {
+        uint32_t* values = &transient[(size_t)turn * cellCount];
+        for (int index = 0; index < (int)cellCount; index++) {
+            if (index == goal) {
+                values[index] = 0;
+                continue;
+            }
+            int x = index % width;
+            int y = index / width;
+            const int (*offsets)[2] = HexOffsetsForColumn(x);
+            uint32_t best = UNREACHABLE;
+            for (int i = 0; i < 6; i++) {
+                int nx = x + offsets[i][0];
+                int ny = y + offsets[i][1];
+                if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                int neighbor = ny * width + nx;
+                if (IsOpen(neighbor, turn)) {
+                    best = std::min(best, Value(neighbor, turn + 1));
+                }
+            }
+            values[index] = best == UNREACHABLE ? UNREACHABLE : best + 1;
+        }
+    }
+    return true;
+}
+
+// Suelta las distancias (el horario por celda queda, si se llegó a armar): un Build fallido no retiene memoria
+bool TimeToGoalTable::Fail() {
+    ready = false;
+    goal = -1;
+    std::vector<uint32_t>().swap(transient);
+    std::vector<uint32_t>().swap(periodic);
+    return false;
+}
+
+bool TimeToGoalTable::BestMove(int x, int y, int turn, GridPos& next) const {
+    int index = y * width + x;
+    uint32_t current = Value(index, turn);
+    if (current == UNREACHABLE || current == 0) {
+        return false;
+    }
+
+    const int (*offsets)[2] = HexOffsetsForColumn(x);
+    for (int i = 0; i < 6; i++) {
+        int nx = x + offsets[i][0];
+        int ny = y + offsets[i][1];
+        if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+        int neighbor = ny * width + nx;
+        if (IsOpen(neighbor, turn) && Value(neighbor, turn + 1) == current - 1) {
+            next = {nx, ny};
+            return true;
+        }
+    }
+    return false;
+}
+
+// Tabla transitoria y periódica más la cola del BFS periódico
+size_t TimeToGoalTable::DistanceBytes(size_t cellCount, int cycle, int transientTurns) {
+    return cellCount * ((size_t)transientTurns + 2 * (size_t)cycle) * sizeof(uint32_t);
+}
+
+size_t TimeToGoalTable::MemoryBytes() const {
+    return openTurn.size() * sizeof(int) + openAtPhase.size() + (transient.size() + periodic.size()) * sizeof(uint32_t);
+}
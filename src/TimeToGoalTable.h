@@ -0,0 +1,72 @@
+// TimeToGoalTable.h, turnos mínimos que faltan para llegar a la meta desde cada (celda, turno), con la regla
+// del juego manual (la celda destino tiene que estar abierta en el turno en que se sale). Se calcula una vez
+// hacia atrás al cargar el nivel; después la pista, "¿todavía se puede ganar?" y los turnos que faltan son
+// consultas O(1) en cada turno.
+#pragma once
+#include "Grid.h"
+#include "GridPos.h"
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class TimeToGoalTable {
+public:
+    static constexpr uint32_t UNREACHABLE = 0xFFFFFFFFu;
+    // La parte transitoria crece con celdas x turno de la última pared temporal: por encima de esto no se arma
+    static constexpr size_t MAX_BYTES = (size_t)256 << 20;
+
+    TimeToGoalTable();
+
+    // Lee del grid el tipo de cada celda, los patrones y los turnos de las paredes temporales (no el turno
+    // actual ni los items). Compuertas con patrón más corto que el ciclo o sin patrón cuentan como abiertas,
+    // igual que en PathFinder y LevelTables. false si las distancias no entran en MAX_BYTES (o falta memoria):
+    // quedan vacías y sin Ready(), y quien la usa tiene que apagar las pistas y la detección de fin de partida.
+    // El horario por celda (IsOpen/IsWall) se arma igual; solo falta si no hubo memoria ni para él.
+    bool Build(const Grid& grid);
+    bool Ready() const { return ready; }
+    bool HasSchedule() const { return !openTurn.empty(); }
+
+    // Lo que Grid::IsValidMove mira de la celda destino en ese turno
+    bool IsOpen(int index, int turn) const {
+        return turn >= openTurn[index] && openAtPhase[(size_t)(turn % cycle) * cellCount + index] != 0;
+    }
+
+    // Pared fija: no se abre en ningún turno (las compuertas y paredes temporales no cuentan)
+    bool IsWall(int index) const { return openTurn[index] == INT_MAX; }
+
+    // UNREACHABLE si desde ahí ya no se puede llegar; 0 en la meta
+    uint32_t TurnsToGoal(int x, int y, int turn) const {
+        return Value(y * width + x, turn);
+    }
+    bool CanReachGoal(int x, int y, int turn) const { return TurnsToGoal(x, y, turn) != UNREACHABLE; }
+
+    // Vecino que acorta el camino en un turno (el primero en el orden de HexDirections); false si no hay
+    bool BestMove(int x, int y, int turn, GridPos& next) const;
+
+    int TransientTurns() const { return transientTurns; }
+    size_t MemoryBytes() const;
+
+private:
+    bool ready;
+    int width, height;
+    size_t cellCount;
+    int cycle;
+    int transientTurns;                 // Hasta acá abren paredes temporales; después solo importa turno % ciclo
+    int goal;
+    std::vector<int> openTurn;          // Por celda: primer turno en que se puede entrar (INT_MAX = pared)
+    std::vector<uint8_t> openAtPhase;   // [fase * celdas + celda]: la compuerta deja pasar en esa fase
+    std::vector<uint32_t> transient;    // [turno * celdas + celda] para turno < transientTurns
+    std::vector<uint32_t> periodic;     // [fase * celdas + celda] para turno >= transientTurns
+
+    uint32_t Value(int index, int turn) const {
+        if (turn < transientTurns) {
+            return transient[(size_t)turn * cellCount + index];
+        }
+        return periodic[(size_t)(turn % cycle) * cellCount + index];
+    }
+
+    // Lo que ocuparían las distancias, para decidir antes de reservar
+    static size_t DistanceBytes(size_t cellCount, int cycle, int transientTurns);
+    bool Fail();
+};
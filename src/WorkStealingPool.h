@@ -0,0 +1,49 @@
+// WorkStealingPool.h, pool de hilos con una cola por hilo: cada uno saca del final de la suya
+// y, cuando se queda sin trabajo, le roba del principio a las de los demás
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    // 0 hilos = uno por núcleo
+    explicit WorkStealingPool(unsigned threadCount = 0);
+    ~WorkStealingPool();
+    
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    
+    // Las tareas se reparten en ronda entre las colas; pueden llamar a Submit desde adentro
+    void Submit(std::function<void()> task);
+    
+    // Bloquea hasta que terminen todas las tareas enviadas
+    void Wait();
+    
+    unsigned ThreadCount() const { return (unsigned)threads.size(); }
+    
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> nextQueue;
+    std::atomic<size_t> queued;         // Tareas en alguna cola
+    std::atomic<size_t> pending;        // Tareas enviadas que todavía no terminaron
+    bool stopping;
+    std::mutex stateMutex;              // Protege 'stopping' y acompaña a las condition_variable
+    std::condition_variable workAvailable;
+    std::condition_variable allDone;
+    
+    bool TryTake(size_t self, std::function<void()>& task);
+    void Run(size_t self);
+};
@@ -1,8 +1,27 @@
 #include "Game.h"
+#include <cstdlib>
+#include <cstring>
 
-int main() {
+// Uso: EscapeTheGrid [--hot-reload] [--record carpeta] [--turbo N] [nivel.txt]
+int main(int argc, char** argv) {
     Game game;
+    const char* startLevel = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--hot-reload") == 0) {
+            game.EnableHotReload();
+        } else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            game.EnableRecording(argv[++i]);
+        } else if (std::strcmp(argv[i], "--turbo") == 0 && i + 1 < argc) {
+            game.SetTurbo(std::atoi(argv[++i]));
+        } else {
+            startLevel = argv[i];
+        }
+    }
+    
     game.Initialize();
+    if (startLevel != nullptr) {
+        game.ShowTutorial(startLevel);
+    }
     
     while (!WindowShouldClose()) {
         game.Update();
@@ -0,0 +1,158 @@
+// bench_loader.cpp, mide FileLoader::LoadLevel con .txt y .json sobre el mismo nivel grande generado al vuelo
+// Uso: bench_loader [ancho] [alto] [repeticiones]
+#include "FileLoader.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// Pico de memoria residente del proceso en MB (0 si la plataforma no lo reporta)
+static double PeakResidentMB() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss / 1024.0;
+    }
+#endif
+    return 0.0;
+}
+
+// Escribe el nivel directo al stream para no inflar el pico de memoria del proceso.
+// Con la misma semilla el .txt y el .json describen exactamente el mismo nivel.
+static void GenerateLevel(std::ostream& out, int width, int height, unsigned seed, bool json) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> percent(0, 99);
+    
+    if (json) {
+        out << "{\n  \"width\": " << width << ", \"height\": " << height << ",\n";
+        out << "  \"start\": [0, 0], \"goal\": [" << (width - 1) << ", " << (height - 1) << "],\n";
+        out << "  \"turnCycle\": 16,\n  \"rows\": [\n";
+    } else {
+        out << width << " " << height << "\n";
+        out << "0 0\n";
+        out << (width - 1) << " " << (height - 1) << "\n";
+        out << "16\n";
+    }
+    
+    for (int y = 0; y < height; y++) {
+        std::string row(width, '.');
+        for (int x = 0; x < width; x++) {
+            int roll = percent(rng);
+            if (roll < 20) row[x] = '#';
+            else if (roll < 21) row[x] = 'K';
+        }
+        if (y == 0) row[0] = 'S';
+        if (y == height - 1) row[width - 1] = 'G';
+        if (json) {
+            out << "    \"" << row << (y + 1 < height ? "\",\n" : "\"\n");
+        } else {
+            out << row << "\n";
+        }
+    }
+    
+    if (json) {
+        out << "  ],\n  \"gatePatterns\": { \"A\": \"1100110011001100\", \"B\": \"0011001100110011\" },\n";
+    } else {
+        out << "\nGATE_A 1100110011001100\nGATE_B 0011001100110011\n";
+    }
+    
+    // Las compuertas y paredes temporales se intercalan en el .txt; en el .json van en dos arreglos
+    int directives = (width * height) / 200;
+    std::uniform_int_distribution<int> randX(0, width - 1), randY(0, height - 1);
+    std::string gates, temporals;
+    for (int i = 0; i < directives; i++) {
+        int gx = randX(rng), gy = randY(rng);
+        int tx = randX(rng), ty = randY(rng);
+        const char* pattern = i % 2 ? "A" : "B";
+        int turns = 1 + i % 32;
+        
+        if (json) {
+            gates += (i ? ",\n    " : "    ");
+            gates += "{ \"x\": " + std::to_string(gx) + ", \"y\": " + std::to_string(gy) + ", \"pattern\": \"" + pattern + "\" }";
+            temporals += (i ? ",\n    " : "    ");
+            temporals += "{ \"x\": " + std::to_string(tx) + ", \"y\": " + std::to_string(ty) + ", \"turns\": " + std::to_string(turns) + " }";
+        } else {
+            out << "ASSIGN_" << gx << "_" << gy << "_" << pattern << "\n";
+            out << "TEMPORAL_" << tx << "_" << ty << "_" << turns << "\n";
+        }
+    }
+    
+    if (json) {
+        out << "  \"gates\": [\n" << gates << "\n  ],\n";
+        out << "  \"temporalWalls\": [\n" << temporals << "\n  ]\n}\n";
+    }
+}
+
+struct BenchResult {
+    double sizeMB = 0.0;
+    double bestMs = 1e30;
+    double averageMs = 0.0;
+    bool ok = true;
+};
+
+static BenchResult BenchFormat(const std::string& path, int width, int height, int runs, bool json) {
+    BenchResult result;
+    {
+        std::ofstream file(path, std::ios::binary);
+        GenerateLevel(file, width, height, 1234, json);
+        result.sizeMB = file.tellp() / (1024.0 * 1024.0);
+    }
+    
+    // Silenciar el log del loader durante la medición
+    std::streambuf* original = std::cout.rdbuf(nullptr);
+    double totalMs = 0.0;
+    
+    for (int i = 0; i < runs; i++) {
+        LevelData levelData;
+        auto startTime = std::chrono::steady_clock::now();
+        result.ok = FileLoader::LoadLevel(path, levelData) && result.ok;
+        auto endTime = std::chrono::steady_clock::now();
+        
+        double ms = std::chrono::duration<double, std::milli>(endTime - startTime).count();
+        result.bestMs = ms < result.bestMs ? ms : result.bestMs;
+        totalMs += ms;
+    }
+    
+    std::cout.rdbuf(original);
+    std::remove(path.c_str());
+    result.averageMs = totalMs / runs;
+    return result;
+}
+
+int main(int argc, char** argv) {
+    int width = argc > 1 ? std::atoi(argv[1]) : 2000;
+    int height = argc > 2 ? std::atoi(argv[2]) : 2000;
+    int runs = argc > 3 ? std::atoi(argv[3]) : 5;
+    
+    std::printf("Nivel generado: %dx%d, %d repeticiones\n", width, height, runs);
+    double baselineMB = PeakResidentMB();
+    
+    BenchResult txt = BenchFormat("bench_level.txt", width, height, runs, false);
+    double txtPeakMB = PeakResidentMB();
+    BenchResult json = BenchFormat("bench_level.json", width, height, runs, true);
+    
+    if (!txt.ok || !json.ok) {
+        std::printf("ERROR: el nivel generado no se pudo cargar (%s)\n", txt.ok ? "json" : "txt");
+        return 1;
+    }
+    
+    std::printf("TXT : %7.2f MB, mejor %8.2f ms, promedio %8.2f ms, %7.1f MB/s\n",
+                txt.sizeMB, txt.bestMs, txt.averageMs, txt.sizeMB / (txt.bestMs / 1000.0));
+    std::printf("JSON: %7.2f MB, mejor %8.2f ms, promedio %8.2f ms, %7.1f MB/s\n",
+                json.sizeMB, json.bestMs, json.averageMs, json.sizeMB / (json.bestMs / 1000.0));
+    std::printf("JSON/TXT: %.2fx el tiempo del .txt\n", json.bestMs / txt.bestMs);
+    
+    double peakMB = PeakResidentMB();
+    if (peakMB > 0.0) {
+        std::printf("Memoria: pico %.1f MB tras .txt, %.1f MB tras .json (antes de cargar %.1f MB), mapa final %.1f MB\n",
+                    txtPeakMB, peakMB, baselineMB, (double)width * height / (1024.0 * 1024.0));
+    }
+    return 0;
+}
@@ -0,0 +1,450 @@
+// bench_suite.cpp, benchmarks reproducibles del loader, de las consultas del grid y de los solvers.
+// Mide ns/op, asignaciones/op y expansiones/s; compara contra un baseline JSON y falla si algo empeora.
+// Uso: bench_suite [--baseline archivo.json] [--write-baseline archivo.json] [--threshold 0.30]
+//                  [--filter texto] [--levels carpeta] [--quick]
+#include "FileLoader.h"
+#include "HexDirections.h"
+#include "JsonReader.h"
+#include "LevelTables.h"
+#include "PathFinder.h"
+#include "SearchTrace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <new>
+#include <random>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+// Contador global de asignaciones: se reemplaza el operator new de todo el programa
+static std::atomic<size_t> allocationCount(0);
+static std::atomic<size_t> allocatedBytes(0);
+
+// Los delete liberan con free lo que el new de arriba pidió con malloc
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+namespace {
+
+struct BenchResult {
+    std::string name;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0;
+    double bytesPerOp = 0.0;
+    long long expansions = -1;      // Solo los solvers
+};
+
+struct BenchSettings {
+    double minSampleMs = 20.0;
+    int samples = 5;
+    std::string filter;
+    double threshold = 0.30;
+    int retries = 3;                                // Remediciones antes de dar por buena una regresión
+    const std::map<std::string, BenchResult>* baseline = nullptr;
+};
+
+// Descarta el log del loader y del grid mientras se mide
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+volatile size_t sink = 0;
+
+double NowMs() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Calibra cuántas llamadas entran en una muestra y se queda con la mejor: el ruido de la máquina solo suma tiempo
+BenchResult MeasureOnce(const std::string& name, double opsPerCall, const BenchSettings& settings,
+                        const std::function<void()>& call) {
+    BenchResult result;
+    result.name = name;
+
+    double start = NowMs();
+    call();
+    double single = std::max(NowMs() - start, 1e-4);
+    long long callsPerSample = std::max(1LL, (long long)std::ceil(settings.minSampleMs / single));
+
+    std::vector<double> samples;
+    for (int s = 0; s < settings.samples; s++) {
+        size_t allocationsBefore = allocationCount.load();
+        size_t bytesBefore = allocatedBytes.load();
+        start = NowMs();
+        for (long long i = 0; i < callsPerSample; i++) {
+            call();
+        }
+        double elapsed = NowMs() - start;
+        double ops = opsPerCall * callsPerSample;
+        samples.push_back(elapsed * 1e6 / ops);
+        if (s == 0) {
+            result.allocsPerOp = (allocationCount.load() - allocationsBefore) / ops;
+            result.bytesPerOp = (allocatedBytes.load() - bytesBefore) / ops;
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+    result.nsPerOp = samples.front();
+    return result;
+}
+
+// Si la medición sale peor que el baseline se repite: una racha lenta de la máquina no es una regresión
+BenchResult Measure(const std::string& name, double opsPerCall, const BenchSettings& settings,
+                    const std::function<void()>& call) {
+    BenchResult result = MeasureOnce(name, opsPerCall, settings, call);
+    if (settings.baseline == nullptr) {
+        return result;
+    }
+    auto base = settings.baseline->find(name);
+    for (int retry = 0; base != settings.baseline->end() && retry < settings.retries &&
+                        result.nsPerOp > base->second.nsPerOp * (1.0 + settings.threshold); retry++) {
+        result.nsPerOp = std::min(result.nsPerOp, MeasureOnce(name, opsPerCall, settings, call).nsPerOp);
+    }
+    return result;
+}
+
+// Nivel .txt en memoria, determinista para una semilla (sin std::uniform_*, que cambia entre bibliotecas)
+std::string GenerateLevelText(int size, int gatePercent, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::ostringstream out;
+    out << size << " " << size << "\n0 0\n" << (size - 1) << " " << (size - 1) << "\n8\n";
+
+    std::vector<std::string> rows(size, std::string(size, '.'));
+    std::vector<std::pair<int, int>> gates;
+    for (int y = 0; y < size; y++) {
+        for (int x = 0; x < size; x++) {
+            unsigned roll = rng() % 100;
+            if (roll < 15) rows[y][x] = '#';
+            else if (roll < 15 + (unsigned)gatePercent) gates.push_back({x, y});
+        }
+    }
+    rows[0][0] = 'S';
+    rows[size - 1][size - 1] = 'G';
+    for (const std::string& row : rows) out << row << "\n";
+
+    out << "\nGATE_A 11001100\nGATE_B 00110011\nGATE_C 11110000\n";
+    const char* patterns[] = {"A", "B", "C"};
+    for (size_t i = 0; i < gates.size(); i++) {
+        int x = gates[i].first, y = gates[i].second;
+        if ((x == 0 && y == 0) || (x == size - 1 && y == size - 1)) continue;
+        out << "ASSIGN_" << x << "_" << y << "_" << patterns[rng() % 3] << "\n";
+    }
+    return out.str();
+}
+
+// Si el nivel generado no tiene solución se prueba la semilla siguiente: todos los solvers miden lo mismo
+bool GenerateSolvableLevel(int size, int gatePercent, LevelData& levelData, std::string& text) {
+    for (unsigned seed = 1; seed < 100; seed++) {
+        text = GenerateLevelText(size, gatePercent, seed * 7919u + (unsigned)size * 31u + (unsigned)gatePercent);
+        levelData = LevelData();
+        if (FileLoader::LoadFromTXTBuffer("generado", text, levelData) &&
+            LevelTables::ComputeShortestPathLength(levelData) >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool Selected(const BenchSettings& settings, const std::string& name) {
+    return settings.filter.empty() || name.find(settings.filter) != std::string::npos;
+}
+
+// Carga, vecinos, validación de movimientos y ambos solvers sobre un nivel ya parseado; con astarOnly solo
+// el A* con y sin traza (niveles grandes, donde el resto tarda demasiado)
+void BenchLevel(const std::string& label, const LevelData& parsed, const std::function<bool(LevelData&)>& load,
+                const BenchSettings& settings, std::vector<BenchResult>& results, bool astarOnly = false) {
+    std::string name = "load/" + label;
+    if (!astarOnly && Selected(settings, name)) {
+        results.push_back(Measure(name, 1, settings, [&]() {
+            LevelData levelData;
+            sink = sink + (load(levelData) ? levelData.cells.size() : 0);
+        }));
+    }
+
+    LevelData levelData = parsed;
+    LevelTables::AttachGoalDistances(levelData);
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+    PathFinder pathFinder(&grid);
+    pathFinder.verbose = false;
+    double cellCount = (double)grid.width * grid.height;
+
+    name = "neighbors/" + label;
+    if (!astarOnly && Selected(settings, name)) {
+        results.push_back(Measure(name, cellCount, settings, [&]() {
+            for (int y = 0; y < grid.height; y++) {
+                for (int x = 0; x < grid.width; x++) {
+                    sink = sink + grid.GetNeighbors(x, y).size();
+                }
+            }
+        }));
+    }
+
+    name = "valid_move/" + label;
+    if (!astarOnly && Selected(settings, name)) {
+        int turn = 0;
+        results.push_back(Measure(name, cellCount * 6, settings, [&]() {
+            size_t valid = 0;
+            for (int y = 0; y < grid.height; y++) {
+                for (int x = 0; x < grid.width; x++) {
+                    const int (*offsets)[2] = HexOffsetsForColumn(x);
+                    for (int d = 0; d < 6; d++) {
+                        valid += pathFinder.IsValidMoveAtTurn(x, y, x + offsets[d][0], y + offsets[d][1], turn);
+                    }
+                }
+            }
+            turn = (turn + 1) % (grid.turnCycleLength * 2);
+            sink = sink + valid;
+        }));
+    }
+
+    // Límites amplios: se mide el algoritmo, no el corte por tiempo del juego
+    SolverLimits limits = {50000000, 600000, 4 * (grid.width + grid.height) + grid.turnCycleLength, 50000000};
+    for (int solver = 0; solver < 2; solver++) {
+        name = std::string(solver == 0 ? "astar/" : "bfs/") + label;
+        if (!Selected(settings, name) || (astarOnly && solver == 1)) continue;
+        BenchResult result = Measure(name, 1, settings, [&]() {
+            std::vector<GridPos> path = solver == 0 ? pathFinder.FindPathAStar(limits) : pathFinder.FindPathBFS(limits);
+            sink = sink + path.size();
+        });
+        result.expansions = pathFinder.lastStats.expansions;
+        results.push_back(result);
+    }
+
+    // A* publicando el mapa de calor como en el auto-solve del juego; tiene que quedar a la par de astar/
+    name = "astar_traced/" + label;
+    if (Selected(settings, name)) {
+        SearchTrace trace;
+        pathFinder.trace = &trace;
+        int searchId = 0;
+        BenchResult result = Measure(name, 1, settings, [&]() {
+            trace.Begin(grid.width, grid.height, ++searchId);
+            std::vector<GridPos> path = pathFinder.FindPathAStar(limits);
+            sink = sink + path.size() + trace.Latest().expansions;
+        });
+        pathFinder.trace = nullptr;
+        result.expansions = pathFinder.lastStats.expansions;
+        results.push_back(result);
+    }
+}
+
+// Lee el baseline con el mismo lector SAX de los niveles
+class BaselineHandler : public JsonHandler {
+public:
+    std::map<std::string, BenchResult> entries;
+
+    bool OnObjectStart() override { depth++; current = BenchResult(); return true; }
+    bool OnObjectEnd() override {
+        if (depth == 2 && !current.name.empty()) entries[current.name] = current;
+        depth--;
+        return true;
+    }
+    bool OnKey(std::string_view key) override { this->key.assign(key.data(), key.size()); return true; }
+    bool OnString(std::string_view value) override {
+        if (depth == 2 && key == "name") current.name.assign(value.data(), value.size());
+        return true;
+    }
+    bool OnInteger(int64_t value) override { return OnDouble((double)value); }
+    bool OnDouble(double value) override {
+        if (depth != 2) return true;
+        if (key == "ns_per_op") current.nsPerOp = value;
+        else if (key == "allocs_per_op") current.allocsPerOp = value;
+        else if (key == "bytes_per_op") current.bytesPerOp = value;
+        else if (key == "expansions") current.expansions = (long long)value;
+        return true;
+    }
+
+private:
+    int depth = 0;
+    std::string key;
+    BenchResult current;
+};
+
+bool ReadBaseline(const std::string& filename, std::map<std::string, BenchResult>& baseline) {
+    std::ifstream input(filename, std::ios::binary);
+    if (!input.is_open()) {
+        std::printf("No se pudo abrir el baseline: %s\n", filename.c_str());
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << input.rdbuf();
+    std::string text = buffer.str();
+
+    BaselineHandler handler;
+    JsonError error;
+    if (!JsonReader::Parse(text, handler, error)) {
+        std::printf("%s:%d:%d: %s\n", filename.c_str(), error.line, error.column, error.message.c_str());
+        return false;
+    }
+    baseline = std::move(handler.entries);
+    return true;
+}
+
+bool WriteBaseline(const std::string& filename, const std::vector<BenchResult>& results) {
+    FILE* out = std::fopen(filename.c_str(), "w");
+    if (out == nullptr) {
+        std::printf("No se pudo crear el archivo: %s\n", filename.c_str());
+        return false;
+    }
+    std::fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        std::fprintf(out, "    {\"name\": \"%s\", \"ns_per_op\": %.2f, \"allocs_per_op\": %.4f, \"bytes_per_op\": %.1f",
+                     r.name.c_str(), r.nsPerOp, r.allocsPerOp, r.bytesPerOp);
+        if (r.expansions >= 0) std::fprintf(out, ", \"expansions\": %lld", r.expansions);
+        std::fprintf(out, "}%s\n", i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+    std::fclose(out);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    BenchSettings settings;
+    std::string baselineFile, writeFile, levelsDir = "assets/levels";
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--baseline" && hasValue) baselineFile = argv[++i];
+        else if (argument == "--write-baseline" && hasValue) writeFile = argv[++i];
+        else if (argument == "--threshold" && hasValue) settings.threshold = std::atof(argv[++i]);
+        else if (argument == "--filter" && hasValue) settings.filter = argv[++i];
+        else if (argument == "--levels" && hasValue) levelsDir = argv[++i];
+        else if (argument == "--quick") { settings.minSampleMs = 2.0; settings.samples = 3; }
+        else {
+            std::printf("Uso: %s [--baseline archivo.json] [--write-baseline archivo.json] [--threshold 0.30]\n"
+                        "       [--filter texto] [--levels carpeta] [--quick]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    std::map<std::string, BenchResult> baseline;
+    if (!baselineFile.empty() && !ReadBaseline(baselineFile, baseline)) {
+        return 1;
+    }
+    double threshold = settings.threshold;
+    settings.baseline = &baseline;
+
+    NullBuffer nullBuffer;
+    std::streambuf* originalCout = std::cout.rdbuf(&nullBuffer);
+    std::vector<BenchResult> results;
+
+    // Niveles del juego
+    const char* shipped[] = {"level1", "level2", "level_expert", "level_nightmare"};
+    for (const char* level : shipped) {
+        std::string filename = levelsDir + "/" + level + ".txt";
+        LevelData parsed;
+        if (!FileLoader::LoadLevel(filename, parsed)) {
+            std::cout.rdbuf(originalCout);
+            std::printf("ERROR: no se pudo cargar %s\n", filename.c_str());
+            return 1;
+        }
+        BenchLevel(level, parsed, [&](LevelData& levelData) { return FileLoader::LoadLevel(filename, levelData); },
+                   settings, results);
+    }
+
+    // Niveles generados de tamaño y densidad de compuertas crecientes
+    for (int size : {16, 32, 64}) {
+        for (int gatePercent : {0, 10, 30}) {
+            std::string label = "gen" + std::to_string(size) + "_g" + std::to_string(gatePercent);
+            LevelData parsed;
+            std::string text;
+            if (!GenerateSolvableLevel(size, gatePercent, parsed, text)) {
+                std::cout.rdbuf(originalCout);
+                std::printf("ERROR: no se generó un nivel resoluble para %s\n", label.c_str());
+                return 1;
+            }
+            BenchLevel(label, parsed, [&](LevelData& levelData) {
+                return FileLoader::LoadFromTXTBuffer(label, text, levelData);
+            }, settings, results);
+        }
+    }
+
+    // Un nivel grande: ahí se nota lo que cuesta publicar el mapa de calor (astar_traced contra astar)
+    {
+        LevelData parsed;
+        std::string text;
+        if (!GenerateSolvableLevel(1000, 10, parsed, text)) {
+            std::cout.rdbuf(originalCout);
+            std::printf("ERROR: no se generó un nivel resoluble para gen1000_g10\n");
+            return 1;
+        }
+        BenchLevel("gen1000_g10", parsed, nullptr, settings, results, true);
+    }
+    std::cout.rdbuf(originalCout);
+
+    std::printf("%-28s %12s %10s %12s %14s %12s %8s\n", "benchmark", "ns/op", "allocs/op", "bytes/op", "expansiones/s",
+                "baseline", "delta");
+    int regressions = 0;
+    for (const BenchResult& r : results) {
+        char rate[32] = "-";
+        if (r.expansions >= 0 && r.nsPerOp > 0.0) {
+            std::snprintf(rate, sizeof(rate), "%.3g", r.expansions / (r.nsPerOp * 1e-9));
+        }
+        std::printf("%-28s %12.1f %10.2f %12.1f %14s", r.name.c_str(), r.nsPerOp, r.allocsPerOp, r.bytesPerOp, rate);
+
+        auto base = baseline.find(r.name);
+        if (base == baseline.end()) {
+            std::printf(" %12s %8s\n", baseline.empty() ? "" : "nuevo", "");
+            continue;
+        }
+        const BenchResult& b = base->second;
+        double delta = b.nsPerOp > 0.0 ? r.nsPerOp / b.nsPerOp - 1.0 : 0.0;
+        std::printf(" %12.1f %+7.1f%%\n", b.nsPerOp, delta * 100.0);
+
+        // Las asignaciones y expansiones son deterministas: cualquier suba real se nota
+        if (delta > threshold) {
+            std::printf("  REGRESIÓN: %s tarda %.1f%% más que el baseline\n", r.name.c_str(), delta * 100.0);
+            regressions++;
+        }
+        if (r.allocsPerOp > b.allocsPerOp * (1.0 + threshold) + 0.01) {
+            std::printf("  REGRESIÓN: %s hace %.2f asignaciones/op (baseline %.2f)\n", r.name.c_str(), r.allocsPerOp, b.allocsPerOp);
+            regressions++;
+        }
+        if (r.expansions >= 0 && b.expansions >= 0 && r.expansions != b.expansions) {
+            std::printf("  aviso: %s expande %lld nodos (baseline %lld)\n", r.name.c_str(), r.expansions, b.expansions);
+        }
+    }
+
+    if (!writeFile.empty()) {
+        if (!WriteBaseline(writeFile, results)) return 1;
+        std::printf("Baseline escrito en %s (%zu benchmarks)\n", writeFile.c_str(), results.size());
+    }
+    if (regressions > 0) {
+        std::printf("%d regresiones por encima del %.0f%%\n", regressions, threshold * 100.0);
+        return 1;
+    }
+    if (!baseline.empty()) {
+        std::printf("Sin regresiones (umbral %.0f%%)\n", threshold * 100.0);
+    }
+    return 0;
+}
@@ -0,0 +1,281 @@
+// etg_agents.cpp, cientos de agentes (jugadores hacia una meta y guardias patrullando) sobre un mismo nivel con
+// MultiAgentPlanner. Cada turno comprueba que nadie choque (misma celda o intercambio) y que los movimientos
+// cumplan las reglas del nivel; al final reporta llegadas y el costo de replanificar por agente.
+// Uso: etg-agents [--agents N] [--turns T] [--window W] [--replan K] [--guards P] [--size S] [--seed S]
+//                 [--max-expansions N] [--independent] [--per-agent] [nivel]
+#include "HexDirections.h"
+#include "LevelGenerator.h"
+#include "MultiAgentPlanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+struct AgentsSettings {
+    int agents = 200;
+    int turns = 300;
+    int guardPercent = 25;
+    int size = 96;
+    uint64_t seed = 1;
+    bool perAgent = false;
+    MultiAgentSettings planner;
+    std::string level;
+};
+
+// Lo que encontró el chequeo turno por turno
+struct StepCheck {
+    long long vertexConflicts = 0;
+    long long swapConflicts = 0;
+    long long invalidMoves = 0;
+};
+
+uint64_t SplitMix64(uint64_t& state) {
+    uint64_t value = (state += 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+bool LoadOrGenerate(const AgentsSettings& settings, LevelData& levelData) {
+    if (!settings.level.empty()) {
+        return FileLoader::LoadLevel(settings.level, levelData);
+    }
+    GeneratorParams params;
+    params.width = settings.size;
+    params.height = settings.size;
+    params.wallPercent = 20;
+    params.gateCount = settings.size * settings.size / 40;
+    params.temporalCount = settings.size * settings.size / 80;
+    params.seed = settings.seed;
+    GeneratedLevel generated;
+    return LevelGenerator::Generate(params, generated) &&
+           FileLoader::LoadFromTXTBuffer("generado", generated.text, levelData);
+}
+
+// Inicios distintos en celdas sin pared; las metas, cualquier celda alcanzable sin contar el tiempo
+bool CreateAgents(const AgentsSettings& settings, const SharedLevel& level, MultiAgentPlanner& planner) {
+    std::vector<int> open;
+    for (int cell = 0; cell < (int)level.CellCount(); cell++) {
+        if (!level.IsWall(cell)) open.push_back(cell);
+    }
+    if ((int)open.size() < settings.agents) {
+        std::printf("el nivel tiene %zu celdas libres para %d agentes\n", open.size(), settings.agents);
+        return false;
+    }
+    uint64_t random = settings.seed;
+    for (size_t i = open.size() - 1; i > 0; i--) {
+        std::swap(open[i], open[SplitMix64(random) % (i + 1)]);
+    }
+    auto toPos = [&](int cell) { return GridPos{cell % level.width, cell / level.width}; };
+    auto pickGoal = [&](int from) {
+        for (int attempt = 0; attempt < 64; attempt++) {
+            int cell = open[SplitMix64(random) % open.size()];
+            if (cell != from && planner.AbstractDistance(cell, from) >= 0) return cell;
+        }
+        return from;
+    };
+
+    for (int i = 0; i < settings.agents; i++) {
+        AgentSpec spec;
+        int start = open[i];
+        spec.start = toPos(start);
+        // Guardias repartidos parejo entre los ids (y por lo tanto entre las prioridades)
+        bool guard = (long long)i * settings.guardPercent / 100 != (long long)(i + 1) * settings.guardPercent / 100;
+        if (guard) {
+            spec.route = {toPos(pickGoal(start)), spec.start};
+            spec.loop = true;
+            spec.canWait = true;
+        } else {
+            spec.route = {toPos(pickGoal(start))};
+        }
+        if (planner.AddAgent(spec) < 0) return false;
+    }
+    return true;
+}
+
+// Choques entre agentes que estaban en el mapa al empezar el turno (incluye a los que terminaron en este)
+void CheckStep(const MultiAgentPlanner& planner, const SharedLevel& level, const std::vector<GridPos>& before,
+               const std::vector<bool>& active, int turn, StepCheck& check) {
+    std::unordered_map<int, int> occupied, previous;
+    for (int id = 0; id < planner.AgentCount(); id++) {
+        if (!active[id]) continue;
+        previous[before[id].y * level.width + before[id].x] = id;
+    }
+    for (int id = 0; id < planner.AgentCount(); id++) {
+        if (!active[id]) continue;
+        GridPos from = before[id], to = planner.Agent(id).pos;
+        int fromCell = from.y * level.width + from.x, toCell = to.y * level.width + to.x;
+
+        if (fromCell != toCell && (HexDirectionBetween(from.x, from.y, to.x, to.y) < 0 || !level.IsOpen(toCell, turn))) {
+            check.invalidMoves++;
+        }
+        if (!occupied.emplace(toCell, id).second) {
+            check.vertexConflicts++;
+        }
+        auto other = previous.find(toCell);
+        if (fromCell != toCell && other != previous.end() && other->second != id) {
+            GridPos otherTo = planner.Agent(other->second).pos;
+            if (otherTo.x == from.x && otherTo.y == from.y && other->second < id) check.swapConflicts++;
+        }
+    }
+}
+
+double Percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    return values[std::min(values.size() - 1, (size_t)(fraction * (values.size() - 1) + 0.5))];
+}
+
+void PrintUsage(const char* program) {
+    AgentsSettings defaults;
+    std::fprintf(stderr,
+        "Uso: %s [opciones] [nivel]\n"
+        "  --agents N          agentes (%d)\n"
+        "  --turns T           turnos a simular (%d)\n"
+        "  --window W          turnos que mira cada búsqueda (%d)\n"
+        "  --replan K          replanifica a todos cada K turnos (%d)\n"
+        "  --guards P          porcentaje de guardias que patrullan y pueden esperar (%d)\n"
+        "  --size S            lado del nivel generado si no se pasa uno (%d)\n"
+        "  --seed S            semilla del nivel y de los agentes\n"
+        "  --max-expansions N  límite por búsqueda (%d)\n"
+        "  --independent       cada agente planifica solo, sin reservas (para ver los choques)\n"
+        "  --per-agent         una línea por agente con su costo de replanificación\n",
+        program, defaults.agents, defaults.turns, defaults.planner.window, defaults.planner.replanEvery,
+        defaults.guardPercent, defaults.size, defaults.planner.maxExpansions);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    AgentsSettings settings;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--agents" && hasValue) {
+            settings.agents = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--turns" && hasValue) {
+            settings.turns = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--window" && hasValue) {
+            settings.planner.window = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--replan" && hasValue) {
+            settings.planner.replanEvery = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--guards" && hasValue) {
+            settings.guardPercent = std::min(100, std::max(0, std::atoi(argv[++i])));
+        } else if (argument == "--size" && hasValue) {
+            settings.size = std::max(8, std::atoi(argv[++i]));
+        } else if (argument == "--seed" && hasValue) {
+            settings.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--max-expansions" && hasValue) {
+            settings.planner.maxExpansions = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--independent") {
+            settings.planner.cooperative = false;
+        } else if (argument == "--per-agent") {
+            settings.perAgent = true;
+        } else if (!argument.empty() && argument[0] != '-') {
+            settings.level = argument;
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // El loader y el generador loguean por std::cout; el reporte va por stdout con printf
+    NullBuffer nullBuffer;
+    std::streambuf* originalCout = std::cout.rdbuf();
+    std::cout.rdbuf(&nullBuffer);
+    LevelData levelData;
+    auto level = std::make_shared<SharedLevel>();
+    bool loaded = LoadOrGenerate(settings, levelData) && level->Build(levelData);
+    std::cout.rdbuf(originalCout);
+    if (!loaded) {
+        std::printf("%s: no se pudo cargar\n", settings.level.empty() ? "nivel generado" : settings.level.c_str());
+        return 1;
+    }
+
+    MultiAgentPlanner planner(level, settings.planner);
+    if (!CreateAgents(settings, *level, planner)) {
+        return 1;
+    }
+
+    StepCheck check;
+    std::vector<GridPos> before(planner.AgentCount());
+    std::vector<bool> active(planner.AgentCount());
+    std::vector<int> arrivalTurn(planner.AgentCount(), -1);
+    long long waypoints = 0;
+    auto startTime = std::chrono::steady_clock::now();
+    for (int turn = 0; turn < settings.turns; turn++) {
+        std::vector<int> routeBefore(planner.AgentCount());
+        for (int id = 0; id < planner.AgentCount(); id++) {
+            before[id] = planner.Agent(id).pos;
+            active[id] = !planner.Agent(id).finished;
+            routeBefore[id] = planner.Agent(id).routeIndex;
+        }
+        planner.Step();
+        CheckStep(planner, *level, before, active, turn, check);
+        for (int id = 0; id < planner.AgentCount(); id++) {
+            if (!active[id]) continue;
+            if (planner.Agent(id).finished) arrivalTurn[id] = turn + 1;
+            else if (planner.Agent(id).routeIndex != routeBefore[id]) waypoints++;
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    int players = 0, guards = 0, arrived = 0;
+    long long arrivalSum = 0, forcedWaits = 0, searches = 0, failed = 0, expansions = 0;
+    double maxMicros = 0.0, totalMicros = 0.0;
+    std::vector<double> microsPerSearch;
+    for (int id = 0; id < planner.AgentCount(); id++) {
+        const AgentState& agent = planner.Agent(id);
+        if (planner.Spec(id).loop) guards++; else players++;
+        if (arrivalTurn[id] >= 0) {
+            arrived++;
+            arrivalSum += arrivalTurn[id];
+        }
+        forcedWaits += agent.forcedWaits;
+        searches += agent.cost.replans;
+        failed += agent.cost.failedSearches;
+        expansions += agent.cost.expansions;
+        totalMicros += agent.cost.micros;
+        maxMicros = std::max(maxMicros, agent.cost.maxMicros);
+        if (agent.cost.replans > 0) microsPerSearch.push_back(agent.cost.micros / agent.cost.replans);
+        if (settings.perAgent) {
+            std::printf("agente %d %s: %d búsquedas (%d fallidas), %.1f us de media, %.1f us máx, %.0f expansiones de media%s\n",
+                        id, planner.Spec(id).loop ? "guardia" : "jugador", agent.cost.replans, agent.cost.failedSearches,
+                        agent.cost.replans > 0 ? agent.cost.micros / agent.cost.replans : 0.0, agent.cost.maxMicros,
+                        agent.cost.replans > 0 ? (double)agent.cost.expansions / agent.cost.replans : 0.0,
+                        arrivalTurn[id] >= 0 ? (", llegó en el turno " + std::to_string(arrivalTurn[id])).c_str() : "");
+        }
+    }
+
+    std::printf("%d agentes (%d jugadores, %d guardias) en %dx%d, ventana %d, replanificación cada %d, %d turnos%s\n",
+                planner.AgentCount(), players, guards, level->width, level->height, planner.Settings().window,
+                planner.Settings().replanEvery, settings.turns, settings.planner.cooperative ? "" : " (sin reservas)");
+    std::printf("llegaron %d de %d jugadores (turno medio %.1f), %lld metas de patrulla, %lld esperas forzadas\n",
+                arrived, players, arrived > 0 ? (double)arrivalSum / arrived : 0.0, waypoints, forcedWaits);
+    std::printf("choques: %lld en la misma celda, %lld intercambios; %lld movimientos inválidos\n",
+                check.vertexConflicts, check.swapConflicts, check.invalidMoves);
+    std::printf("replanificación: %d rondas (%d repetidas por prioridad), %lld búsquedas (%lld fallidas), "
+                "%.0f expansiones por búsqueda, %.0f expansiones de la heurística\n", planner.Rounds(),
+                planner.PriorityRetries(), searches, failed,
+                searches > 0 ? (double)expansions / searches : 0.0, (double)planner.HeuristicExpansions());
+    std::printf("costo por agente y búsqueda: mediana %.1f us, p95 %.1f us, peor búsqueda %.1f us\n",
+                Percentile(microsPerSearch, 0.5), Percentile(microsPerSearch, 0.95), maxMicros);
+    std::printf("%.2f s: %.0f turnos/s, %.1f ms de replanificación por ronda\n", seconds, settings.turns / seconds,
+                planner.Rounds() > 0 ? totalMicros / 1000.0 / planner.Rounds() : 0.0);
+
+    bool clean = check.vertexConflicts == 0 && check.swapConflicts == 0 && check.invalidMoves == 0;
+    return settings.planner.cooperative && !clean ? 1 : 0;
+}
@@ -0,0 +1,622 @@
+// etg_fuzz.cpp, fuzzing diferencial de los solvers: genera niveles al azar, corre A* y BFS (con los límites
+// del juego y con límites amplios) y compara contra un BFS de referencia sobre (celda, turno plegado).
+// Cada camino devuelto se valida contra las reglas de tiempo, y el óptimo del menú (LevelTables) tiene que
+// coincidir con la referencia. Los casos raros se guardan como .txt reproducibles.
+// La tabla de turnos a la meta (regla del jugador) se compara con un BFS de referencia propio y se juega su pista.
+// A una parte de los casos se le acortan los patrones de compuerta para probar las fases que no cubren.
+// Uso: etg-fuzz [--cases N] [--seed S] [--max-size N] [--out carpeta]
+//      etg-fuzz --replay nivel.txt ...
+#include "GameRules.h"
+#include "LevelGenerator.h"
+#include "LevelTables.h"
+#include "HexDirections.h"
+#include "PathFinder.h"
+#include "TimeToGoalTable.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+const char* StopName(SolverStop stop) {
+    switch (stop) {
+        case SolverStop::FOUND: return "found";
+        case SolverStop::EXHAUSTED: return "exhausted";
+        case SolverStop::ITERATION_LIMIT: return "iteration_limit";
+        case SolverStop::TIME_LIMIT: return "time_limit";
+        case SolverStop::NODE_LIMIT: return "node_limit";
+        case SolverStop::INVALID_LEVEL: return "invalid_level";
+        case SolverStop::CANCELLED: return "cancelled";
+    }
+    return "unknown";
+}
+
+// Reglas de tiempo armadas directo desde el LevelData, sin pasar por Grid ni HexCell: la celda destino
+// tiene que estar abierta en el turno de llegada, como la mueve el auto-solve
+struct ReferenceRules {
+    int width = 0, height = 0;
+    int cycle = 1;
+    int lastOpening = 0;                // Desde este turno el mapa solo depende de turno % ciclo
+    int start = 0, goal = 0;
+    std::vector<bool> blocked;
+    std::vector<int> openTurn;
+    std::vector<const std::vector<bool>*> gatePattern;
+
+    explicit ReferenceRules(const LevelData& levelData) {
+        width = levelData.width;
+        height = levelData.height;
+        cycle = levelData.turnCycleLength > 0 ? levelData.turnCycleLength : 1;
+        start = levelData.startY * width + levelData.startX;
+        goal = levelData.goalY * width + levelData.goalX;
+
+        size_t cellCount = (size_t)width * height;
+        blocked.assign(cellCount, false);
+        openTurn.assign(cellCount, 0);
+        gatePattern.assign(cellCount, nullptr);
+        for (size_t i = 0; i < cellCount; i++) {
+            blocked[i] = levelData.cells[i] == '#';
+        }
+        for (const GateAssignment& gate : levelData.gateAssignments) {
+            size_t index = (size_t)gate.y * width + gate.x;
+            auto pattern = levelData.gatePatterns.find(gate.pattern);
+            gatePattern[index] = pattern != levelData.gatePatterns.end() ? &pattern->second : nullptr;
+            blocked[index] = false;
+        }
+        for (const TemporalWall& wall : levelData.temporalWalls) {
+            size_t index = (size_t)wall.y * width + wall.x;
+            gatePattern[index] = nullptr;
+            openTurn[index] = wall.turns;
+            blocked[index] = false;
+            lastOpening = std::max(lastOpening, wall.turns);
+        }
+        for (const auto& item : levelData.items) {
+            if (item.first < 0 || item.first >= width || item.second < 0 || item.second >= height) continue;
+            size_t index = (size_t)item.second * width + item.first;
+            gatePattern[index] = nullptr;
+            openTurn[index] = 0;
+            blocked[index] = false;
+        }
+    }
+
+    // Lo que ve el jugador en el grid: en las fases que un patrón corto no cubre, la compuerta sigue como en la última
+    bool IsOpen(int index, int turn) const {
+        if (blocked[index] || turn < openTurn[index]) return false;
+        const std::vector<bool>* pattern = gatePattern[index];
+        if (pattern == nullptr || pattern->empty()) return true;
+        return (*pattern)[std::min(turn % cycle, (int)pattern->size() - 1)];
+    }
+
+    bool AreNeighbors(int fromX, int fromY, int toX, int toY) const {
+        const int (*offsets)[2] = HexOffsetsForColumn(fromX);
+        for (int i = 0; i < 6; i++) {
+            if (fromX + offsets[i][0] == toX && fromY + offsets[i][1] == toY) return true;
+        }
+        return false;
+    }
+
+    // Turnos mínimos hasta la meta, -1 si no hay camino. El estado (celda, turno plegado) es finito,
+    // así que a diferencia de los solvers del juego esta búsqueda siempre termina con una respuesta exacta.
+    // Con playerRule la celda destino tiene que estar abierta en el grid al salir, como en un click.
+    int ShortestPath(bool playerRule = false) const {
+        if (start == goal) return 0;
+        int phases = lastOpening + cycle;
+        auto fold = [&](int turn) { return turn < lastOpening ? turn : lastOpening + (turn - lastOpening) % cycle; };
+
+        std::vector<bool> seen((size_t)width * height * phases, false);
+        std::vector<int> frontier{start}, next;
+        seen[(size_t)start * phases] = true;
+        for (int turn = 0; !frontier.empty(); turn++) {
+            int arrival = turn + 1;
+            int folded = fold(arrival);
+            next.clear();
+            for (int index : frontier) {
+                int x = index % width, y = index / width;
+                const int (*offsets)[2] = HexOffsetsForColumn(x);
+                for (int i = 0; i < 6; i++) {
+                    int nx = x + offsets[i][0], ny = y + offsets[i][1];
+                    if (nx < 0 || nx >= width || ny < 0 || ny >= height) continue;
+                    int neighbor = ny * width + nx;
+                    if (!IsOpen(neighbor, playerRule ? turn : arrival)) continue;
+                    if (neighbor == goal) return arrival;
+                    size_t state = (size_t)neighbor * phases + folded;
+                    if (seen[state]) continue;
+                    seen[state] = true;
+                    next.push_back(neighbor);
+                }
+            }
+            frontier.swap(next);
+        }
+        return -1;
+    }
+
+    // Cota de turnos que alcanza para cualquier camino óptimo (cada estado plegado se pisa a lo sumo una vez)
+    long long TurnBound() const {
+        return (long long)lastOpening + (long long)cycle * width * height;
+    }
+
+    bool ValidatePath(const std::vector<GridPos>& path, std::string& error) const {
+        if (path.empty()) {
+            error = "camino vacío";
+            return false;
+        }
+        if (path.front().y * width + path.front().x != start) {
+            error = "no empieza en el inicio";
+            return false;
+        }
+        if (path.back().y * width + path.back().x != goal) {
+            error = "no termina en la meta";
+            return false;
+        }
+        for (size_t i = 1; i < path.size(); i++) {
+            const GridPos& from = path[i - 1];
+            const GridPos& to = path[i];
+            char buffer[128];
+            if (to.x < 0 || to.x >= width || to.y < 0 || to.y >= height) {
+                std::snprintf(buffer, sizeof(buffer), "paso %zu fuera del mapa (%d,%d)", i, to.x, to.y);
+            } else if (!AreNeighbors(from.x, from.y, to.x, to.y)) {
+                std::snprintf(buffer, sizeof(buffer), "paso %zu no es vecino: (%d,%d) -> (%d,%d)", i, from.x, from.y, to.x, to.y);
+            } else if (!IsOpen(to.y * width + to.x, (int)i)) {
+                std::snprintf(buffer, sizeof(buffer), "paso %zu entra a (%d,%d) cerrada en el turno %zu", i, to.x, to.y, i);
+            } else {
+                continue;
+            }
+            error = buffer;
+            return false;
+        }
+        return true;
+    }
+};
+
+struct SolverConfig {
+    const char* name;
+    bool astar;
+    bool gameLimits;            // true: los límites con que corre el juego; false: amplios
+};
+
+const SolverConfig SOLVERS[] = {
+    {"astar", true, true},
+    {"bfs", false, true},
+    {"astar_wide", true, false},
+    {"bfs_wide", false, false},
+};
+const int SOLVER_COUNT = sizeof(SOLVERS) / sizeof(SOLVERS[0]);
+
+struct SolverRun {
+    std::vector<GridPos> path;
+    SolverStats stats;
+    SolverLimits limits;
+    double millis = 0.0;
+};
+
+struct FuzzSettings {
+    int cases = 200;
+    uint64_t seed = 1;
+    int maxSize = 64;
+    double slowFactor = 10.0;       // Un solver es outlier si tarda más que esto por cualquiera de los demás
+    double slowFloorMs = 2.0;       // Debajo de esto el ruido del reloj manda
+    std::string outDir = "fuzz_cases";
+    bool strict = false;            // Outliers y desacuerdos por límites también cuentan como fallo
+};
+
+struct FuzzTotals {
+    int cases = 0;
+    int solvable = 0;
+    int bugs = 0;                   // Caminos inválidos, subóptimos, o "sin camino" cuando sí lo hay
+    int limitDisagreements = 0;     // Desacuerdos explicados por los cortes de profundidad o de nodos
+    int slowCases = 0;
+    int slowBySolver[SOLVER_COUNT + 1] = {};   // 0 = referencia
+    int solverDisagreements = 0;    // astar y bfs del juego no coinciden en si hay camino o en los turnos
+};
+
+double MillisSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+SolverLimits LimitsFor(const SolverConfig& config, const ReferenceRules& rules) {
+    if (config.gameLimits) {
+        return config.astar ? SolverLimits::AStarDefaults() : SolverLimits::BFSDefaults();
+    }
+    long long turnBound = std::min<long long>(rules.TurnBound(), INT_MAX / 2);
+    return {INT_MAX, 10000, (int)turnBound, (size_t)500000};
+}
+
+SolverRun RunSolver(const SolverConfig& config, Grid& grid, const ReferenceRules& rules) {
+    SolverRun run;
+    run.limits = LimitsFor(config, rules);
+    PathFinder pathFinder(&grid);
+    pathFinder.verbose = false;
+    auto startTime = std::chrono::steady_clock::now();
+    run.path = config.astar ? pathFinder.FindPathAStar(run.limits) : pathFinder.FindPathBFS(run.limits);
+    run.millis = MillisSince(startTime);
+    run.stats = pathFinder.lastStats;
+    return run;
+}
+
+// Índice del solver (0 = referencia, 1.. = SOLVERS) que tarda más de slowFactor veces que todos los demás, o -1.
+// Solo se comparan corridas que llegaron a una respuesta: una que cortó por límite hizo menos trabajo.
+int FindSlowOutlier(const std::vector<double>& millis, const std::vector<bool>& completed, const FuzzSettings& settings) {
+    for (size_t i = 0; i < millis.size(); i++) {
+        if (!completed[i] || millis[i] < settings.slowFloorMs) continue;
+        double slowestOther = -1.0;
+        for (size_t j = 0; j < millis.size(); j++) {
+            if (j != i && completed[j]) slowestOther = std::max(slowestOther, millis[j]);
+        }
+        if (slowestOther >= 0.0 && millis[i] > settings.slowFactor * std::max(slowestOther, 0.001)) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+class FuzzCase {
+public:
+    std::string label;
+    std::string text;               // Vacío en --replay (el archivo ya existe)
+    std::vector<std::string> findings;
+    bool bug = false, limit = false, slow = false, disagreement = false;
+
+    void Report(const char* kind, const std::string& detail) {
+        findings.push_back(std::string("[") + kind + "] " + detail);
+    }
+};
+
+// La tabla usa la regla del jugador (celda destino abierta en el grid al salir), así que se compara con la
+// referencia en ese modo; además, seguir la pista con las reglas del juego tiene que ganar en exactamente los
+// turnos que dice la tabla.
+void CheckTimeToGoal(const ReferenceRules& rules, const Grid& grid, FuzzCase& fuzzCase) {
+    TimeToGoalTable timeToGoal;
+    if (!timeToGoal.Build(grid)) {
+        fuzzCase.Report("tabla", "la tabla no se pudo armar");
+        fuzzCase.bug = true;
+        return;
+    }
+    int expected = rules.ShortestPath(true);
+    uint32_t value = timeToGoal.TurnsToGoal(grid.startPos.x, grid.startPos.y, 0);
+    int turns = value == TimeToGoalTable::UNREACHABLE ? -1 : (int)value;
+
+    char buffer[256];
+    if (turns != expected) {
+        std::snprintf(buffer, sizeof(buffer), "la tabla dice %d turnos desde el inicio, el BFS del jugador %d", turns, expected);
+        fuzzCase.Report("tabla", buffer);
+        fuzzCase.bug = true;
+        return;
+    }
+
+    Grid playGrid = grid;
+    Player player(grid.startPos.x, grid.startPos.y, grid.width, grid.height);
+    for (int step = 0; step < turns; step++) {
+        GridPos next;
+        if (!timeToGoal.BestMove(player.x, player.y, playGrid.currentTurn, next) ||
+            !GameRules::ApplyPlayerMove(playGrid, player, next.x, next.y)) {
+            std::snprintf(buffer, sizeof(buffer), "la pista falla en el turno %d desde (%d, %d)", playGrid.currentTurn,
+                          player.x, player.y);
+            fuzzCase.Report("tabla", buffer);
+            fuzzCase.bug = true;
+            return;
+        }
+        playGrid.Update();
+    }
+    if (turns >= 0 && !GameRules::IsWon(playGrid, player)) {
+        std::snprintf(buffer, sizeof(buffer), "siguiendo la pista %d turnos no se llega a la meta", turns);
+        fuzzCase.Report("tabla", buffer);
+        fuzzCase.bug = true;
+    }
+}
+
+void CheckLevel(LevelData& levelData, FuzzCase& fuzzCase, const FuzzSettings& settings, FuzzTotals& totals) {
+    LevelTables::AttachGoalDistances(levelData);   // Como lo carga el juego
+    ReferenceRules rules(levelData);
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+
+    auto referenceStart = std::chrono::steady_clock::now();
+    int optimal = rules.ShortestPath();
+    double referenceMillis = MillisSince(referenceStart);
+
+    totals.cases++;
+    if (optimal >= 0) totals.solvable++;
+
+    char buffer[256];
+    // El óptimo que muestra el menú (LevelPack) sale de LevelTables y tiene que ser el mismo que el de los solvers
+    int menuOptimal = LevelTables::ComputeShortestPathLength(levelData);
+    if (menuOptimal != optimal) {
+        std::snprintf(buffer, sizeof(buffer), "LevelTables dice %d turnos, la referencia %d", menuOptimal, optimal);
+        fuzzCase.Report("optimo_menu", buffer);
+        fuzzCase.bug = true;
+    }
+
+    SolverRun runs[SOLVER_COUNT];
+    for (int s = 0; s < SOLVER_COUNT; s++) {
+        runs[s] = RunSolver(SOLVERS[s], grid, rules);
+    }
+
+    for (int s = 0; s < SOLVER_COUNT; s++) {
+        const SolverConfig& config = SOLVERS[s];
+        const SolverRun& run = runs[s];
+        int turns = run.path.empty() ? -1 : (int)run.path.size() - 1;
+
+        std::string error;
+        if (!run.path.empty() && !rules.ValidatePath(run.path, error)) {
+            std::snprintf(buffer, sizeof(buffer), "%s devolvió un camino inválido: %s", config.name, error.c_str());
+            fuzzCase.Report("camino_invalido", buffer);
+            fuzzCase.bug = true;
+            continue;
+        }
+        if (optimal < 0) {
+            continue;   // Sin camino de referencia solo se valida lo que devolvieron
+        }
+
+        if (turns >= 0 && turns != optimal) {
+            std::snprintf(buffer, sizeof(buffer), "%s encontró %d turnos, el óptimo es %d", config.name, turns, optimal);
+            fuzzCase.Report("suboptimo", buffer);
+            fuzzCase.bug = true;
+        } else if (turns < 0 && run.stats.stop == SolverStop::EXHAUSTED && optimal <= run.limits.maxTurn) {
+            std::snprintf(buffer, sizeof(buffer), "%s dice que no hay camino y hay uno de %d turnos", config.name, optimal);
+            fuzzCase.Report("sin_camino", buffer);
+            fuzzCase.bug = true;
+        } else if (turns < 0) {
+            // Cortó por profundidad (maxTurn) o por iteraciones / nodos / tiempo
+            const char* cause = run.stats.stop == SolverStop::EXHAUSTED ? "max_turn" : StopName(run.stats.stop);
+            std::snprintf(buffer, sizeof(buffer), "%s no llega al óptimo de %d turnos por el límite %s (maxTurn %d)",
+                          config.name, optimal, cause, run.limits.maxTurn);
+            fuzzCase.Report("limite", buffer);
+            fuzzCase.limit = true;
+        }
+    }
+
+    CheckTimeToGoal(rules, grid, fuzzCase);
+
+    // Lo que ve el jugador: los dos solvers del juego tienen que coincidir entre sí
+    int astarTurns = runs[0].path.empty() ? -1 : (int)runs[0].path.size() - 1;
+    int bfsTurns = runs[1].path.empty() ? -1 : (int)runs[1].path.size() - 1;
+    if (astarTurns != bfsTurns) {
+        std::snprintf(buffer, sizeof(buffer), "astar %d turnos (%s) vs bfs %d turnos (%s), referencia %d", astarTurns,
+                      StopName(runs[0].stats.stop), bfsTurns, StopName(runs[1].stats.stop), optimal);
+        fuzzCase.Report("desacuerdo", buffer);
+        fuzzCase.disagreement = true;
+        totals.solverDisagreements++;
+    }
+
+    // Outliers de tiempo: se remide con la mejor de 3 corridas antes de acusar, el reloj de una VM es ruidoso
+    std::vector<double> millis{referenceMillis};
+    std::vector<bool> completed{true};
+    for (const SolverRun& run : runs) {
+        millis.push_back(run.millis);
+        completed.push_back(run.stats.stop == SolverStop::FOUND || run.stats.stop == SolverStop::EXHAUSTED);
+    }
+    if (FindSlowOutlier(millis, completed, settings) >= 0) {
+        for (int repeat = 0; repeat < 2; repeat++) {
+            referenceStart = std::chrono::steady_clock::now();
+            rules.ShortestPath();
+            millis[0] = std::min(millis[0], MillisSince(referenceStart));
+            for (int s = 0; s < SOLVER_COUNT; s++) {
+                millis[s + 1] = std::min(millis[s + 1], RunSolver(SOLVERS[s], grid, rules).millis);
+            }
+        }
+        int slowest = FindSlowOutlier(millis, completed, settings);
+        if (slowest >= 0) {
+            std::string timings;
+            for (size_t i = 0; i < millis.size(); i++) {
+                std::snprintf(buffer, sizeof(buffer), "%s%s %.2f ms", i ? ", " : "", i ? SOLVERS[i - 1].name : "referencia", millis[i]);
+                timings += buffer;
+            }
+            std::snprintf(buffer, sizeof(buffer), "%s tarda más de %.0fx que el resto (",
+                          slowest ? SOLVERS[slowest - 1].name : "referencia", settings.slowFactor);
+            fuzzCase.Report("lento", buffer + timings + ")");
+            fuzzCase.slow = true;
+            totals.slowBySolver[slowest]++;
+        }
+    }
+
+    if (fuzzCase.bug) totals.bugs++;
+    if (fuzzCase.limit) totals.limitDisagreements++;
+    if (fuzzCase.slow) totals.slowCases++;
+}
+
+// Parámetros al azar para un caso: la mitad chicos (3..12 de lado) y la mitad medianos (hasta maxSize)
+GeneratorParams RandomParams(uint64_t caseSeed, const FuzzSettings& settings) {
+    std::mt19937_64 rng(caseSeed);
+    auto pick = [&](int low, int high) { return low + (int)(rng() % (uint64_t)(high - low + 1)); };
+
+    GeneratorParams params;
+    bool small = rng() % 2 == 0 || settings.maxSize <= 12;
+    params.width = small ? pick(3, 12) : pick(13, settings.maxSize);
+    params.height = small ? pick(3, 12) : pick(13, settings.maxSize);
+    int cells = params.width * params.height;
+    params.wallPercent = pick(0, 45);
+    params.patternCount = pick(1, 5);
+    params.gatePeriod = pick(1, 12);
+    params.gateCount = pick(0, cells / 5);
+    params.temporalCount = pick(0, cells / 10);
+    params.temporalMinTurns = pick(0, 5);
+    params.temporalMaxTurns = params.temporalMinTurns + pick(0, 30);
+    params.itemCount = pick(0, 3);
+    params.corridorObstaclePercent = pick(0, 100);
+    params.seed = caseSeed;
+    params.maxAttempts = 1;
+    params.requireSolvable = false;     // También interesan los niveles sin camino
+    params.verifyWithPathFinder = false; // El A* se compara después contra la referencia
+    return params;
+}
+
+// El generador siempre deja un corredor libre; para tener también niveles sin camino a un tercio de los casos
+// se le tapan celdas libres al azar, corredor incluido (el mapa empieza después de las 4 líneas de cabecera)
+void SealCorridor(uint64_t caseSeed, std::string& text) {
+    std::mt19937_64 rng(caseSeed ^ 0x5EA1C0DEull);
+    if (rng() % 3 != 0) return;
+    uint64_t percent = 5 + rng() % 36;
+
+    size_t position = 0;
+    for (int line = 0; line < 4 && position != std::string::npos; line++) {
+        position = text.find('\n', position);
+        if (position != std::string::npos) position++;
+    }
+    size_t mapEnd = position == std::string::npos ? std::string::npos : text.find("\n\n", position);
+    for (size_t i = position; i < mapEnd && i < text.size(); i++) {
+        if (text[i] == '.' && rng() % 100 < percent) text[i] = '#';
+    }
+}
+
+// A un cuarto de los casos se le acortan los patrones GATE_ (el generador los hace del largo del ciclo)
+void ShortenPatterns(uint64_t caseSeed, std::string& text) {
+    std::mt19937_64 rng(caseSeed ^ 0x5407A77Eull);
+    if (rng() % 4 != 0) return;
+
+    size_t position = 0;
+    while ((position = text.find("\nGATE_", position)) != std::string::npos) {
+        size_t patternStart = text.find(' ', position + 1);
+        size_t lineEnd = text.find('\n', position + 1);
+        if (lineEnd == std::string::npos) lineEnd = text.size();
+        position = lineEnd;
+        if (patternStart == std::string::npos || patternStart + 2 >= lineEnd) continue;
+        size_t length = lineEnd - patternStart - 1;
+        size_t keep = 1 + rng() % (length - 1);
+        text.erase(patternStart + 1 + keep, length - keep);
+        position = patternStart + 1 + keep;
+    }
+}
+
+void PrintFindings(const FuzzCase& fuzzCase, const std::string& reproducer) {
+    for (const std::string& finding : fuzzCase.findings) {
+        std::printf("%s: %s\n", fuzzCase.label.c_str(), finding.c_str());
+    }
+    if (!reproducer.empty()) {
+        std::printf("    reproducir: etg-fuzz --replay %s\n", reproducer.c_str());
+    }
+}
+
+std::string SaveReproducer(const FuzzCase& fuzzCase, const FuzzSettings& settings) {
+    const char* kind = fuzzCase.bug ? "bug" : fuzzCase.slow ? "lento" : fuzzCase.disagreement ? "desacuerdo" : "limite";
+    std::filesystem::create_directories(settings.outDir);
+    std::string filename = settings.outDir + "/" + kind + "_" + fuzzCase.label + ".txt";
+    std::ofstream file(filename, std::ios::binary);
+    file.write(fuzzCase.text.data(), (std::streamsize)fuzzCase.text.size());
+    return file ? filename : std::string();
+}
+
+void PrintUsage(const char* program) {
+    FuzzSettings defaults;
+    std::fprintf(stderr,
+        "Uso: %s [opciones]\n"
+        "  --cases N          casos a generar (%d)\n"
+        "  --seed S           semilla del primer caso; el caso i usa S + i (%llu)\n"
+        "  --max-size N       lado máximo de los niveles medianos (%d)\n"
+        "  --slow-factor F    outlier si un solver tarda F veces más que todos los demás (%.0f)\n"
+        "  --out CARPETA      dónde guardar los reproducibles (%s)\n"
+        "  --strict           los outliers de tiempo y los desacuerdos por límites también hacen fallar\n"
+        "  --replay A.txt ... corre las verificaciones sobre niveles ya guardados\n",
+        program, defaults.cases, (unsigned long long)defaults.seed, defaults.maxSize, defaults.slowFactor, defaults.outDir.c_str());
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    FuzzSettings settings;
+    std::vector<std::string> replayFiles;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--cases" && hasValue) {
+            settings.cases = std::atoi(argv[++i]);
+        } else if (argument == "--seed" && hasValue) {
+            settings.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--max-size" && hasValue) {
+            settings.maxSize = std::max(13, std::atoi(argv[++i]));
+        } else if (argument == "--slow-factor" && hasValue) {
+            settings.slowFactor = std::atof(argv[++i]);
+        } else if (argument == "--out" && hasValue) {
+            settings.outDir = argv[++i];
+        } else if (argument == "--strict") {
+            settings.strict = true;
+        } else if (argument == "--replay") {
+            while (i + 1 < argc && argv[i + 1][0] != '-') replayFiles.push_back(argv[++i]);
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // Loader y grid loguean por std::cout; el reporte va por stdout con printf
+    NullBuffer nullBuffer;
+    std::streambuf* originalCout = std::cout.rdbuf(&nullBuffer);
+    FuzzTotals totals;
+    int loadFailures = 0;
+    auto startTime = std::chrono::steady_clock::now();
+
+    if (!replayFiles.empty()) {
+        for (const std::string& filename : replayFiles) {
+            LevelData levelData;
+            if (!FileLoader::LoadLevel(filename, levelData)) {
+                std::printf("%s: no se pudo cargar\n", filename.c_str());
+                loadFailures++;
+                continue;
+            }
+            FuzzCase fuzzCase;
+            fuzzCase.label = filename;
+            CheckLevel(levelData, fuzzCase, settings, totals);
+            if (fuzzCase.findings.empty()) std::printf("%s: ok\n", filename.c_str());
+            PrintFindings(fuzzCase, "");
+        }
+    } else {
+        for (int n = 0; n < settings.cases; n++) {
+            uint64_t caseSeed = settings.seed + (uint64_t)n;
+            GeneratorParams params = RandomParams(caseSeed, settings);
+            GeneratedLevel generated;
+            LevelData levelData;
+            bool generatedOk = LevelGenerator::Generate(params, generated);
+            if (generatedOk) {
+                SealCorridor(caseSeed, generated.text);
+                ShortenPatterns(caseSeed, generated.text);
+            }
+            if (!generatedOk || !FileLoader::LoadFromTXTBuffer("fuzz", generated.text, levelData)) {
+                std::printf("caso %llu: el generador no dio un nivel válido\n", (unsigned long long)caseSeed);
+                loadFailures++;
+                continue;
+            }
+
+            FuzzCase fuzzCase;
+            fuzzCase.label = std::to_string(caseSeed);
+            fuzzCase.text = generated.text;
+            CheckLevel(levelData, fuzzCase, settings, totals);
+            if (!fuzzCase.findings.empty()) {
+                PrintFindings(fuzzCase, SaveReproducer(fuzzCase, settings));
+            }
+        }
+    }
+
+    std::cout.rdbuf(originalCout);
+    std::fprintf(stderr,
+        "%d casos (%d con camino) en %.1f s | %d bugs, %d outliers de tiempo, %d desacuerdos astar/bfs, %d cortes por límites\n",
+        totals.cases, totals.solvable, MillisSince(startTime) / 1000.0, totals.bugs, totals.slowCases,
+        totals.solverDisagreements, totals.limitDisagreements);
+
+    if (totals.slowCases > 0) {
+        std::fprintf(stderr, "outliers por solver:");
+        for (int i = 0; i <= SOLVER_COUNT; i++) {
+            std::fprintf(stderr, " %s %d", i ? SOLVERS[i - 1].name : "referencia", totals.slowBySolver[i]);
+        }
+        std::fprintf(stderr, "\n");
+    }
+
+    // Los outliers y los cortes por límites se reportan siempre, pero solo hacen fallar con --strict
+    bool failed = loadFailures > 0 || totals.bugs > 0 ||
+                  (settings.strict && (totals.slowCases > 0 || totals.limitDisagreements > 0 || totals.solverDisagreements > 0));
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+// etg_gen.cpp, genera niveles .txt procedurales con solución garantizada
+// Uso: etg-gen [opciones] --output nivel.txt
+//      etg-gen [opciones] --count 100 --output carpeta/gen    (escribe carpeta/gen_0000.txt, ...)
+#include "LevelGenerator.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+namespace {
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// "a:b" o "a" (entonces el rango es a:a)
+bool ParseRange(const char* text, int& low, int& high) {
+    char* end = nullptr;
+    low = (int)std::strtol(text, &end, 10);
+    if (end == text) return false;
+    high = low;
+    if (*end == ':') {
+        const char* second = end + 1;
+        high = (int)std::strtol(second, &end, 10);
+        if (end == second) return false;
+    }
+    return *end == '\0';
+}
+
+void PrintUsage(const char* program) {
+    GeneratorParams defaults;
+    std::fprintf(stderr,
+        "Uso: %s [opciones] --output nivel.txt\n"
+        "  --size WxH                 dimensiones (por defecto %dx%d)\n"
+        "  --walls P                  porcentaje de paredes fuera del corredor (%d)\n"
+        "  --patterns N               patrones GATE_* (%d)\n"
+        "  --period N                 largo de los patrones y del ciclo de turnos (%d)\n"
+        "  --gates N                  compuertas ASSIGN_* (%d)\n"
+        "  --temporal N               paredes temporales (%d)\n"
+        "  --temporal-turns A:B       turnos en que se abren (%d:%d)\n"
+        "  --items N                  items (%d)\n"
+        "  --corridor-obstacles P     porcentaje del corredor elegible para compuertas/temporales (%d)\n"
+        "  --seed N                   semilla (%llu)\n"
+        "  --attempts N               intentos antes de rendirse (%d)\n"
+        "  --no-verify-astar          no corre el ARA* de ESPACIO con sus límites (solo el BFS por turnos)\n"
+        "  --count N                  genera N niveles con semillas consecutivas; --output es el prefijo\n"
+        "  --verbose                  deja pasar el log del loader\n",
+        program, defaults.width, defaults.height, defaults.wallPercent, defaults.patternCount, defaults.gatePeriod,
+        defaults.gateCount, defaults.temporalCount, defaults.temporalMinTurns, defaults.temporalMaxTurns,
+        defaults.itemCount, defaults.corridorObstaclePercent, (unsigned long long)defaults.seed, defaults.maxAttempts);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    GeneratorParams params;
+    std::string output;
+    int count = 1;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = true;
+        if (argument == "--size" && hasValue) {
+            ok = std::sscanf(argv[++i], "%dx%d", &params.width, &params.height) == 2;
+        } else if (argument == "--walls" && hasValue) {
+            params.wallPercent = std::atoi(argv[++i]);
+        } else if (argument == "--patterns" && hasValue) {
+            params.patternCount = std::atoi(argv[++i]);
+        } else if (argument == "--period" && hasValue) {
+            params.gatePeriod = std::atoi(argv[++i]);
+        } else if (argument == "--gates" && hasValue) {
+            params.gateCount = std::atoi(argv[++i]);
+        } else if (argument == "--temporal" && hasValue) {
+            params.temporalCount = std::atoi(argv[++i]);
+        } else if (argument == "--temporal-turns" && hasValue) {
+            ok = ParseRange(argv[++i], params.temporalMinTurns, params.temporalMaxTurns);
+        } else if (argument == "--items" && hasValue) {
+            params.itemCount = std::atoi(argv[++i]);
+        } else if (argument == "--corridor-obstacles" && hasValue) {
+            params.corridorObstaclePercent = std::atoi(argv[++i]);
+        } else if (argument == "--seed" && hasValue) {
+            params.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--attempts" && hasValue) {
+            params.maxAttempts = std::atoi(argv[++i]);
+        } else if (argument == "--no-verify-astar") {
+            params.verifyWithPathFinder = false;
+        } else if (argument == "--count" && hasValue) {
+            count = std::atoi(argv[++i]);
+        } else if (argument == "--output" && hasValue) {
+            output = argv[++i];
+        } else if (argument == "--verbose") {
+            verbose = true;
+        } else {
+            ok = false;
+        }
+
+        if (!ok) {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (output.empty() || count < 1) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // El generador parsea cada intento con FileLoader, que loguea por std::cout
+    NullBuffer nullBuffer;
+    std::streambuf* originalCout = std::cout.rdbuf();
+    if (!verbose) {
+        std::cout.rdbuf(&nullBuffer);
+    }
+
+    uint64_t firstSeed = params.seed;
+    int failures = 0;
+    for (int n = 0; n < count; n++) {
+        std::string filename = output;
+        if (count > 1) {
+            char suffix[32];
+            std::snprintf(suffix, sizeof(suffix), "_%04d.txt", n);
+            filename += suffix;
+        }
+
+        params.seed = firstSeed + (uint64_t)n;
+        GeneratedLevel level;
+        auto startTime = std::chrono::steady_clock::now();
+        bool ok = LevelGenerator::GenerateToFile(params, filename, level);
+        double millis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+        if (ok) {
+            std::fprintf(stderr, "%s: %dx%d, óptimo %d movimientos, %d intento%s, %.1f ms\n", filename.c_str(),
+                         params.width, params.height, level.optimalMoves, level.attempts, level.attempts == 1 ? "" : "s", millis);
+        } else {
+            // El motivo lo deja el generador en std::cout (visible con --verbose)
+            std::fprintf(stderr, "%s: no se pudo generar (semilla %llu)\n", filename.c_str(), (unsigned long long)params.seed);
+            failures++;
+        }
+    }
+
+    std::cout.rdbuf(originalCout);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,204 @@
+// etg_items.cpp, ruta por puntaje (ItemRoutePlanner) sobre niveles dados o sobre niveles generados con cada
+// vez más items. Cada ruta se juega con GameRules como clicks del jugador para confirmar que es válida, que gana y
+// que da el puntaje que dice el planner; se compara con el puntaje del camino del A* del auto-solve.
+// Uso: etg-items [--items N] [--step S] [--size S] [--seed S] [--dp-limit K] [--beam W] [--branching B]
+//                [--path] [niveles...]
+#include "GameRules.h"
+#include "ItemRoutePlanner.h"
+#include "LevelGenerator.h"
+#include "PathFinder.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+struct ItemsSettings {
+    int maxItems = 24;
+    int step = 2;
+    int size = 24;
+    uint64_t seed = 1;
+    bool printPath = false;
+    ItemRouteSettings planner;
+    std::vector<std::string> levels;
+};
+
+// Lo que pasó al jugar un camino desde el inicio
+struct PlayResult {
+    bool valid = true;          // Todos los pasos fueron clicks aceptados
+    bool won = false;
+    int score = 0;
+    int items = 0;
+};
+
+PlayResult Play(const LevelData& levelData, const std::vector<GridPos>& path, bool asClicks) {
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+    grid.ResetState();
+    Player player(grid.startPos.x, grid.startPos.y, grid.width, grid.height);
+    PlayResult result;
+    for (const GridPos& next : path) {
+        if (asClicks) {
+            if (!GameRules::ApplyPlayerMove(grid, player, next.x, next.y)) {
+                result.valid = false;
+                break;
+            }
+        } else {
+            GameRules::ApplySolverStep(grid, player, next);
+        }
+        grid.Update();
+    }
+    result.won = GameRules::IsWon(grid, player);
+    result.score = player.score;
+    result.items = (int)player.items.size();
+    return result;
+}
+
+int AStarScore(const LevelData& levelData) {
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+    grid.ResetState();
+    PathFinder pathFinder(&grid);
+    pathFinder.verbose = false;
+    std::vector<GridPos> path = pathFinder.FindPathAStar();
+    if (path.empty()) return -1;
+    PlayResult played = Play(levelData, path, false);
+    return played.won ? played.score : -1;
+}
+
+// Una línea por nivel; false si la ruta no se pudo jugar o no coincide con lo que dice el planner
+bool Report(const std::string& name, const LevelData& levelData, const ItemsSettings& settings) {
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+    grid.ResetState();
+    Player player(grid.startPos.x, grid.startPos.y, grid.width, grid.height);
+    ItemRoute route = ItemRoutePlanner::PlanFor(grid, player, settings.planner);
+    int astar = AStarScore(levelData);
+
+    if (!route.found) {
+        std::printf("%-34s %3d items  sin ruta a la meta (A*: %s)\n", name.c_str(), route.itemCount,
+                    astar >= 0 ? "con camino" : "sin camino");
+        return astar < 0;
+    }
+    PlayResult played = Play(levelData, route.path, true);
+    bool ok = played.valid && played.won && played.score == route.score && played.items == route.items;
+    std::printf("%-34s %3d items  %-4s  junta %3d  puntaje %5d (A* %5d)  %3d vueltas  %4d turnos  "
+                "%4d tramos %8.2f ms  orden %8.2f ms  %7d candidatos%s\n",
+                name.c_str(), route.itemCount, route.subsetDp ? "DP" : "beam", route.items, route.score, astar,
+                route.backtracks, route.turns, route.legSearches, route.legMillis, route.orderMillis, route.candidates,
+                ok ? "" : "  NO COINCIDE");
+    if (!ok) {
+        std::printf("    jugada: %s, %s, puntaje %d, %d items\n", played.valid ? "válida" : "click rechazado",
+                    played.won ? "gana" : "no gana", played.score, played.items);
+    }
+    if (settings.printPath) {
+        std::printf("    camino:");
+        for (const GridPos& step : route.path) std::printf(" (%d,%d)", step.x, step.y);
+        std::printf("\n");
+    }
+    return ok;
+}
+
+void PrintUsage(const char* program) {
+    ItemsSettings defaults;
+    std::fprintf(stderr,
+        "Uso: %s [opciones] [niveles...]\n"
+        "  --items N           sin niveles: genera niveles con 0..N items (%d)\n"
+        "  --step S            de a cuántos items sube la serie (%d)\n"
+        "  --size S            lado de los niveles generados (%d)\n"
+        "  --seed S            semilla de los niveles generados\n"
+        "  --dp-limit K        hasta cuántos items usa la DP por subconjuntos (%d, máximo 16)\n"
+        "  --beam W            estados que guarda la beam search (%d)\n"
+        "  --branching B       items que prueba cada estado del beam (%d)\n"
+        "  --path              imprime el camino elegido\n",
+        program, defaults.maxItems, defaults.step, defaults.size, defaults.planner.maxDpItems,
+        defaults.planner.beamWidth, defaults.planner.beamBranching);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ItemsSettings settings;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--items" && hasValue) {
+            settings.maxItems = std::max(0, std::atoi(argv[++i]));
+        } else if (argument == "--step" && hasValue) {
+            settings.step = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--size" && hasValue) {
+            settings.size = std::max(8, std::atoi(argv[++i]));
+        } else if (argument == "--seed" && hasValue) {
+            settings.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--dp-limit" && hasValue) {
+            settings.planner.maxDpItems = std::atoi(argv[++i]);
+        } else if (argument == "--beam" && hasValue) {
+            settings.planner.beamWidth = std::atoi(argv[++i]);
+        } else if (argument == "--branching" && hasValue) {
+            settings.planner.beamBranching = std::atoi(argv[++i]);
+        } else if (argument == "--path") {
+            settings.printPath = true;
+        } else if (!argument.empty() && argument[0] != '-') {
+            settings.levels.push_back(argument);
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    // El loader, el generador y el A* loguean por std::cout; el reporte va por stdout con printf
+    NullBuffer nullBuffer;
+    std::streambuf* originalCout = std::cout.rdbuf();
+    int failures = 0;
+
+    if (!settings.levels.empty()) {
+        for (const std::string& filename : settings.levels) {
+            std::cout.rdbuf(&nullBuffer);
+            LevelData levelData;
+            bool loaded = FileLoader::LoadLevel(filename, levelData);
+            std::cout.rdbuf(originalCout);
+            if (!loaded) {
+                std::printf("%s: no se pudo cargar\n", filename.c_str());
+                failures++;
+                continue;
+            }
+            std::cout.rdbuf(&nullBuffer);
+            bool ok = Report(filename, levelData, settings);
+            std::cout.rdbuf(originalCout);
+            if (!ok) failures++;
+        }
+        return failures > 0 ? 1 : 0;
+    }
+
+    // Serie: mismo tamaño y obstáculos, cada vez más items, para ver cómo crece el tiempo con K
+    for (int items = 0; items <= settings.maxItems; items += settings.step) {
+        GeneratorParams params;
+        params.width = settings.size;
+        params.height = settings.size * 3 / 4;
+        params.gateCount = settings.size * settings.size / 40;
+        params.temporalCount = settings.size * settings.size / 80;
+        params.itemCount = items;
+        params.seed = settings.seed;
+        GeneratedLevel generated;
+        LevelData levelData;
+        std::cout.rdbuf(&nullBuffer);
+        bool loaded = LevelGenerator::Generate(params, generated) &&
+                      FileLoader::LoadFromTXTBuffer("generado", generated.text, levelData);
+        bool ok = loaded && Report("generado " + std::to_string(params.width) + "x" + std::to_string(params.height),
+                                   levelData, settings);
+        std::cout.rdbuf(originalCout);
+        if (!loaded) std::printf("no se pudo generar el nivel con %d items\n", items);
+        if (!ok) failures++;
+    }
+    return failures > 0 ? 1 : 0;
+}
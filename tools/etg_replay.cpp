@@ -0,0 +1,301 @@
+// etg_replay.cpp, reproduce partidas grabadas (.etgr) sin ventana y a toda velocidad, verificando puntaje y estado final
+// Uso: etg-replay [--level nivel.txt] [--pack paquete.etgp] [--repeat N] partida.etgr ...
+//      etg-replay --demo nivel.txt salida.etgr [--seed S] [--clicks N] [--score|--anytime]
+//      (arma una partida sintética)
+#include "GameRules.h"
+#include "ItemRoutePlanner.h"
+#include "LevelPack.h"
+#include "LevelTables.h"
+#include "PathFinder.h"
+#include "SessionRecording.h"
+#include "TimeToGoalTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+const double AUTO_SOLVE_STEP_SECONDS = 0.5;     // Lo que espera UpdateAutoSolve entre pasos
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+struct ReplaySettings {
+    std::string levelOverride;
+    std::string packFile = "assets/levels/levels.etgp";
+    int repeat = 1;
+};
+
+const char* StateName(GameState state) {
+    switch (state) {
+        case GameState::MENU: return "MENU";
+        case GameState::TUTORIAL: return "TUTORIAL";
+        case GameState::PLAYING: return "PLAYING";
+        case GameState::AUTO_SOLVING: return "AUTO_SOLVING";
+        case GameState::GAME_OVER: return "GAME_OVER";
+        case GameState::WIN: return "WIN";
+    }
+    return "?";
+}
+
+// La clave es la misma que usa Game: una ruta o "pack:<índice>"
+bool LoadRecordedLevel(const std::string& key, const ReplaySettings& settings, LevelData& levelData) {
+    const std::string packPrefix = "pack:";
+    if (settings.levelOverride.empty() && key.compare(0, packPrefix.size(), packPrefix) == 0) {
+        LevelPack pack;
+        if (!pack.Open(settings.packFile)) return false;
+        size_t index = std::strtoul(key.c_str() + packPrefix.size(), nullptr, 10);
+        return index < pack.LevelCount() && pack.LoadLevel(index, levelData);
+    }
+    return FileLoader::LoadLevel(settings.levelOverride.empty() ? key : settings.levelOverride, levelData);
+}
+
+bool ReplayFile(const std::string& filename, const ReplaySettings& settings) {
+    SessionRecording recording;
+    if (!SessionReplayer::Load(filename, recording)) {
+        std::printf("%s: no se pudo leer la grabación\n", filename.c_str());
+        return false;
+    }
+
+    LevelData levelData;
+    if (!LoadRecordedLevel(recording.levelKey, settings, levelData)) {
+        std::printf("%s: no se pudo cargar el nivel %s\n", filename.c_str(), recording.levelKey.c_str());
+        return false;
+    }
+    if (GameRules::LevelFingerprint(levelData) != recording.levelFingerprint) {
+        std::printf("%s: el nivel %s cambió desde que se grabó la partida\n", filename.c_str(), recording.levelKey.c_str());
+        return false;
+    }
+
+    // Igual que Game::PrepareLevel: el A* del auto-solve usa el campo de distancias
+    LevelTables::AttachGoalDistances(levelData);
+    Grid grid(10, 8);
+    grid.LoadFromLevelData(levelData);
+    Player player(grid.startPos.x, grid.startPos.y, grid.width, grid.height);
+
+    ReplayResult result;
+    auto startTime = std::chrono::steady_clock::now();
+    for (int i = 0; i < settings.repeat; i++) {
+        if (!SessionReplayer::Replay(recording, grid, player, result)) break;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (!result.ok) {
+        if (result.divergenceEvent >= 0) {
+            std::printf("%s: DIVERGE en el evento %d de %zu: %s\n", filename.c_str(), result.divergenceEvent,
+                        recording.events.size(), result.error.c_str());
+        } else {
+            std::printf("%s: %s\n", filename.c_str(), result.error.c_str());
+        }
+        return false;
+    }
+
+    int solverSteps = 0;
+    for (const SessionEvent& event : recording.events) {
+        if (event.type == SessionEventType::SOLVER_STEP) solverSteps++;
+    }
+    double eventsPerSecond = seconds > 0.0 ? recording.events.size() * (double)settings.repeat / seconds : 0.0;
+    std::printf("%s: OK %zu eventos, puntaje %d, turno %d, %s | %.3f ms por partida, %.0f eventos/s",
+                filename.c_str(), recording.events.size(), result.final.score, result.final.turn,
+                StateName(result.final.state), seconds * 1000.0 / settings.repeat, eventsPerSecond);
+    if (solverSteps > 0 && seconds > 0.0) {
+        std::printf(", %.0fx el auto-solve en tiempo real", solverSteps * AUTO_SOLVE_STEP_SECONDS * settings.repeat / seconds);
+    }
+    std::printf("\n");
+    return true;
+}
+
+// Partida sintética: clicks al azar (vecinos casi siempre, a veces cualquier celda), algún reinicio y al final
+// el auto-solve (con --score, el de puntaje; con --anytime, el ARA* con sus mejoras). Sigue el mismo orden que
+// Game::Update, así que tiene que reproducirse exacta; después de un GAME_OVER el juego solo acepta R, así que
+// ahí se reinicia.
+bool MakeDemo(const std::string& levelFile, const std::string& output, uint64_t seed, int clicks, bool scoreSolve,
+              bool anytime) {
+    LevelData levelData;
+    if (!FileLoader::LoadLevel(levelFile, levelData)) {
+        std::printf("%s: no se pudo cargar\n", levelFile.c_str());
+        return false;
+    }
+    // Sin el campo de distancias el anytime encuentra varios caminos y la partida graba los reemplazos
+    if (!anytime) LevelTables::AttachGoalDistances(levelData);
+    Grid grid(10, 8);
+    grid.LoadFromLevelData(levelData);
+    Player player(grid.startPos.x, grid.startPos.y, grid.width, grid.height);
+    PathFinder pathFinder(&grid);
+    pathFinder.verbose = false;
+    TimeToGoalTable timeToGoal;
+    timeToGoal.Build(grid);
+
+    SessionRecorder recorder;
+    recorder.Begin(levelFile, levelData);
+    std::mt19937_64 rng(seed);
+    bool won = false;
+    bool gameOver = false;
+
+    for (int i = 0; i < clicks && !won; i++) {
+        if (gameOver || rng() % 50 == 0) {
+            grid.ResetState();
+            player.Reset(grid.startPos.x, grid.startPos.y);
+            recorder.RecordReset();
+            gameOver = false;
+            continue;
+        }
+
+        int x, y;
+        std::vector<GridPos> neighbors = grid.GetNeighbors(player.x, player.y);
+        if (rng() % 10 != 0 && !neighbors.empty()) {
+            GridPos target = neighbors[rng() % neighbors.size()];
+            x = target.x;
+            y = target.y;
+        } else {
+            x = (int)(rng() % grid.width);
+            y = (int)(rng() % grid.height);
+        }
+
+        int turn = grid.currentTurn;
+        bool moved = GameRules::ApplyPlayerMove(grid, player, x, y);
+        recorder.RecordClick(turn, x, y, moved);
+        grid.Update();
+        won = GameRules::IsWon(grid, player);
+        gameOver = !won && timeToGoal.Ready() && !timeToGoal.CanReachGoal(player.x, player.y, grid.currentTurn);
+    }
+
+    std::vector<GridPos> solutionPath;
+    if (!won && !gameOver) {
+        if (anytime) {
+            // Como si cada mejora llegara después de un paso: se adopta la primera y las siguientes solo si
+            // son más cortas y siguen los pasos ya dados, igual que Game::AdoptAnytimePath
+            std::vector<std::vector<GridPos>> solutions;
+            pathFinder.FindPathAnytime(SolverLimits::AnytimeFor(grid), AnytimeSettings(),
+                                       [&](const AnytimeSolution& solution) { solutions.push_back(solution.path); });
+            if (solutions.empty()) {
+                recorder.RecordAnytimeSolve(grid.currentTurn, 0);
+            } else {
+                solutionPath = solutions[0];
+                recorder.RecordAnytimeSolve(grid.currentTurn, (int)solutionPath.size());
+                size_t next = 1;
+                for (size_t step = 0; step < solutionPath.size(); step++) {
+                    recorder.RecordSolverStep(grid.currentTurn, solutionPath[step]);
+                    GameRules::ApplySolverStep(grid, player, solutionPath[step]);
+                    grid.Update();
+                    for (; next < solutions.size(); next++) {
+                        const std::vector<GridPos>& candidate = solutions[next];
+                        if (candidate.size() < solutionPath.size() && candidate.size() > step + 1 &&
+                            std::equal(solutionPath.begin(), solutionPath.begin() + step + 1, candidate.begin())) {
+                            solutionPath = candidate;
+                            recorder.RecordAnytimeSolve(grid.currentTurn, (int)(solutionPath.size() - step - 1));
+                            next++;
+                            break;
+                        }
+                    }
+                }
+            }
+            solutionPath.clear();
+        } else if (scoreSolve) {
+            solutionPath = ItemRoutePlanner::PlanFor(grid, player).path;
+            recorder.RecordScoreSolve(grid.currentTurn, (int)solutionPath.size());
+        } else {
+            solutionPath = pathFinder.FindPathAStar();
+            recorder.RecordAutoSolve(grid.currentTurn, (int)solutionPath.size());
+        }
+        for (const GridPos& step : solutionPath) {
+            recorder.RecordSolverStep(grid.currentTurn, step);
+            GameRules::ApplySolverStep(grid, player, step);
+            grid.Update();
+        }
+    }
+
+    GameState state = GameRules::IsWon(grid, player) ? GameState::WIN : GameState::PLAYING;
+    if (gameOver) state = GameState::GAME_OVER;
+    return recorder.Finish(grid, player, state, output);
+}
+
+void PrintUsage(const char* program) {
+    std::fprintf(stderr,
+        "Uso: %s [--level nivel] [--pack paquete.etgp] [--repeat N] partida.etgr ...\n"
+        "     %s --demo nivel salida.etgr [--seed S] [--clicks N] [--score|--anytime]\n"
+        "  --level    reproduce contra este nivel en vez del que dice la grabación\n"
+        "  --pack     paquete para las claves \"pack:N\" (assets/levels/levels.etgp)\n"
+        "  --repeat   reproduce cada partida N veces (medición de throughput)\n"
+        "  --score    la partida sintética termina con el auto-solve por puntaje en vez del A*\n"
+        "  --anytime  la partida sintética termina con el ARA* de ESPACIO, adoptando sus mejoras\n"
+        "  --verbose  deja pasar el log del loader y del grid\n",
+        program, program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ReplaySettings settings;
+    std::vector<std::string> recordings;
+    std::string demoLevel, demoOutput;
+    uint64_t demoSeed = 1;
+    int demoClicks = 200;
+    bool demoScore = false;
+    bool demoAnytime = false;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--level" && hasValue) {
+            settings.levelOverride = argv[++i];
+        } else if (argument == "--pack" && hasValue) {
+            settings.packFile = argv[++i];
+        } else if (argument == "--repeat" && hasValue) {
+            settings.repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--demo" && i + 2 < argc) {
+            demoLevel = argv[++i];
+            demoOutput = argv[++i];
+        } else if (argument == "--seed" && hasValue) {
+            demoSeed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--clicks" && hasValue) {
+            demoClicks = std::atoi(argv[++i]);
+        } else if (argument == "--score") {
+            demoScore = true;
+        } else if (argument == "--anytime") {
+            demoAnytime = true;
+        } else if (argument == "--verbose") {
+            verbose = true;
+        } else if (!argument.empty() && argument[0] != '-') {
+            recordings.push_back(argument);
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (demoLevel.empty() && recordings.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // Loader, grid y grabador loguean por std::cout; el reporte va por stdout con printf
+    NullBuffer nullBuffer;
+    std::streambuf* originalCout = std::cout.rdbuf();
+    if (!verbose) std::cout.rdbuf(&nullBuffer);
+
+    int failures = 0;
+    if (!demoLevel.empty()) {
+        if (MakeDemo(demoLevel, demoOutput, demoSeed, demoClicks, demoScore, demoAnytime)) {
+            std::printf("%s: partida sintética grabada\n", demoOutput.c_str());
+        } else {
+            failures++;
+        }
+    }
+    for (const std::string& filename : recordings) {
+        if (!ReplayFile(filename, settings)) failures++;
+    }
+
+    std::cout.rdbuf(originalCout);
+    return failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,279 @@
+// etg_server.cpp, modo servidor headless: miles de sesiones sobre niveles compartidos, movidas por bots y
+// avanzadas en paralelo con SessionManager. Reporta memoria por sesión y movimientos por segundo, y al final
+// rejuega algunas sesiones con Grid + Player + GameRules para comprobar que las reglas son las mismas.
+// Uso: etg-server [--sessions N] [--ticks T] [--threads K] [--bot random|hint|mix] [--seed S] [--verify N] [nivel ...]
+#include "GameRules.h"
+#include "HexDirections.h"
+#include "SessionManager.h"
+#include "TimeToGoalTable.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace {
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+enum class BotKind { RANDOM, HINT, MIX };
+
+struct ServerSettings {
+    int sessions = 10000;
+    int ticks = 200;
+    unsigned threads = 0;
+    BotKind bot = BotKind::MIX;
+    uint64_t seed = 1;
+    int verify = 64;
+    std::vector<std::string> levels;
+};
+
+struct LoadedLevel {
+    std::string file;
+    LevelData data;
+    std::shared_ptr<const SharedLevel> shared;
+};
+
+// Lo que hizo cada sesión; cada contador lo escribe solo el hilo que tiene la sesión en ese Step
+struct SessionTally {
+    int wins = 0;
+    int gameOvers = 0;
+    std::vector<SessionInput> log;      // Solo para las sesiones que se verifican
+};
+
+uint64_t SplitMix64(uint64_t value) {
+    value += 0x9E3779B97F4A7C15ull;
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+// Como el --demo de etg-replay: casi siempre un vecino al azar, a veces cualquier celda. El bot de pista sigue
+// la tabla del nivel salvo uno de cada 8 turnos, para que también se equivoque. Al terminar la partida, R.
+SessionInput ChooseInput(const Session& session, BotKind bot, uint64_t random) {
+    SessionInput input;
+    if (session.state != GameState::PLAYING) {
+        input.type = SessionInputType::RESET;
+        return input;
+    }
+
+    const SharedLevel& level = *session.level;
+    input.type = SessionInputType::MOVE;
+    GridPos hint;
+    if (bot == BotKind::HINT && random % 8 != 0 && level.TimeToGoal().Ready() &&
+        level.TimeToGoal().BestMove(session.x, session.y, session.turn, hint)) {
+        input.x = hint.x;
+        input.y = hint.y;
+        return input;
+    }
+    random >>= 3;
+    if (random % 10 != 0) {
+        const int (*offsets)[2] = HexOffsetsForColumn(session.x);
+        int direction = (int)((random >> 4) % 6);
+        input.x = session.x + offsets[direction][0];
+        input.y = session.y + offsets[direction][1];
+    } else {
+        input.x = (int)((random >> 4) % (uint64_t)level.width);
+        input.y = (int)((random >> 24) % (uint64_t)level.height);
+    }
+    return input;
+}
+
+// Lo mismo que haría Game con esos clicks y reinicios: ApplyClick (con el GAME_OVER de la tabla) y Reset
+bool VerifySession(const Session& session, const LoadedLevel& level, const std::vector<SessionInput>& log, std::string& error) {
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(level.data);
+    Player player(grid.startPos.x, grid.startPos.y, grid.width, grid.height);
+    TimeToGoalTable timeToGoal;
+    timeToGoal.Build(grid);
+    GameState state = GameState::PLAYING;
+
+    for (const SessionInput& input : log) {
+        if (input.type == SessionInputType::RESET) {
+            grid.ResetState();
+            player.Reset(grid.startPos.x, grid.startPos.y);
+            state = GameState::PLAYING;
+        } else if (input.type == SessionInputType::MOVE && state == GameState::PLAYING) {
+            GameRules::ApplyPlayerMove(grid, player, input.x, input.y);
+            grid.Update();
+            if (GameRules::IsWon(grid, player)) {
+                state = GameState::WIN;
+            } else if (timeToGoal.Ready() && !timeToGoal.CanReachGoal(player.x, player.y, grid.currentTurn)) {
+                state = GameState::GAME_OVER;
+            }
+        }
+    }
+
+    char buffer[256];
+    if (player.x != session.x || player.y != session.y || grid.currentTurn != session.turn || player.score != session.score ||
+        (int)player.items.size() != session.itemCount || player.path.Size() - 1 != session.moveCount || state != session.state) {
+        std::snprintf(buffer, sizeof(buffer),
+                      "Grid: (%d, %d) turno %d puntaje %d items %d estado %d; sesión: (%d, %d) turno %d puntaje %d items %d estado %d",
+                      player.x, player.y, grid.currentTurn, player.score, (int)player.items.size(), (int)state,
+                      session.x, session.y, session.turn, session.score, session.itemCount, (int)session.state);
+        error = buffer;
+        return false;
+    }
+    return true;
+}
+
+// Lo que ocuparía la misma partida con un Grid y un Player propios: lo que Grid reporta de celdas y tablas
+// de compuertas, más el Player con el conteo de visitas (sin historial, como recién empezada)
+size_t GridSessionBytes(const LevelData& levelData) {
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+    size_t cells = (size_t)grid.width * grid.height;
+    return sizeof(Grid) + grid.CellBytes() + grid.GateTableBytes() + sizeof(Player) + cells;
+}
+
+void PrintUsage(const char* program) {
+    std::fprintf(stderr,
+        "Uso: %s [opciones] [nivel ...]\n"
+        "  --sessions N   sesiones simultáneas (10000)\n"
+        "  --ticks T      pasos de simulación, un movimiento por sesión en cada uno (200)\n"
+        "  --threads K    hilos del pool (por defecto uno por núcleo)\n"
+        "  --bot B        random, hint o mix (mitad y mitad)\n"
+        "  --seed S       semilla de los bots\n"
+        "  --verify N     rejuega las primeras N sesiones con Grid + GameRules (64)\n"
+        "Sin niveles usa los cuatro de assets/levels; las sesiones se reparten en ronda entre ellos.\n",
+        program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ServerSettings settings;
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--sessions" && hasValue) {
+            settings.sessions = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--ticks" && hasValue) {
+            settings.ticks = std::max(1, std::atoi(argv[++i]));
+        } else if (argument == "--threads" && hasValue) {
+            settings.threads = (unsigned)std::max(0, std::atoi(argv[++i]));
+        } else if (argument == "--bot" && hasValue) {
+            std::string bot = argv[++i];
+            if (bot == "random") settings.bot = BotKind::RANDOM;
+            else if (bot == "hint") settings.bot = BotKind::HINT;
+            else if (bot == "mix") settings.bot = BotKind::MIX;
+            else {
+                PrintUsage(argv[0]);
+                return 1;
+            }
+        } else if (argument == "--seed" && hasValue) {
+            settings.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (argument == "--verify" && hasValue) {
+            settings.verify = std::max(0, std::atoi(argv[++i]));
+        } else if (!argument.empty() && argument[0] != '-') {
+            settings.levels.push_back(argument);
+        } else {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (settings.levels.empty()) {
+        settings.levels = {"assets/levels/level1.txt", "assets/levels/level2.txt", "assets/levels/level_expert.txt",
+                           "assets/levels/level_nightmare.txt"};
+    }
+
+    // El loader y el grid loguean por std::cout; el reporte va por stdout con printf
+    NullBuffer nullBuffer;
+    std::streambuf* originalCout = std::cout.rdbuf();
+    std::cout.rdbuf(&nullBuffer);
+
+    SessionManager manager(settings.threads);
+    std::vector<LoadedLevel> levels;
+    for (const std::string& file : settings.levels) {
+        LoadedLevel level;
+        level.file = file;
+        if (!FileLoader::LoadLevel(file, level.data)) {
+            std::cout.rdbuf(originalCout);
+            std::printf("%s: no se pudo cargar\n", file.c_str());
+            return 1;
+        }
+        level.shared = manager.AddLevel(file, level.data);
+        if (level.shared == nullptr) {
+            std::cout.rdbuf(originalCout);
+            std::printf("%s: nivel inválido\n", file.c_str());
+            return 1;
+        }
+        levels.push_back(std::move(level));
+    }
+
+    auto createStart = std::chrono::steady_clock::now();
+    std::vector<int> levelOf(settings.sessions);
+    for (int i = 0; i < settings.sessions; i++) {
+        levelOf[i] = i % (int)levels.size();
+        manager.CreateSession(levels[levelOf[i]].shared);
+    }
+    double createMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - createStart).count();
+
+    std::vector<SessionTally> tallies(settings.sessions);
+    int verifyCount = std::min(settings.verify, settings.sessions);
+    long long tick = 0;
+    SessionManager::Controller controller = [&](int id, const Session& session) {
+        SessionTally& tally = tallies[id];
+        if (session.state == GameState::WIN) tally.wins++;
+        if (session.state == GameState::GAME_OVER) tally.gameOvers++;
+
+        BotKind bot = settings.bot == BotKind::MIX ? (id % 2 == 0 ? BotKind::RANDOM : BotKind::HINT) : settings.bot;
+        uint64_t random = SplitMix64(settings.seed ^ SplitMix64(((uint64_t)id << 32) ^ (uint64_t)tick));
+        SessionInput input = ChooseInput(session, bot, random);
+        if (id < verifyCount) tally.log.push_back(input);
+        return input;
+    };
+
+    long long accepted = 0;
+    auto stepStart = std::chrono::steady_clock::now();
+    for (tick = 0; tick < settings.ticks; tick++) {
+        accepted += manager.Step(controller);
+    }
+    double stepSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - stepStart).count();
+
+    int failures = 0;
+    std::string error;
+    for (int id = 0; id < verifyCount; id++) {
+        if (!VerifySession(manager.GetSession(id), levels[levelOf[id]], tallies[id].log, error)) {
+            std::cout.rdbuf(originalCout);
+            std::printf("sesión %d (%s) no coincide: %s\n", id, levels[levelOf[id]].file.c_str(), error.c_str());
+            std::cout.rdbuf(&nullBuffer);
+            failures++;
+        }
+    }
+    std::cout.rdbuf(originalCout);
+
+    long long wins = 0, gameOvers = 0;
+    for (const SessionTally& tally : tallies) {
+        wins += tally.wins;
+        gameOvers += tally.gameOvers;
+    }
+    std::cout.rdbuf(&nullBuffer);
+    std::vector<size_t> gridBytesPerLevel;
+    for (const LoadedLevel& level : levels) {
+        gridBytesPerLevel.push_back(GridSessionBytes(level.data));
+    }
+    std::cout.rdbuf(originalCout);
+    size_t gridBytes = 0;
+    for (int i = 0; i < settings.sessions; i++) {
+        gridBytes += gridBytesPerLevel[levelOf[i]];
+    }
+    size_t sessionBytes = manager.SessionBytes();
+    double attempts = (double)settings.sessions * settings.ticks;
+
+    std::printf("%d sesiones sobre %zu niveles, %u hilos, %d ticks (creadas en %.1f ms)\n", settings.sessions,
+                levels.size(), manager.ThreadCount(), settings.ticks, createMillis);
+    std::printf("memoria: %.1f bytes por sesión + %.1f KB de niveles compartidos (con Grid + Player propios ~%.0f bytes por sesión)\n",
+                (double)sessionBytes / settings.sessions, manager.LevelBytes() / 1024.0, (double)gridBytes / settings.sessions);
+    std::printf("%.2f s: %.0f ticks/s, %.2f M entradas/s, %lld movimientos aceptados, %lld victorias, %lld game over\n",
+                stepSeconds, settings.ticks / stepSeconds, attempts / stepSeconds / 1e6, accepted, wins, gameOvers);
+    std::printf("verificadas %d sesiones contra Grid + GameRules: %d diferencias\n", verifyCount, failures);
+    return failures > 0 ? 1 : 0;
+}
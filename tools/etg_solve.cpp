@@ -0,0 +1,394 @@
+// etg_solve.cpp, resuelve catálogos enteros de niveles en paralelo y reporta cada uno en JSON o CSV
+// Uso: etg-solve [opciones] <nivel|carpeta|paquete.etgp> ...
+#include "LevelPack.h"
+#include "LevelTables.h"
+#include "MemoryReport.h"
+#include "PathFinder.h"
+#include "Player.h"
+#include "TimeToGoalTable.h"
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace {
+
+enum class Solver { ASTAR, BFS, ANYTIME };
+
+// Límites pedidos por línea de comandos; -1 deja el del juego
+struct LimitOverrides {
+    int maxIterations = -1, maxTimeMs = -1, maxTurn = -1;
+    long long maxNodes = -1;
+
+    void Apply(SolverLimits& limits) const {
+        if (maxIterations >= 0) limits.maxIterations = maxIterations;
+        if (maxTimeMs >= 0) limits.maxTimeMs = maxTimeMs;
+        if (maxTurn >= 0) limits.maxTurn = maxTurn;
+        if (maxNodes >= 0) limits.maxNodes = (size_t)maxNodes;
+    }
+};
+
+struct SolveJob {
+    std::string source;         // Archivo del nivel o del paquete
+    std::string name;
+    int packIndex;              // -1 si es un archivo suelto
+    const LevelPack* pack;
+};
+
+struct SolveResult {
+    bool loaded = false;
+    int width = 0, height = 0;
+    std::vector<GridPos> path;
+    SolverStats stats;
+    double loadMillis = 0.0;
+    MemoryReport memory;        // Solo con --memory
+};
+
+// Descarta todo lo que se escribe: el loader y el grid loguean por std::cout y la salida es stdout
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+bool IsLevelFile(const std::filesystem::path& path) {
+    std::string extension = path.extension().string();
+    return extension == ".txt" || extension == ".json" || extension == ".etgl";
+}
+
+const char* StopName(SolverStop stop) {
+    switch (stop) {
+        case SolverStop::FOUND: return "found";
+        case SolverStop::EXHAUSTED: return "exhausted";
+        case SolverStop::ITERATION_LIMIT: return "iteration_limit";
+        case SolverStop::TIME_LIMIT: return "time_limit";
+        case SolverStop::NODE_LIMIT: return "node_limit";
+        case SolverStop::INVALID_LEVEL: return "invalid_level";
+        case SolverStop::CANCELLED: return "cancelled";
+    }
+    return "unknown";
+}
+
+std::string JsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if ((unsigned char)c < 0x20) {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", (unsigned char)c);
+            out += buffer;
+        } else {
+            out += c;
+        }
+    }
+    return out;
+}
+
+std::string CsvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) return text;
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    return out + "\"";
+}
+
+// Lo que ocuparía el nivel en el juego: grid, compuertas, el pico del solver, un jugador que recorrió la
+// solución y la tabla de turnos a la meta
+void MeasureMemory(const Grid& grid, const PathFinder& pathFinder, const std::vector<GridPos>& path, MemoryReport& report) {
+    report.Add("grid", sizeof(Grid) + grid.CellBytes());
+    report.Add("tablas de compuertas", grid.GateTableBytes());
+    report.Add("arenas del solver", pathFinder.lastStats.peakBytes);
+
+    Player player(grid.startPos.x, grid.startPos.y, grid.width, grid.height);
+    for (size_t i = 1; i < path.size(); i++) {
+        player.MoveTo(path[i].x, path[i].y);
+        player.AddToPath(path[i].x, path[i].y);
+    }
+    report.Add("historial del jugador", sizeof(Player) + player.MemoryBytes());
+
+    TimeToGoalTable timeToGoal;
+    timeToGoal.Build(grid);
+    report.Add("turnos a la meta", timeToGoal.MemoryBytes());
+}
+
+SolveResult Solve(const SolveJob& job, Solver solver, const LimitOverrides& overrides, bool verbose, bool measureMemory) {
+    SolveResult result;
+    auto startTime = std::chrono::steady_clock::now();
+
+    LevelData levelData;
+    result.loaded = job.pack != nullptr ? job.pack->LoadLevel((size_t)job.packIndex, levelData)
+                                        : FileLoader::LoadLevel(job.source, levelData);
+    if (!result.loaded) {
+        return result;
+    }
+    // Con el campo de distancias la heurística de A* es admisible y el camino sale óptimo
+    LevelTables::AttachGoalDistances(levelData);
+    result.loadMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    result.width = levelData.width;
+    result.height = levelData.height;
+
+    Grid grid(1, 1);
+    grid.LoadFromLevelData(levelData);
+    PathFinder pathFinder(&grid);
+    pathFinder.verbose = verbose;
+    // Los mismos que el juego: el anytime los escala con el nivel
+    SolverLimits limits = solver == Solver::BFS ? SolverLimits::BFSDefaults()
+                        : solver == Solver::ASTAR ? SolverLimits::AStarDefaults()
+                                                  : SolverLimits::AnytimeFor(grid);
+    overrides.Apply(limits);
+    if (solver == Solver::ANYTIME) {
+        result.path = pathFinder.FindPathAnytime(limits, AnytimeSettings());
+    } else {
+        result.path = solver == Solver::ASTAR ? pathFinder.FindPathAStar(limits) : pathFinder.FindPathBFS(limits);
+    }
+    result.stats = pathFinder.lastStats;
+    if (measureMemory) {
+        MeasureMemory(grid, pathFinder, result.path, result.memory);
+    }
+    return result;
+}
+
+void WriteJson(FILE* out, const std::vector<SolveJob>& jobs, const std::vector<SolveResult>& results, bool withPath,
+               bool anytime) {
+    std::fprintf(out, "[\n");
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const SolveResult& r = results[i];
+        bool solvable = r.stats.stop == SolverStop::FOUND;
+        std::fprintf(out, "  {\"level\": \"%s\", \"name\": \"%s\", \"loaded\": %s",
+                     JsonEscape(jobs[i].source).c_str(), JsonEscape(jobs[i].name).c_str(), r.loaded ? "true" : "false");
+        if (r.loaded) {
+            std::fprintf(out, ", \"width\": %d, \"height\": %d, \"solvable\": %s, \"turns\": %d, \"stop\": \"%s\", "
+                         "\"expansions\": %d, \"generated\": %zu, \"load_ms\": %.3f, \"solve_ms\": %.3f, \"peak_bytes\": %zu",
+                         r.width, r.height, solvable ? "true" : "false", solvable ? (int)r.path.size() - 1 : -1,
+                         StopName(r.stats.stop), r.stats.expansions, r.stats.generated, r.loadMillis, r.stats.millis,
+                         r.stats.peakBytes);
+            if (anytime) {
+                std::fprintf(out, ", \"bound\": %.3f, \"solutions\": %d, \"first_ms\": %.3f",
+                             r.stats.bound, r.stats.solutions, r.stats.firstMillis);
+            }
+            if (withPath) {
+                std::fprintf(out, ", \"path\": [");
+                for (size_t p = 0; p < r.path.size(); p++) {
+                    std::fprintf(out, "%s[%d, %d]", p > 0 ? ", " : "", r.path[p].x, r.path[p].y);
+                }
+                std::fprintf(out, "]");
+            }
+        }
+        std::fprintf(out, "}%s\n", i + 1 < jobs.size() ? "," : "");
+    }
+    std::fprintf(out, "]\n");
+}
+
+void WriteCsv(FILE* out, const std::vector<SolveJob>& jobs, const std::vector<SolveResult>& results, bool withPath,
+              bool anytime) {
+    std::fprintf(out, "level,name,loaded,width,height,solvable,turns,stop,expansions,generated,load_ms,solve_ms,peak_bytes%s%s\n",
+                 anytime ? ",bound,solutions,first_ms" : "", withPath ? ",path" : "");
+    for (size_t i = 0; i < jobs.size(); i++) {
+        const SolveResult& r = results[i];
+        bool solvable = r.stats.stop == SolverStop::FOUND;
+        std::fprintf(out, "%s,%s,%d,%d,%d,%d,%d,%s,%d,%zu,%.3f,%.3f,%zu",
+                     CsvField(jobs[i].source).c_str(), CsvField(jobs[i].name).c_str(), r.loaded ? 1 : 0,
+                     r.width, r.height, solvable ? 1 : 0, solvable ? (int)r.path.size() - 1 : -1,
+                     r.loaded ? StopName(r.stats.stop) : "load_error", r.stats.expansions, r.stats.generated,
+                     r.loadMillis, r.stats.millis, r.stats.peakBytes);
+        if (anytime) {
+            std::fprintf(out, ",%.3f,%d,%.3f", r.stats.bound, r.stats.solutions, r.stats.firstMillis);
+        }
+        if (withPath) {
+            // Pasos separados por ';' para no chocar con las comas del CSV
+            std::fprintf(out, ",");
+            for (size_t p = 0; p < r.path.size(); p++) {
+                std::fprintf(out, "%s%d:%d", p > 0 ? ";" : "", r.path[p].x, r.path[p].y);
+            }
+        }
+        std::fprintf(out, "\n");
+    }
+}
+
+double PeakResidentMB() {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss / 1024.0;
+    }
+#endif
+    return 0.0;
+}
+
+void PrintUsage(const char* program) {
+    std::fprintf(stderr,
+        "Uso: %s [opciones] <nivel|carpeta|paquete.etgp> ...\n"
+        "  --solver astar|bfs|dijkstra|anytime\n"
+        "                                algoritmo (por defecto astar; dijkstra es el mismo BFS; anytime o ara es\n"
+        "                                A* con peso que baja hasta el óptimo, y --max-time-ms es su fecha límite)\n"
+        "  --threads N                   hilos del pool (por defecto uno por núcleo)\n"
+        "  --format json|csv             formato de salida (por defecto json)\n"
+        "  --output ARCHIVO              escribe ahí en vez de stdout\n"
+        "  --max-iterations N  --max-time-ms N  --max-turn N  --max-nodes N\n"
+        "                                límites de la búsqueda (por defecto los del juego; los del anytime\n"
+        "                                crecen con la distancia a la meta, ver SolverLimits::AnytimeFor)\n"
+        "  --no-path                     no incluye el camino en la salida\n"
+        "  --verbose                     deja pasar el log del loader y del solver\n"
+        "  --memory                      memoria por subsistema de cada nivel, por stderr\n"
+        "Las carpetas se recorren sin recursión buscando .txt, .json y .etgl;\n"
+        "un .etgp aporta todos sus niveles.\n", program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Solver solver = Solver::ASTAR;
+    unsigned threadCount = 0;
+    bool csv = false;
+    bool withPath = true;
+    bool verbose = false;
+    bool measureMemory = false;
+    std::string outputFile;
+    LimitOverrides overrides;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--solver" && hasValue) {
+            std::string name = argv[++i];
+            if (name == "astar") solver = Solver::ASTAR;
+            else if (name == "bfs" || name == "dijkstra") solver = Solver::BFS;
+            else if (name == "anytime" || name == "ara") solver = Solver::ANYTIME;
+            else { std::fprintf(stderr, "Solver desconocido: %s\n", name.c_str()); return 1; }
+        } else if (argument == "--threads" && hasValue) {
+            threadCount = (unsigned)std::atoi(argv[++i]);
+        } else if (argument == "--format" && hasValue) {
+            std::string format = argv[++i];
+            if (format != "json" && format != "csv") { std::fprintf(stderr, "Formato desconocido: %s\n", format.c_str()); return 1; }
+            csv = format == "csv";
+        } else if (argument == "--output" && hasValue) {
+            outputFile = argv[++i];
+        } else if (argument == "--max-iterations" && hasValue) {
+            overrides.maxIterations = std::atoi(argv[++i]);
+        } else if (argument == "--max-time-ms" && hasValue) {
+            overrides.maxTimeMs = std::atoi(argv[++i]);
+        } else if (argument == "--max-turn" && hasValue) {
+            overrides.maxTurn = std::atoi(argv[++i]);
+        } else if (argument == "--max-nodes" && hasValue) {
+            overrides.maxNodes = std::atoll(argv[++i]);
+        } else if (argument == "--no-path") {
+            withPath = false;
+        } else if (argument == "--verbose") {
+            verbose = true;
+        } else if (argument == "--memory") {
+            measureMemory = true;
+        } else if (argument == "--help" || argument == "-h" || (argument.size() > 1 && argument[0] == '-')) {
+            PrintUsage(argv[0]);
+            return argument == "--help" || argument == "-h" ? 0 : 1;
+        } else {
+            inputs.push_back(argument);
+        }
+    }
+    if (inputs.empty()) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    NullBuffer nullBuffer;
+    std::streambuf* originalCout = std::cout.rdbuf();
+    if (!verbose) {
+        std::cout.rdbuf(&nullBuffer);
+    }
+
+    // Los paquetes tienen que vivir hasta el final: los trabajos leen de su archivo mapeado
+    std::vector<std::unique_ptr<LevelPack>> packs;
+    std::vector<SolveJob> jobs;
+    for (const std::string& input : inputs) {
+        std::error_code error;
+        if (std::filesystem::is_directory(input, error)) {
+            std::vector<std::string> files;
+            for (const auto& entry : std::filesystem::directory_iterator(input, error)) {
+                if (entry.is_regular_file() && IsLevelFile(entry.path())) {
+                    files.push_back(entry.path().string());
+                }
+            }
+            std::sort(files.begin(), files.end());
+            for (const std::string& file : files) {
+                jobs.push_back({file, std::filesystem::path(file).stem().string(), -1, nullptr});
+            }
+        } else if (std::filesystem::path(input).extension() == ".etgp") {
+            auto pack = std::make_unique<LevelPack>();
+            if (!pack->Open(input)) {
+                std::fprintf(stderr, "No se pudo abrir el paquete: %s\n", input.c_str());
+                return 1;
+            }
+            for (size_t i = 0; i < pack->LevelCount(); i++) {
+                jobs.push_back({input, std::string(pack->Name(i)), (int)i, pack.get()});
+            }
+            packs.push_back(std::move(pack));
+        } else {
+            jobs.push_back({input, std::filesystem::path(input).stem().string(), -1, nullptr});
+        }
+    }
+
+    std::vector<SolveResult> results(jobs.size());
+    auto startTime = std::chrono::steady_clock::now();
+    unsigned usedThreads;
+    {
+        WorkStealingPool pool(threadCount);
+        usedThreads = pool.ThreadCount();
+        for (size_t i = 0; i < jobs.size(); i++) {
+            pool.Submit([&, i]() { results[i] = Solve(jobs[i], solver, overrides, verbose, measureMemory); });
+        }
+        pool.Wait();
+    }
+    double wallMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout.rdbuf(originalCout);
+
+    FILE* out = stdout;
+    if (!outputFile.empty()) {
+        out = std::fopen(outputFile.c_str(), "w");
+        if (out == nullptr) {
+            std::fprintf(stderr, "No se pudo crear el archivo: %s\n", outputFile.c_str());
+            return 1;
+        }
+    }
+    if (csv) {
+        WriteCsv(out, jobs, results, withPath, solver == Solver::ANYTIME);
+    } else {
+        WriteJson(out, jobs, results, withPath, solver == Solver::ANYTIME);
+    }
+    if (out != stdout) {
+        std::fclose(out);
+    }
+
+    if (measureMemory) {
+        for (size_t i = 0; i < jobs.size(); i++) {
+            if (!results[i].loaded) continue;
+            std::cerr << jobs[i].name << " (" << results[i].width << "x" << results[i].height << "):\n";
+            results[i].memory.Print(std::cerr);
+        }
+    }
+
+    size_t solved = 0, failedLoads = 0;
+    double solveMillis = 0.0;
+    for (const SolveResult& r : results) {
+        if (!r.loaded) failedLoads++;
+        if (r.stats.stop == SolverStop::FOUND) solved++;
+        solveMillis += r.loadMillis + r.stats.millis;
+    }
+    std::fprintf(stderr, "%zu niveles, %zu resueltos, %zu sin cargar | %u hilos, %.1f ms de pared, %.1f ms sumados | pico RSS %.1f MB\n",
+                 jobs.size(), solved, failedLoads, usedThreads, wallMillis, solveMillis, PeakResidentMB());
+    return failedLoads > 0 ? 1 : 0;
+}
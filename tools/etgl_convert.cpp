@@ -0,0 +1,71 @@
+// etgl_convert.cpp, compila un nivel .txt al formato binario .etgl
+// Uso: etgl_convert <entrada.txt> [salida.etgl] [--no-distance]
+//      etgl_convert --verify <nivel.etgl> ...   (checksum completo; el juego carga sin él)
+#include "FileLoader.h"
+#include "LevelBinary.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+int main(int argc, char** argv) {
+    std::string input, output;
+    bool includeDistance = true;
+    
+    if (argc > 2 && std::strcmp(argv[1], "--verify") == 0) {
+        int failures = 0;
+        for (int i = 2; i < argc; i++) {
+            LevelBinary binary;
+            bool ok = binary.Open(argv[i], true);
+            std::printf("%s: %s\n", argv[i], ok ? "OK" : "inválido");
+            if (!ok) failures++;
+        }
+        return failures > 0 ? 1 : 0;
+    }
+    
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--no-distance") == 0) {
+            includeDistance = false;
+        } else if (input.empty()) {
+            input = argv[i];
+        } else {
+            output = argv[i];
+        }
+    }
+    
+    if (input.empty()) {
+        std::printf("Uso: %s <entrada.txt> [salida.etgl] [--no-distance]\n"
+                    "     %s --verify <nivel.etgl> ...\n", argv[0], argv[0]);
+        return 1;
+    }
+    if (output.empty()) {
+        size_t dot = input.find_last_of('.');
+        output = (dot == std::string::npos ? input : input.substr(0, dot)) + ".etgl";
+    }
+    
+    LevelData levelData;
+    if (!FileLoader::LoadLevel(input, levelData)) {
+        return 1;
+    }
+    
+    if (!LevelBinary::Write(levelData, output, includeDistance)) {
+        return 1;
+    }
+    
+    // Verificar el resultado y medir la apertura sin checksum (solo mapeo + encabezado)
+    auto startTime = std::chrono::steady_clock::now();
+    LevelBinary binary;
+    bool opened = binary.Open(output, false);
+    auto endTime = std::chrono::steady_clock::now();
+    
+    if (!opened || !binary.Open(output, true)) {
+        std::printf("ERROR: el archivo generado no pasa la validación\n");
+        return 1;
+    }
+    
+    std::printf("%s -> %s (%llu bytes%s), apertura: %.3f ms\n", input.c_str(), output.c_str(),
+                (unsigned long long)binary.Header().fileSize, includeDistance ? ", con distancias" : "",
+                std::chrono::duration<double, std::milli>(endTime - startTime).count());
+    return 0;
+}
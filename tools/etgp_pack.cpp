@@ -0,0 +1,93 @@
+// etgp_pack.cpp, arma un paquete .etgp a partir de niveles .txt / .json, o lista el índice de uno existente
+// Uso: etgp_pack <salida.etgp> <nivel[=Nombre]> [nivel[=Nombre] ...]
+//      etgp_pack --list <paquete.etgp>
+#include "LevelPack.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Nombre por defecto: el archivo sin carpeta ni extensión
+static std::string DefaultName(const std::string& path) {
+    size_t slash = path.find_last_of("/\\");
+    std::string name = slash == std::string::npos ? path : path.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    return dot == std::string::npos ? name : name.substr(0, dot);
+}
+
+static int ListPack(const std::string& filename) {
+    auto startTime = std::chrono::steady_clock::now();
+    LevelPack pack;
+    bool opened = pack.Open(filename);
+    auto endTime = std::chrono::steady_clock::now();
+    if (!opened) {
+        return 1;
+    }
+
+    for (size_t i = 0; i < pack.LevelCount(); i++) {
+        const EtgpEntry& entry = pack.Entry(i);
+        std::string name(pack.Name(i));
+        std::printf("%3zu  %-24s %4dx%-4d %-4s %8llu bytes  items %3u  compuertas %4u  temporales %4u  ",
+                    i, name.c_str(), entry.width, entry.height, entry.format == ETGP_FORMAT_JSON ? "json" : "txt",
+                    (unsigned long long)entry.size, entry.itemCount, entry.gateCount, entry.temporalCount);
+        if (entry.optimalMoves == ETGP_NO_SOLUTION) {
+            std::printf("sin solución\n");
+        } else {
+            std::printf("óptimo %d\n", entry.optimalMoves);
+        }
+    }
+
+    std::printf("Apertura del índice: %.3f ms\n", std::chrono::duration<double, std::milli>(endTime - startTime).count());
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc == 3 && std::strcmp(argv[1], "--list") == 0) {
+        return ListPack(argv[2]);
+    }
+
+    if (argc < 3) {
+        std::printf("Uso: %s <salida.etgp> <nivel[=Nombre]> [nivel[=Nombre] ...]\n", argv[0]);
+        std::printf("     %s --list <paquete.etgp>\n", argv[0]);
+        return 1;
+    }
+
+    std::string output = argv[1];
+    std::vector<LevelPackSource> sources;
+    for (int i = 2; i < argc; i++) {
+        std::string argument = argv[i];
+        size_t equals = argument.find('=');
+        if (equals == std::string::npos) {
+            sources.push_back({argument, DefaultName(argument)});
+        } else {
+            sources.push_back({argument.substr(0, equals), argument.substr(equals + 1)});
+        }
+    }
+
+    // El log de cada nivel va entre los metadatos; se deja visible para ver errores de parseo
+    std::cout << "Empaquetando " << sources.size() << " niveles en " << output << std::endl;
+    if (!LevelPack::Write(sources, output)) {
+        return 1;
+    }
+
+    LevelPack pack;
+    if (!pack.Open(output)) {
+        std::printf("ERROR: el paquete generado no pasa la validación\n");
+        return 1;
+    }
+    for (size_t i = 0; i < pack.LevelCount(); i++) {
+        LevelData levelData;
+        std::streambuf* original = std::cout.rdbuf(nullptr);
+        bool ok = pack.LoadLevel(i, levelData);
+        std::cout.rdbuf(original);
+        if (!ok) {
+            std::printf("ERROR: el nivel %zu del paquete no se puede decodificar\n", i);
+            return 1;
+        }
+    }
+
+    std::printf("%s: %zu niveles\n", output.c_str(), pack.LevelCount());
+    return 0;
+}